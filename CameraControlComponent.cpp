@@ -14,7 +14,13 @@
 #include "DrawDebugHelpers.h"
 #include "HAL/IConsoleManager.h"
 #include "UObject/UObjectIterator.h"
+#include "UObject/Package.h"
+#include "Misc/AutomationTest.h"
 #include "TargetDetectionComponent.h" // 新增：需要调用 IsTargetStillLockable
+#include "UIManagerComponent.h"
+#include "LockOnConfigComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "PerformanceProfiler.h"
 
 // 控制台命令定义
 static TAutoConsoleVariable<int32> CVarCameraDebugLevel(
@@ -206,6 +212,8 @@ void UCameraControlComponent::TickComponent(float DeltaTime, ELevelTick TickType
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	SOUL_PERFORMANCE_SCOPE(TEXT("CameraControl.Tick"));
+
 	// 应用控制台变量
 	if (CVarCameraInterpSpeed.GetValueOnGameThread() != CameraSettings.CameraInterpSpeed)
 	{
@@ -305,6 +313,7 @@ void UCameraControlComponent::TickComponent(float DeltaTime, ELevelTick TickType
 			if (OwnerCharacter)
 			{
 				// 获取TargetDetectionComponent
+				SOUL_COUNTER_INC(TEXT("CameraControl.ComponentLookups"));
 				UActorComponent* DetectionComp = OwnerCharacter->GetComponentByClass(UTargetDetectionComponent::StaticClass());
 				if (UTargetDetectionComponent* TargetDetection = Cast<UTargetDetectionComponent>(DetectionComp))
 				{
@@ -326,6 +335,36 @@ void UCameraControlComponent::TickComponent(float DeltaTime, ELevelTick TickType
 		}
 	}
 
+	// ==================== 相机模拟 ====================
+	if (bUseFixedStepSimulation)
+	{
+		TickFixedStepSimulation(DeltaTime);
+	}
+	else
+	{
+		bHasFixedStepState = false;
+		SimulateCameraStep();
+	}
+
+	// 每帧调试信息输出
+	if (bEnableCameraDebugLogs && CurrentLockOnTarget)
+	{
+		static float LastDebugTime = 0.0f;
+		float CurrentTime = GetWorld()->GetTimeSeconds();
+		if (CurrentTime - LastDebugTime > DebugInfoInterval) // 使用配置的调试输出间隔
+		{
+			LastDebugTime = CurrentTime;
+		}
+	}
+}
+
+// ==================== 固定步长模拟 ====================
+
+void UCameraControlComponent::SimulateCameraStep()
+{
+	// 弹簧按模拟步判断是否连续；固定步长下某些帧没有子步，不能用帧号
+	++CameraSimStep;
+
 	// ==================== 新增：优先处理Spring Arm长度插值 ====================
 	if (bIsInterpolatingArmLength)
 	{
@@ -371,17 +410,173 @@ void UCameraControlComponent::TickComponent(float DeltaTime, ELevelTick TickType
 			UpdateAdvancedCameraAdjustment();
 		}
 	}
+}
 
-	// 每帧调试信息输出
-	if (bEnableCameraDebugLogs && CurrentLockOnTarget)
+void UCameraControlComponent::TickFixedStepSimulation(float DeltaTime)
+{
+	FixedStepClock.StepRate = FixedStepRate;
+	FixedStepClock.MaxSubSteps = MaxFixedSubSteps;
+
+	if (!bHasFixedStepState)
 	{
-		static float LastDebugTime = 0.0f;
-		float CurrentTime = GetWorld()->GetTimeSeconds();
-		if (CurrentTime - LastDebugTime > DebugInfoInterval) // 使用配置的调试输出间隔
+		CaptureCameraSimState(CurrentSimState);
+		PreviousSimState = CurrentSimState;
+		PresentedSimState = CurrentSimState;
+		FixedStepClock.Reset();
+		bHasFixedStepState = true;
+	}
+
+	// 上一帧呈现之后由外部写入的变化（玩家视角输入、移动朝向等）同时叠加到两步结果上，不参与插值
+	FCameraSimState ExternalState;
+	CaptureCameraSimState(ExternalState);
+
+	const FRotator ControlDelta = (ExternalState.ControlRotation - PresentedSimState.ControlRotation).GetNormalized();
+	const FRotator ActorDelta = (ExternalState.ActorRotation - PresentedSimState.ActorRotation).GetNormalized();
+	const float ArmLengthDelta = ExternalState.ArmLength - PresentedSimState.ArmLength;
+	const FVector SocketOffsetDelta = ExternalState.SocketOffset - PresentedSimState.SocketOffset;
+
+	for (FCameraSimState* State : { &PreviousSimState, &CurrentSimState })
+	{
+		State->ControlRotation = (State->ControlRotation + ControlDelta).GetNormalized();
+		State->ActorRotation = (State->ActorRotation + ActorDelta).GetNormalized();
+		State->ArmLength += ArmLengthDelta;
+		State->SocketOffset += SocketOffsetDelta;
+	}
+
+	const int32 NumSteps = FixedStepClock.Advance(DeltaTime);
+	if (NumSteps > 0)
+	{
+		// 子步从上一步的模拟结果继续积分，而不是从插值后的呈现值
+		ApplyCameraSimState(CurrentSimState);
+
+		bInFixedStep = true;
+		for (int32 Step = 0; Step < NumSteps; ++Step)
 		{
-			LastDebugTime = CurrentTime;
+			PreviousSimState = CurrentSimState;
+			SimulateCameraStep();
+			CaptureCameraSimState(CurrentSimState);
 		}
+		bInFixedStep = false;
+	}
+
+	SOUL_COUNTER_ADD(TEXT("CameraControl.FixedSubSteps"), NumSteps);
+
+	// 呈现：在上一步和当前步之间按剩余时间插值
+	const float Alpha = FixedStepClock.GetAlpha();
+	PresentedSimState.ControlRotation = FMath::Lerp(PreviousSimState.ControlRotation, CurrentSimState.ControlRotation, Alpha);
+	PresentedSimState.ActorRotation = FMath::Lerp(PreviousSimState.ActorRotation, CurrentSimState.ActorRotation, Alpha);
+	PresentedSimState.ArmLength = FMath::Lerp(PreviousSimState.ArmLength, CurrentSimState.ArmLength, Alpha);
+	PresentedSimState.SocketOffset = FMath::Lerp(PreviousSimState.SocketOffset, CurrentSimState.SocketOffset, Alpha);
+
+	ApplyCameraSimState(PresentedSimState);
+
+	// 写回后重新采样，去掉组件自身的归一化误差，避免下一帧误判为外部变化
+	CaptureCameraSimState(PresentedSimState);
+}
+
+float UCameraControlComponent::GetCameraDeltaTime() const
+{
+	if (bInFixedStep)
+	{
+		return FixedStepClock.GetStepDeltaTime();
+	}
+
+	const UWorld* World = GetWorld();
+	return World ? World->GetDeltaSeconds() : 0.016f;
+}
+
+void UCameraControlComponent::CaptureCameraSimState(FCameraSimState& OutState) const
+{
+	if (APlayerController* PlayerController = GetOwnerController())
+	{
+		OutState.ControlRotation = PlayerController->GetControlRotation();
+	}
+
+	if (ACharacter* OwnerCharacter = GetOwnerCharacter())
+	{
+		OutState.ActorRotation = OwnerCharacter->GetActorRotation();
 	}
+
+	if (USpringArmComponent* SpringArm = GetSpringArmComponent())
+	{
+		OutState.ArmLength = SpringArm->TargetArmLength;
+		OutState.SocketOffset = SpringArm->SocketOffset;
+	}
+}
+
+void UCameraControlComponent::ApplyCameraSimState(const FCameraSimState& State)
+{
+	if (APlayerController* PlayerController = GetOwnerController())
+	{
+		PlayerController->SetControlRotation(State.ControlRotation);
+	}
+
+	// 角色朝向只在确实变化时写回，避免每帧触发移动组件的旋转更新
+	ACharacter* OwnerCharacter = GetOwnerCharacter();
+	if (OwnerCharacter && !OwnerCharacter->GetActorRotation().Equals(State.ActorRotation, KINDA_SMALL_NUMBER))
+	{
+		OwnerCharacter->SetActorRotation(State.ActorRotation);
+	}
+
+	if (USpringArmComponent* SpringArm = GetSpringArmComponent())
+	{
+		SpringArm->TargetArmLength = State.ArmLength;
+		SpringArm->SocketOffset = State.SocketOffset;
+	}
+}
+
+// ==================== 弹簧平滑 ====================
+
+FRotator UCameraControlComponent::SmoothControlRotation(const FRotator& Current, const FRotator& Target, float InterpSpeed, float SpringSmoothTime)
+{
+	const float DeltaTime = GetCameraDeltaTime();
+	if (!bUseSpringSmoothing)
+	{
+		return FMath::RInterpTo(Current, Target, DeltaTime, InterpSpeed);
+	}
+
+	// 锁定、切换、重置共用一份速度，路径切换时不会出现速度突变
+	if (CameraSimStep > ControlRotationSpringStep + 1)
+	{
+		ControlRotationSpring.Reset();
+	}
+	ControlRotationSpringStep = CameraSimStep;
+
+	return ControlRotationSpring.Update(Current, Target, SpringSmoothTime, DeltaTime);
+}
+
+float UCameraControlComponent::SmoothArmLength(float Current, float Target, float InterpSpeed)
+{
+	const float DeltaTime = GetCameraDeltaTime();
+	if (!bUseSpringSmoothing)
+	{
+		return FMath::FInterpTo(Current, Target, DeltaTime, InterpSpeed);
+	}
+
+	if (CameraSimStep > ArmLengthSpringStep + 1)
+	{
+		ArmLengthSpring.Reset();
+	}
+	ArmLengthSpringStep = CameraSimStep;
+
+	return ArmLengthSpring.Update(Current, Target, ArmLengthSpringSmoothTime, DeltaTime);
+}
+
+FVector UCameraControlComponent::SmoothSocketOffset(const FVector& Current, const FVector& Target, float InterpSpeed)
+{
+	const float DeltaTime = GetCameraDeltaTime();
+	if (!bUseSpringSmoothing)
+	{
+		return FMath::VInterpTo(Current, Target, DeltaTime, InterpSpeed);
+	}
+
+	if (CameraSimStep > SocketOffsetSpringStep + 1)
+	{
+		SocketOffsetSpring.Reset();
+	}
+	SocketOffsetSpringStep = CameraSimStep;
+
+	return SocketOffsetSpring.Update(Current, Target, ArmLengthSpringSmoothTime, DeltaTime);
 }
 
 // ==================== 接口函数实现 ====================
@@ -568,8 +763,7 @@ void UCameraControlComponent::UpdateLockOnCamera()
 		FVector DynamicOffset = GetHeightOffsetForEnemySize(SizeCategory);
 		// 平滑插值到目标偏移
 		FVector CurrentOffset = SpringArm->SocketOffset;
-		float DeltaTime = GetWorld()->GetDeltaSeconds();
-		FVector NewOffset = FMath::VInterpTo(CurrentOffset, DynamicOffset, DeltaTime, SocketOffsetInterpSpeed);
+		FVector NewOffset = SmoothSocketOffset(CurrentOffset, DynamicOffset, SocketOffsetInterpSpeed);
 		SpringArm->SocketOffset = NewOffset;
 	}
 
@@ -626,7 +820,7 @@ void UCameraControlComponent::UpdateLockOnCamera()
 	{
 		FVector NewTargetLocation = GetOptimalLockOnPosition(CurrentLockOnTarget);
 		// 使用平滑插值更新缓存，避免突变
-		float DeltaTime = GetWorld()->GetDeltaSeconds();
+		float DeltaTime = GetCameraDeltaTime();
 		CachedTargetLocation = FMath::VInterpTo(CachedTargetLocation, NewTargetLocation, 
 			DeltaTime, CachedLocationInterpSpeed);
 		LastUpdateTime = CurrentTime;
@@ -642,7 +836,7 @@ void UCameraControlComponent::UpdateLockOnCamera()
 	FRotator LookAtRotation = UKismetMathLibrary::FindLookAtRotation(PlayerLocation, TargetLocation);
 
 	// 获取DeltaTime用于插值计算
-	float DeltaTime = GetWorld()->GetDeltaSeconds();
+	float DeltaTime = GetCameraDeltaTime();
 
 	// 应用FreeLook偏移
 	if (FreeLookSettings.bEnableFreeLook && bIsFreeLooking)
@@ -675,20 +869,21 @@ void UCameraControlComponent::UpdateLockOnCamera()
 	{
 		float SpeedMultiplier = GetCameraSpeedMultiplierForDistance(TargetDistance);
 		float AdjustedInterpSpeed = CameraSettings.CameraInterpSpeed * SpeedMultiplier;
+		float AdjustedSmoothTime = LockOnSpringSmoothTime / FMath::Max(SpeedMultiplier, KINDA_SMALL_NUMBER);
 
 		switch (CameraSettings.CameraTrackingMode)
 		{
 		case 0: // 完全跟踪
-			NewRotation = FMath::RInterpTo(CurrentRotation, LookAtRotation, DeltaTime, AdjustedInterpSpeed);
+			NewRotation = SmoothControlRotation(CurrentRotation, LookAtRotation, AdjustedInterpSpeed, AdjustedSmoothTime);
 			break;
 		case 1: // 仅水平跟踪
 			{
 				FRotator HorizontalLookAt = FRotator(CurrentRotation.Pitch, LookAtRotation.Yaw, CurrentRotation.Roll);
-				NewRotation = FMath::RInterpTo(CurrentRotation, HorizontalLookAt, DeltaTime, AdjustedInterpSpeed);
+				NewRotation = SmoothControlRotation(CurrentRotation, HorizontalLookAt, AdjustedInterpSpeed, AdjustedSmoothTime);
 			}
 			break;
 		default:
-			NewRotation = FMath::RInterpTo(CurrentRotation, LookAtRotation, DeltaTime, AdjustedInterpSpeed);
+			NewRotation = SmoothControlRotation(CurrentRotation, LookAtRotation, AdjustedInterpSpeed, AdjustedSmoothTime);
 			break;
 		}
 	}
@@ -807,13 +1002,12 @@ void UCameraControlComponent::UpdateSmoothTargetSwitch()
 	FVector TargetLocation = GetOptimalLockOnPosition(CurrentLockOnTarget);
 	FRotator TargetRotation = UKismetMathLibrary::FindLookAtRotation(PlayerLocation, TargetLocation);
 	
-	// ✅ 使用 RInterpTo 进行平滑插值
-	float DeltaTime = GetWorld()->GetDeltaSeconds();
+	// ✅ 使用 RInterpTo（或弹簧）进行平滑插值
 	FRotator CurrentRotation = PlayerController->GetControlRotation();
 	
 	// 使用更高的插值速度进行切换
 	float SwitchSpeed = CameraSettings.CameraInterpSpeed * 2.0f;  // 切换时速度加倍
-	FRotator NewRotation = FMath::RInterpTo(CurrentRotation, TargetRotation, DeltaTime, SwitchSpeed);
+	FRotator NewRotation = SmoothControlRotation(CurrentRotation, TargetRotation, SwitchSpeed, LockOnSpringSmoothTime * 0.5f);
 	
 	PlayerController->SetControlRotation(NewRotation);
 	
@@ -1086,11 +1280,10 @@ void UCameraControlComponent::UpdateSpringArmLengthInterpolation()
 		return;
 	}
 	
-	float DeltaTime = GetWorld()->GetDeltaSeconds();
 	float CurrentLength = SpringArm->TargetArmLength;
 	
-	// 使用FInterpTo进行平滑插值
-	float NewLength = FMath::FInterpTo(CurrentLength, ArmLengthInterpTarget, DeltaTime, ArmLengthInterpSpeed);
+	// 使用FInterpTo（或弹簧）进行平滑插值
+	float NewLength = SmoothArmLength(CurrentLength, ArmLengthInterpTarget, ArmLengthInterpSpeed);
 	SpringArm->TargetArmLength = NewLength;
 	
 	// 检查是否完成插值
@@ -1119,11 +1312,10 @@ void UCameraControlComponent::UpdateSocketOffsetReset()
 		return;
 	}
 	
-	float DeltaTime = GetWorld()->GetDeltaSeconds();
 	FVector CurrentOffset = SpringArm->SocketOffset;
 	
-	// 使用 VInterpTo 进行平滑插值
-	FVector NewOffset = FMath::VInterpTo(CurrentOffset, SocketOffsetResetTarget, DeltaTime, SocketOffsetResetSpeed);
+	// 使用 VInterpTo（或弹簧）进行平滑插值
+	FVector NewOffset = SmoothSocketOffset(CurrentOffset, SocketOffsetResetTarget, SocketOffsetResetSpeed);
 	SpringArm->SocketOffset = NewOffset;
 	
 	// 检查是否完成插值
@@ -1153,7 +1345,7 @@ void UCameraControlComponent::UpdateCharacterRotationToTarget()
 	FVector TargetLocation = GetOptimalLockOnPosition(CurrentLockOnTarget);
 	
 	FRotator LookAtRotation = UKismetMathLibrary::FindLookAtRotation(PlayerLocation, TargetLocation);
-	float DeltaTime = GetWorld()->GetDeltaSeconds();
+	float DeltaTime = GetCameraDeltaTime();
 	
 	FRotator CharacterRotation = FMath::RInterpTo(OwnerCharacter->GetActorRotation(), 
 		FRotator(0, LookAtRotation.Yaw, 0), DeltaTime, CHARACTER_ROTATION_SPEED);
@@ -1213,7 +1405,6 @@ void UCameraControlComponent::UpdateSmoothCameraReset()
 	if (!PlayerController)
 		return;
 	
-	float DeltaTime = GetWorld()->GetDeltaSeconds();
 	FRotator CurrentRotation = PlayerController->GetControlRotation();
 	
 	// 根据重置类型选择速度
@@ -1221,8 +1412,8 @@ void UCameraControlComponent::UpdateSmoothCameraReset()
 					   UnlockResetSpeed : NormalResetSpeed;
 	
 	// 使用动态速度进行插值
-	FRotator NewRotation = FMath::RInterpTo(CurrentRotation, SmoothResetTargetRotation, 
-		DeltaTime, ResetSpeed);
+	FRotator NewRotation = SmoothControlRotation(CurrentRotation, SmoothResetTargetRotation, 
+		ResetSpeed, ResetSpringSmoothTime);
 	
 	PlayerController->SetControlRotation(NewRotation);
 	
@@ -1317,7 +1508,7 @@ void UCameraControlComponent::UpdateCameraAutoCorrection()
 	if (!PlayerController)
 		return;
 	
-	float DeltaTime = GetWorld()->GetDeltaSeconds();
+	float DeltaTime = GetCameraDeltaTime();
 	FRotator CurrentRotation = PlayerController->GetControlRotation();
 	FRotator NewRotation = FMath::RInterpTo(CurrentRotation, CameraCorrectionTargetRotation, 
 		DeltaTime, CAMERA_AUTO_CORRECTION_SPEED);
@@ -1470,8 +1661,26 @@ FVector UCameraControlComponent::GetOptimalLockOnPosition(AActor* Target) const
 		return Target->GetActorLocation();
 	}
 	
-	// 三层锁定系统
+	// 多部位锁定：与锁定UI共用同一份已解析的部位变换，部位切换时相机与UI指向同一点
+	if (!bUIManagerLookedUp && GetOwner())
+	{
+		SOUL_COUNTER_INC(TEXT("CameraControl.ComponentLookups"));
+		CachedUIManager = GetOwner()->FindComponentByClass<UUIManagerComponent>();
+		bUIManagerLookedUp = true;
+	}
+	
+	if (UUIManagerComponent* UIManager = CachedUIManager.Get())
+	{
+		FTransform PartTransform;
+		if (UIManager->GetActiveTargetPartTransform(Target, PartTransform))
+		{
+			return PartTransform.GetLocation();
+		}
+	}
+	
+	// 三层锁定系统（未选择部位时的回退）
 	// 第一优先级：检查LockOnSocketComponent
+	SOUL_COUNTER_INC(TEXT("CameraControl.ComponentLookups"));
 	USceneComponent* LockOnSocket = Cast<USceneComponent>(
 		Target->GetDefaultSubobjectByName(TEXT("LockOnSocketComponent"))
 	);
@@ -1574,7 +1783,7 @@ FVector UCameraControlComponent::GetStableTargetLocation(AActor* Target)
 	}
 	
 	// 使用插值更新缓存位置
-	UpdateCachedTargetLocation(Target, GetWorld()->GetDeltaSeconds());
+	UpdateCachedTargetLocation(Target, GetCameraDeltaTime());
 	
 	return CachedTargetLocation;
 }
@@ -1588,6 +1797,7 @@ USpringArmComponent* UCameraControlComponent::GetSpringArmComponentSafe() const
 		return nullptr;
 	
 	// 尝试从Owner查找SpringArm组件
+	SOUL_COUNTER_INC(TEXT("CameraControl.ComponentLookups"));
 	USpringArmComponent* SpringArm = Owner->FindComponentByClass<USpringArmComponent>();
 	if (SpringArm)
 		return SpringArm;
@@ -1609,6 +1819,7 @@ UCameraComponent* UCameraControlComponent::GetCameraComponentSafe() const
 		return nullptr;
 	
 	// 尝试从Owner查找Camera组件
+	SOUL_COUNTER_INC(TEXT("CameraControl.ComponentLookups"));
 	UCameraComponent* Camera = Owner->FindComponentByClass<UCameraComponent>();
 	if (Camera)
 		return Camera;
@@ -1740,7 +1951,7 @@ void UCameraControlComponent::PerformCameraInterpolation(const FRotator& TargetR
 		return;
 	
 	FRotator CurrentRotation = PlayerController->GetControlRotation();
-	float DeltaTime = GetWorld()->GetDeltaSeconds();
+	float DeltaTime = GetCameraDeltaTime();
 	FRotator NewRotation = FMath::RInterpTo(CurrentRotation, TargetRotation, DeltaTime, InterpSpeed);
 	PlayerController->SetControlRotation(NewRotation);
 }
@@ -1752,7 +1963,7 @@ void UCameraControlComponent::PerformCharacterRotationInterpolation(const FRotat
 		return;
 	
 	FRotator CurrentRotation = OwnerCharacter->GetActorRotation();
-	float DeltaTime = GetWorld()->GetDeltaSeconds();
+	float DeltaTime = GetCameraDeltaTime();
 	FRotator NewRotation = FMath::RInterpTo(CurrentRotation, TargetRotation, DeltaTime, InterpSpeed);
 	OwnerCharacter->SetActorRotation(NewRotation);
 }
@@ -1888,6 +2099,7 @@ float UCameraControlComponent::GetActorBoundingHeight(AActor* Actor) const
 	float Height = 200.0f; // 默认高度
 	
 	// 第一优先级：Capsule Component（最稳定）
+	SOUL_COUNTER_INC(TEXT("CameraControl.ComponentLookups"));
 	if (UCapsuleComponent* TargetCapsule = Actor->FindComponentByClass<UCapsuleComponent>())
 	{
 		Height = TargetCapsule->GetScaledCapsuleHalfHeight() * 2.0f;
@@ -1951,11 +2163,7 @@ void UCameraControlComponent::AdjustSpringArmForSizeDistance(EEnemySizeCategory
 		TargetSizeDistanceRatio = 1.0f;
 	}
 
-	float DeltaTime = 0.016f;
-	if (GetWorld())
-	{
-		DeltaTime = GetWorld()->GetDeltaSeconds();
-	}
+	float DeltaTime = GetCameraDeltaTime();
 
 	float SizeDistanceRatio = FMath::FInterpTo(PrevSizeDistanceRatio, TargetSizeDistanceRatio, DeltaTime, 5.0f);
 	PrevSizeDistanceRatio = SizeDistanceRatio;
@@ -2034,6 +2242,7 @@ EEnemySizeCategory UCameraControlComponent::GetTargetSizeCategoryV2(AActor* Targ
 	float Height = 200.0f; // 默认高度
 	
 	// 第一优先级：Capsule Component（最稳定）
+	SOUL_COUNTER_INC(TEXT("CameraControl.ComponentLookups"));
 	if (UCapsuleComponent* TargetCapsule = Target->FindComponentByClass<UCapsuleComponent>())
 	{
 		Height = TargetCapsule->GetScaledCapsuleHalfHeight() * 2.0f;
@@ -2087,4 +2296,366 @@ float UCameraControlComponent::GetCameraSpeedMultiplierForDistance(float Distanc
 		return MidFarDistanceSpeedMultiplier;
 	else
 		return 1.0f;
-}
\ No newline at end of file
+}
+
+// ==================== 自动化测试 ====================
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * 用真实的组件驱动固定步长模拟：弹簧臂从 300 插值到 600、锁定跟踪的控制器旋转收敛，
+ * 不同帧率（含卡顿）下逐帧呈现的结果与 1000fps 参考轨迹比较
+ */
+struct FCameraFixedStepTestAccess
+{
+	static constexpr float REFERENCE_FRAME_RATE = 1000.0f;
+	static constexpr float START_ARM_LENGTH = 300.0f;
+	static constexpr float TARGET_ARM_LENGTH = 600.0f;
+
+	/** 均匀帧间隔；HitchInterval > 0 时每隔若干帧插入一次 50ms 卡顿 */
+	static void BuildFrameDeltas(float FrameRate, float Duration, int32 HitchInterval, TArray<float>& OutDeltas)
+	{
+		OutDeltas.Reset();
+		double Time = 0.0;
+		while (Time < Duration)
+		{
+			const bool bHitch = HitchInterval > 0 && OutDeltas.Num() % HitchInterval == HitchInterval - 1;
+			const float FrameDelta = bHitch ? 0.05f : 1.0f / FrameRate;
+			OutDeltas.Add(FrameDelta);
+			Time += FrameDelta;
+		}
+	}
+
+	/** 按帧间隔序列推进组件，记录每帧结束时的时间与呈现臂长 */
+	static void Run(const TArray<float>& FrameDeltas, bool bSpringSmoothing, TArray<float>& OutTimes, TArray<float>& OutValues)
+	{
+		UCameraControlComponent* CameraControl = NewObject<UCameraControlComponent>(GetTransientPackage());
+		USpringArmComponent* SpringArm = NewObject<USpringArmComponent>(GetTransientPackage());
+		UCameraComponent* Camera = NewObject<UCameraComponent>(GetTransientPackage());
+
+		SpringArm->TargetArmLength = START_ARM_LENGTH;
+		CameraControl->InitializeCameraComponents(SpringArm, Camera);
+		CameraControl->bUseFixedStepSimulation = true;
+		CameraControl->FixedStepRate = 120.0f;
+		CameraControl->MaxFixedSubSteps = 8;
+		CameraControl->bUseSpringSmoothing = bSpringSmoothing;
+
+		// SetSpringArmLengthSmooth 需要 World 取开始时间，这里直接设置插值状态
+		CameraControl->bIsInterpolatingArmLength = true;
+		CameraControl->ArmLengthInterpStart = START_ARM_LENGTH;
+		CameraControl->ArmLengthInterpTarget = TARGET_ARM_LENGTH;
+		CameraControl->ArmLengthInterpSpeed = 3.0f;
+
+		double Time = 0.0;
+		OutTimes.Reset(FrameDeltas.Num());
+		OutValues.Reset(FrameDeltas.Num());
+
+		for (const float FrameDelta : FrameDeltas)
+		{
+			CameraControl->TickFixedStepSimulation(FrameDelta);
+			Time += FrameDelta;
+			OutTimes.Add((float)Time);
+			OutValues.Add(SpringArm->TargetArmLength);
+		}
+	}
+
+	/**
+	 * 锁定跟踪：玩家站在原点，锁定一个偏右上方的静止目标，控制器旋转从零开始收敛
+	 * 走 SimulateCameraStep -> UpdateLockOnCamera -> SmoothControlRotation 的真实路径
+	 */
+	static void RunLockOn(UWorld* World, const TArray<float>& FrameDeltas, bool bSpringSmoothing,
+		TArray<float>& OutTimes, TArray<FRotator>& OutRotations)
+	{
+		ACharacter* Player = World->SpawnActor<ACharacter>(FVector::ZeroVector, FRotator::ZeroRotator);
+		APlayerController* PlayerController = World->SpawnActor<APlayerController>();
+		Player->Controller = PlayerController;
+		PlayerController->SetControlRotation(FRotator::ZeroRotator);
+
+		AActor* Target = World->SpawnActor<AActor>();
+		USceneComponent* TargetRoot = NewObject<USceneComponent>(Target, TEXT("TargetRoot"));
+		Target->SetRootComponent(TargetRoot);
+		TargetRoot->RegisterComponent();
+		Target->SetActorLocation(FVector(800.0f, 600.0f, 350.0f));
+
+		UCameraControlComponent* CameraControl = NewObject<UCameraControlComponent>(Player, TEXT("CameraControl"));
+		USpringArmComponent* SpringArm = NewObject<USpringArmComponent>(Player, TEXT("TestSpringArm"));
+		UCameraComponent* Camera = NewObject<UCameraComponent>(Player, TEXT("TestCamera"));
+		CameraControl->InitializeCameraComponents(SpringArm, Camera);
+		CameraControl->bUseFixedStepSimulation = true;
+		CameraControl->FixedStepRate = 120.0f;
+		CameraControl->MaxFixedSubSteps = 8;
+		CameraControl->bUseSpringSmoothing = bSpringSmoothing;
+		CameraControl->CurrentLockOnTarget = Target;
+
+		double Time = 0.0;
+		OutTimes.Reset(FrameDeltas.Num());
+		OutRotations.Reset(FrameDeltas.Num());
+
+		for (const float FrameDelta : FrameDeltas)
+		{
+			CameraControl->TickFixedStepSimulation(FrameDelta);
+			Time += FrameDelta;
+			OutTimes.Add((float)Time);
+			OutRotations.Add(PlayerController->GetControlRotation());
+		}
+
+		Target->Destroy();
+		PlayerController->Destroy();
+		Player->Destroy();
+	}
+
+	/** 两个旋转的偏航/俯仰最大角差（度） */
+	static float RotationDifference(const FRotator& A, const FRotator& B)
+	{
+		return FMath::Max(FMath::Abs(FMath::FindDeltaAngleDegrees(A.Yaw, B.Yaw)), FMath::Abs(FMath::FindDeltaAngleDegrees(A.Pitch, B.Pitch)));
+	}
+
+	/** 在参考轨迹上按时间线性取值 */
+	static float SampleReference(const TArray<float>& ReferenceValues, float Time)
+	{
+		const float Index = Time * REFERENCE_FRAME_RATE - 1.0f;
+		const int32 Lower = FMath::Clamp(FMath::FloorToInt(Index), 0, ReferenceValues.Num() - 1);
+		const int32 Upper = FMath::Min(Lower + 1, ReferenceValues.Num() - 1);
+		return FMath::Lerp(ReferenceValues[Lower], ReferenceValues[Upper], FMath::Clamp(Index - Lower, 0.0f, 1.0f));
+	}
+
+	/** 某一帧序列相对参考轨迹的最大偏差 */
+	static float MeasureDeviation(const TArray<float>& FrameDeltas, bool bSpringSmoothing, const TArray<float>& ReferenceValues)
+	{
+		TArray<float> Times;
+		TArray<float> Values;
+		Run(FrameDeltas, bSpringSmoothing, Times, Values);
+
+		float MaxDeviation = 0.0f;
+		for (int32 i = 0; i < Times.Num(); ++i)
+		{
+			MaxDeviation = FMath::Max(MaxDeviation, FMath::Abs(Values[i] - SampleReference(ReferenceValues, Times[i])));
+		}
+		return MaxDeviation;
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraFixedStepFrameRateTest, "Soul.Camera.FixedStepFrameRateIndependence",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCameraFixedStepFrameRateTest::RunTest(const FString& Parameters)
+{
+	// 呈现值是相邻两步之间的线性插值，各帧率只是在同一条折线上取样，偏差应只剩浮点误差
+	const float ToleranceUnits = 0.5f;
+	const float Duration = 3.0f;
+
+	struct FFrameRateCase
+	{
+		const TCHAR* Name;
+		float FrameRate;
+		int32 HitchInterval;
+	};
+	const FFrameRateCase Cases[] =
+	{
+		{ TEXT("30 fps"), 30.0f, 0 },
+		{ TEXT("60 fps"), 60.0f, 0 },
+		{ TEXT("144 fps"), 144.0f, 0 },
+		{ TEXT("60 fps + hitch"), 60.0f, 30 },
+	};
+
+	for (const bool bSpringSmoothing : { false, true })
+	{
+		TArray<float> FrameDeltas;
+		TArray<float> ReferenceTimes;
+		TArray<float> ReferenceValues;
+		FCameraFixedStepTestAccess::BuildFrameDeltas(FCameraFixedStepTestAccess::REFERENCE_FRAME_RATE, Duration + 0.1f, 0, FrameDeltas);
+		FCameraFixedStepTestAccess::Run(FrameDeltas, bSpringSmoothing, ReferenceTimes, ReferenceValues);
+
+		// 参考轨迹本身必须真的动起来，否则偏差为 0 也说明不了问题
+		TestTrue(TEXT("Reference trajectory moves towards target"),
+			ReferenceValues.Last() > FCameraFixedStepTestAccess::START_ARM_LENGTH + 100.0f);
+
+		for (const FFrameRateCase& Case : Cases)
+		{
+			FCameraFixedStepTestAccess::BuildFrameDeltas(Case.FrameRate, Duration, Case.HitchInterval, FrameDeltas);
+			const float Deviation = FCameraFixedStepTestAccess::MeasureDeviation(FrameDeltas, bSpringSmoothing, ReferenceValues);
+
+			TestTrue(FString::Printf(TEXT("%s (%s) deviation %.4f <= %.2f"), Case.Name,
+				bSpringSmoothing ? TEXT("spring") : TEXT("interp"), Deviation, ToleranceUnits),
+				Deviation <= ToleranceUnits);
+		}
+	}
+
+	// ==================== 锁定跟踪的旋转收敛 ====================
+	// 频率依赖主要出现在旋转路径：各帧率下同一时刻的偏航/俯仰以及最终朝向必须一致
+	const float RotationToleranceDeg = 0.25f;
+	const float LockOnDuration = 1.5f;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	for (const bool bSpringSmoothing : { false, true })
+	{
+		TArray<float> FrameDeltas;
+		TArray<float> ReferenceTimes;
+		TArray<FRotator> ReferenceRotations;
+		FCameraFixedStepTestAccess::BuildFrameDeltas(FCameraFixedStepTestAccess::REFERENCE_FRAME_RATE, LockOnDuration + 0.1f, 0, FrameDeltas);
+		FCameraFixedStepTestAccess::RunLockOn(World, FrameDeltas, bSpringSmoothing, ReferenceTimes, ReferenceRotations);
+
+		TestTrue(TEXT("Lock-on reference turns towards target"),
+			ReferenceRotations.Num() > 0 && FMath::Abs(ReferenceRotations.Last().Yaw) > 10.0f && FMath::Abs(ReferenceRotations.Last().Pitch) > 1.0f);
+
+		TArray<float> ReferenceYaw;
+		TArray<float> ReferencePitch;
+		for (const FRotator& Rotation : ReferenceRotations)
+		{
+			ReferenceYaw.Add(Rotation.Yaw);
+			ReferencePitch.Add(Rotation.Pitch);
+		}
+
+		for (const float FrameRate : { 30.0f, 60.0f, 144.0f })
+		{
+			FCameraFixedStepTestAccess::BuildFrameDeltas(FrameRate, LockOnDuration, 0, FrameDeltas);
+
+			TArray<float> Times;
+			TArray<FRotator> Rotations;
+			FCameraFixedStepTestAccess::RunLockOn(World, FrameDeltas, bSpringSmoothing, Times, Rotations);
+
+			float MaxDeviation = 0.0f;
+			for (int32 i = 0; i < Times.Num(); ++i)
+			{
+				const FRotator Reference(FCameraFixedStepTestAccess::SampleReference(ReferencePitch, Times[i]),
+					FCameraFixedStepTestAccess::SampleReference(ReferenceYaw, Times[i]), 0.0f);
+				MaxDeviation = FMath::Max(MaxDeviation, FCameraFixedStepTestAccess::RotationDifference(Rotations[i], Reference));
+			}
+
+			const TCHAR* ModeName = bSpringSmoothing ? TEXT("spring") : TEXT("interp");
+			TestTrue(FString::Printf(TEXT("Lock-on %.0f Hz (%s) trajectory deviation %.4f <= %.2f deg"), FrameRate, ModeName, MaxDeviation, RotationToleranceDeg),
+				MaxDeviation <= RotationToleranceDeg);
+
+			// 最终朝向与参考在同一时刻比较
+			const FRotator FinalReference(FCameraFixedStepTestAccess::SampleReference(ReferencePitch, Times.Last()),
+				FCameraFixedStepTestAccess::SampleReference(ReferenceYaw, Times.Last()), 0.0f);
+			const float FinalDifference = FCameraFixedStepTestAccess::RotationDifference(Rotations.Last(), FinalReference);
+			TestTrue(FString::Printf(TEXT("Lock-on %.0f Hz (%s) final rotation difference %.4f <= %.2f deg"), FrameRate, ModeName, FinalDifference, RotationToleranceDeg),
+				FinalDifference <= RotationToleranceDeg);
+		}
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+namespace CameraLockOnPartTest
+{
+	/** 按参考姿势求组件空间位置，选出离根骨骼最远的一根，保证两个部位点确实分开 */
+	static bool FindSeparatedBones(const USkeletalMesh* Mesh, FName& OutFirst, FName& OutSecond)
+	{
+		const FReferenceSkeleton& RefSkeleton = Mesh->GetRefSkeleton();
+		const TArray<FTransform>& RefPose = RefSkeleton.GetRefBonePose();
+		const int32 NumBones = RefSkeleton.GetNum();
+		if (NumBones < 2)
+		{
+			return false;
+		}
+
+		TArray<FTransform> ComponentSpace;
+		ComponentSpace.SetNum(NumBones);
+		int32 FarthestIndex = INDEX_NONE;
+		double FarthestDistanceSquared = FMath::Square(10.0);
+
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+		{
+			const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+			ComponentSpace[BoneIndex] = ParentIndex == INDEX_NONE ? RefPose[BoneIndex] : RefPose[BoneIndex] * ComponentSpace[ParentIndex];
+
+			const double DistanceSquared = FVector::DistSquared(ComponentSpace[BoneIndex].GetLocation(), ComponentSpace[0].GetLocation());
+			if (DistanceSquared > FarthestDistanceSquared)
+			{
+				FarthestDistanceSquared = DistanceSquared;
+				FarthestIndex = BoneIndex;
+			}
+		}
+
+		if (FarthestIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		OutFirst = RefSkeleton.GetBoneName(0);
+		OutSecond = RefSkeleton.GetBoneName(FarthestIndex);
+		return true;
+	}
+
+	static USkeletalMesh* FindTestMesh(FName& OutFirst, FName& OutSecond)
+	{
+		if (USkeletalMesh* EngineMesh = LoadObject<USkeletalMesh>(nullptr, TEXT("/Engine/EngineMeshes/SkeletalCube.SkeletalCube")))
+		{
+			if (FindSeparatedBones(EngineMesh, OutFirst, OutSecond))
+			{
+				return EngineMesh;
+			}
+		}
+
+		for (TObjectIterator<USkeletalMesh> It; It; ++It)
+		{
+			if (FindSeparatedBones(*It, OutFirst, OutSecond))
+			{
+				return *It;
+			}
+		}
+		return nullptr;
+	}
+}
+
+/**
+ * 多部位锁定：UIManager 切换部位后，默认（非 Pipeline）相机的锁定点必须跟着移动并与UI一致
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraLockOnPartSwitchTest, "Soul.Camera.LockOnPartSwitchMovesCamera",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FCameraLockOnPartSwitchTest::RunTest(const FString& Parameters)
+{
+	FName FirstBone;
+	FName SecondBone;
+	USkeletalMesh* Mesh = CameraLockOnPartTest::FindTestMesh(FirstBone, SecondBone);
+	if (!Mesh)
+	{
+		AddError(TEXT("No skeletal mesh with two separated bones is available"));
+		return false;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	// 目标：骨骼网格 + 自定义部位表（两个相距较远的骨骼）
+	AActor* Target = World->SpawnActor<AActor>();
+	USkeletalMeshComponent* TargetMesh = NewObject<USkeletalMeshComponent>(Target, TEXT("TargetMesh"));
+	TargetMesh->SetSkeletalMesh(Mesh);
+	Target->SetRootComponent(TargetMesh);
+	TargetMesh->RegisterComponent();
+
+	ULockOnConfigComponent* Config = NewObject<ULockOnConfigComponent>(Target, TEXT("LockOnConfig"));
+	Config->LockOnPartNames = { FirstBone, SecondBone };
+
+	// 玩家：UIManager 与默认相机组件在同一个 Owner 上
+	AActor* Viewer = World->SpawnActor<AActor>();
+	UUIManagerComponent* UIManager = NewObject<UUIManagerComponent>(Viewer, TEXT("UIManager"));
+	UCameraControlComponent* CameraControl = NewObject<UCameraControlComponent>(Viewer, TEXT("CameraControl"));
+
+	const FVector FirstLocation = CameraControl->GetOptimalLockOnPosition(Target);
+	TestEqual(TEXT("Two parts resolved"), UIManager->GetTargetPartCount(Target), 2);
+
+	UIManager->StepTargetPart(Target, 1);
+	const FVector SecondLocation = CameraControl->GetOptimalLockOnPosition(Target);
+
+	FTransform PartTransform;
+	TestTrue(TEXT("UI has an active part"), UIManager->GetActiveTargetPartTransform(Target, PartTransform));
+	TestFalse(TEXT("Camera lock point moves with the part switch"), FirstLocation.Equals(SecondLocation, 1.0f));
+	TestTrue(TEXT("Camera and UI aim at the same part"), SecondLocation.Equals(PartTransform.GetLocation(), KINDA_SMALL_NUMBER));
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "LockOnConfig.h"
+#include "CameraFixedStep.h"
+#include "CameraSpring.h"
 #include "CameraControlComponent.generated.h"
 
 // 前向声明
@@ -14,6 +16,7 @@ class USpringArmComponent;
 class UCameraComponent;
 class USphereComponent;
 class UTargetDetectionComponent; // 新增
+class UUIManagerComponent;
 
 // 相机状态枚举
 UENUM(BlueprintType)
@@ -114,6 +117,18 @@ struct SOUL_API FViewport3DControl
 	}
 };
 
+/**
+ * 固定步长模拟的相机状态快照
+ * 子步之间保存、帧末在上一步和当前步之间插值后写回组件
+ */
+struct FCameraSimState
+{
+	FRotator ControlRotation = FRotator::ZeroRotator;
+	FRotator ActorRotation = FRotator::ZeroRotator;
+	float ArmLength = 0.0f;
+	FVector SocketOffset = FVector::ZeroVector;
+};
+
 /**
  * 相机控制组件类
  * 负责处理相机跟踪、目标切换、自动修正和高级相机调整功能
@@ -173,6 +188,34 @@ public:
 	/** 普通重置速度 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings|Reset", meta = (ClampMin = "0.1", ClampMax = "20.0"))
 	float NormalResetSpeed = 7.0f;
+
+	/** 是否以固定步长模拟相机平滑（与帧率无关），呈现时在两步之间插值 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings|Fixed Step")
+	bool bUseFixedStepSimulation = false;
+
+	/** 固定步频率（Hz） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings|Fixed Step", meta = (ClampMin = "30.0", ClampMax = "480.0", EditCondition = "bUseFixedStepSimulation"))
+	float FixedStepRate = 120.0f;
+
+	/** 单帧最多子步数，卡顿时超出部分丢弃 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings|Fixed Step", meta = (ClampMin = "1", ClampMax = "32", EditCondition = "bUseFixedStepSimulation"))
+	int32 MaxFixedSubSteps = 8;
+
+	/** 锁定跟踪、目标切换、相机重置与臂长/偏移插值改用临界阻尼弹簧（替代 RInterpTo/FInterpTo） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings|Spring")
+	bool bUseSpringSmoothing = false;
+
+	/** 锁定跟踪的弹簧平滑时间（秒），目标切换时减半 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings|Spring", meta = (ClampMin = "0.02", ClampMax = "2.0", EditCondition = "bUseSpringSmoothing"))
+	float LockOnSpringSmoothTime = 0.2f;
+
+	/** 相机重置的弹簧平滑时间（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings|Spring", meta = (ClampMin = "0.02", ClampMax = "2.0", EditCondition = "bUseSpringSmoothing"))
+	float ResetSpringSmoothTime = 0.25f;
+
+	/** 臂长与 Socket Offset 的弹簧平滑时间（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Settings|Spring", meta = (ClampMin = "0.02", ClampMax = "2.0", EditCondition = "bUseSpringSmoothing"))
+	float ArmLengthSpringSmoothTime = 0.3f;
 	
 	/** 应用FreeLook输入 */
 	UFUNCTION(BlueprintCallable, Category = "FreeLook")
@@ -218,6 +261,12 @@ protected:
 	UPROPERTY()
 	UCameraComponent* CachedCamera;
 
+	/** 缓存的UIManager组件（多部位锁定点与锁定UI共用，首次取锁定点时查找） */
+	mutable TWeakObjectPtr<UUIManagerComponent> CachedUIManager;
+
+	/** 已查找过UIManager（Owner没有该组件时不再每次查找） */
+	mutable bool bUIManagerLookedUp = false;
+
 	/** 是否应让相机跟随目标 */
 	UPROPERTY()
 	bool bShouldCameraFollowTarget;
@@ -707,6 +756,62 @@ private:
 	/** 更新缓存的目标位置（用于稳定插值） */
 	void UpdateCachedTargetLocation(AActor* Target, float DeltaTime);
 
+	// ==================== 固定步长模拟 ====================
+
+	/** 执行一步相机模拟（弹簧臂插值、重置、自动修正、锁定跟踪） */
+	void SimulateCameraStep();
+
+	/** 以固定步长推进相机模拟，并把两步之间的插值结果写回组件 */
+	void TickFixedStepSimulation(float DeltaTime);
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/** 自动化测试直接驱动固定步长模拟（无 World 时无法走 TickComponent） */
+	friend struct FCameraFixedStepTestAccess;
+#endif
+
+	/** 当前模拟步的时长：固定步长子步中返回步长，否则返回本帧间隔 */
+	float GetCameraDeltaTime() const;
+
+	/** 读取/写回固定步长模拟的相机状态 */
+	void CaptureCameraSimState(FCameraSimState& OutState) const;
+	void ApplyCameraSimState(const FCameraSimState& State);
+
+	/** 固定步长时钟 */
+	FCameraFixedStepClock FixedStepClock;
+
+	/** 上一步、当前步的模拟结果，以及上一帧写回组件的呈现值 */
+	FCameraSimState PreviousSimState;
+	FCameraSimState CurrentSimState;
+	FCameraSimState PresentedSimState;
+
+	/** 模拟状态是否已初始化（关闭固定步长后需重新采样） */
+	bool bHasFixedStepState = false;
+
+	/** 是否正在执行固定步长子步 */
+	bool bInFixedStep = false;
+
+	// ==================== 弹簧平滑 ====================
+
+	/** 控制旋转平滑：启用弹簧时使用临界阻尼弹簧，否则沿用 RInterpTo */
+	FRotator SmoothControlRotation(const FRotator& Current, const FRotator& Target, float InterpSpeed, float SpringSmoothTime);
+
+	/** 臂长平滑：启用弹簧时使用临界阻尼弹簧，否则沿用 FInterpTo */
+	float SmoothArmLength(float Current, float Target, float InterpSpeed);
+
+	/** Socket Offset 平滑：启用弹簧时使用临界阻尼弹簧，否则沿用 VInterpTo */
+	FVector SmoothSocketOffset(const FVector& Current, const FVector& Target, float InterpSpeed);
+
+	/** 弹簧速度状态；中断超过一个模拟步未更新时清零，避免残留速度 */
+	FCameraSpringRotator ControlRotationSpring;
+	FCameraSpringFloat ArmLengthSpring;
+	FCameraSpringVector SocketOffsetSpring;
+
+	/** 模拟步计数（每次 SimulateCameraStep 加一），以及各弹簧最近一次更新的步 */
+	uint64 CameraSimStep = 0;
+	uint64 ControlRotationSpringStep = 0;
+	uint64 ArmLengthSpringStep = 0;
+	uint64 SocketOffsetSpringStep = 0;
+
 	// ==================== 可配置参数：时间间隔 ====================
 	UPROPERTY(EditAnywhere, Category = "Camera|Debug|Intervals", meta = (ClampMin = "1.0", ClampMax = "60.0"))
 	float ComponentValidationInterval = 5.0f;
@@ -80,9 +80,42 @@ void UCameraDebugComponent::BeginPlay()
 {
     Super::BeginPlay();
     
+    // 订阅帧预算看门狗
+    if (UPerformanceProfiler* Profiler = UPerformanceProfiler::GetPerformanceProfiler(this))
+    {
+        Profiler->OnBudgetExceeded.AddDynamic(this, &UCameraDebugComponent::HandleBudgetExceeded);
+        BoundProfiler = Profiler;
+    }
+    
     UE_LOG(LogTemp, Log, TEXT("CameraDebugComponent initialized - Debug visualization for development only"));
 }
 
+void UCameraDebugComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UPerformanceProfiler* Profiler = BoundProfiler.Get())
+    {
+        Profiler->OnBudgetExceeded.RemoveDynamic(this, &UCameraDebugComponent::HandleBudgetExceeded);
+    }
+    BoundProfiler.Reset();
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+void UCameraDebugComponent::HandleBudgetExceeded(const FPerformanceBudgetViolation& Violation)
+{
+    LastBudgetViolation = Violation;
+    LastBudgetViolationTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+    BudgetViolationCount++;
+    
+    if (bShowPerformanceStats && GEngine)
+    {
+        // 固定Key，持续超标时覆盖同一条消息而不是刷屏
+        GEngine->AddOnScreenDebugMessage(static_cast<uint64>(GetUniqueID()), BUDGET_VIOLATION_DISPLAY_TIME, FColor::Red,
+            FString::Printf(TEXT("BUDGET: %s %.3f ms > %.3f ms (frame %d)"),
+                *Violation.ScopeName, Violation.MeasuredMs, Violation.BudgetMs, Violation.FrameNumber));
+    }
+}
+
 void UCameraDebugComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -251,8 +284,30 @@ void UCameraDebugComponent::DrawPerformanceStats()
             CameraControl->GetCurrentLockOnTarget() ? TEXT("YES") : TEXT("NO"));
     }
     
+    // 每帧计数器（上一帧值 / 每帧平均）
+    if (UPerformanceProfiler* Profiler = BoundProfiler.Get())
+    {
+        const TArray<FPerformanceCounterData> Counters = Profiler->GetCounterReport();
+        const int32 NumToShow = FMath::Min(Counters.Num(), MAX_DISPLAYED_COUNTERS);
+        for (int32 i = 0; i < NumToShow; ++i)
+        {
+            PerfText += FString::Printf(TEXT("%s: %d (avg %.1f)\n"),
+                *Counters[i].CounterName, Counters[i].LastFrameValue, Counters[i].AveragePerFrame);
+        }
+    }
+    
+    // 帧预算超标信息
+    FColor PerfColor = FColor::Orange;
+    PerfText += FString::Printf(TEXT("Budget Violations: %d\n"), BudgetViolationCount);
+    if (LastBudgetViolationTime >= 0.0f && GetWorld()->GetTimeSeconds() - LastBudgetViolationTime < BUDGET_VIOLATION_DISPLAY_TIME)
+    {
+        PerfText += FString::Printf(TEXT("OVER: %s %.3f/%.3f ms\n"),
+            *LastBudgetViolation.ScopeName, LastBudgetViolation.MeasuredMs, LastBudgetViolation.BudgetMs);
+        PerfColor = FColor::Red;
+    }
+    
     // 在玩家左侧显示
-    Draw3DDebugString(OwnerLocation + FVector(-150, 0, 100), PerfText, FColor::Orange);
+    Draw3DDebugString(OwnerLocation + FVector(-150, 0, 100), PerfText, PerfColor);
 }
 
 void UCameraDebugComponent::ClearAllDebugDrawing()
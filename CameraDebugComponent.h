@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "PerformanceProfiler.h"
 #include "CameraDebugComponent.generated.h"
 
 /** Debug可视化模式 */
@@ -30,6 +31,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 public:
@@ -96,6 +98,26 @@ private:
     float AverageTickTime;
     int32 FrameCounter;
     
+    // ==================== 帧预算超标显示 ====================
+    /** 性能分析器预算超标回调 */
+    UFUNCTION()
+    void HandleBudgetExceeded(const FPerformanceBudgetViolation& Violation);
+    
+    /** 已绑定的性能分析器 */
+    UPROPERTY()
+    TWeakObjectPtr<UPerformanceProfiler> BoundProfiler;
+    
+    /** 最近一次超标 */
+    FPerformanceBudgetViolation LastBudgetViolation;
+    float LastBudgetViolationTime = -1.0f;
+    int32 BudgetViolationCount = 0;
+    
+    /** 超标提示在屏幕上保留的时间（秒） */
+    static constexpr float BUDGET_VIOLATION_DISPLAY_TIME = 3.0f;
+    
+    /** 性能统计中显示的计数器数量 */
+    static constexpr int32 MAX_DISPLAYED_COUNTERS = 8;
+    
     /** 绘制3D文本 */
     void Draw3DDebugString(const FVector& Location, const FString& Text, const FColor& Color);
 };
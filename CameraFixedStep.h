@@ -0,0 +1,62 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 相机固定步长时钟
+ * 把可变的帧间隔累积起来，按固定频率切成若干子步；
+ * 不足一步的剩余时间作为呈现插值系数，在上一步和当前步的结果之间插值
+ * 平滑逻辑只在子步中积分，轨迹与渲染帧率无关
+ */
+struct SOUL_API FCameraFixedStepClock
+{
+	/** 固定步频率（Hz） */
+	float StepRate = 120.0f;
+
+	/** 单帧最多子步数，卡顿时丢弃多余的整步，避免越补越慢 */
+	int32 MaxSubSteps = 8;
+
+	/** 尚未模拟的累积时间（秒） */
+	float Accumulator = 0.0f;
+
+	/** 每个子步的时长 */
+	float GetStepDeltaTime() const
+	{
+		return 1.0f / FMath::Max(StepRate, 1.0f);
+	}
+
+	/**
+	 * 推进一帧
+	 * @param DeltaTime - 本帧的真实帧间隔
+	 * @return 本帧需要执行的子步数
+	 */
+	int32 Advance(float DeltaTime)
+	{
+		const float StepDeltaTime = GetStepDeltaTime();
+		Accumulator += FMath::Max(DeltaTime, 0.0f);
+
+		int32 NumSteps = FMath::FloorToInt(Accumulator / StepDeltaTime);
+		if (NumSteps > MaxSubSteps)
+		{
+			// 超出部分的整步直接丢弃，只保留不足一步的余量
+			NumSteps = FMath::Max(MaxSubSteps, 1);
+			Accumulator = FMath::Fmod(Accumulator, StepDeltaTime) + NumSteps * StepDeltaTime;
+		}
+
+		Accumulator = FMath::Max(Accumulator - NumSteps * StepDeltaTime, 0.0f);
+		return NumSteps;
+	}
+
+	/** 呈现插值系数：0=上一步结果，1=当前步结果 */
+	float GetAlpha() const
+	{
+		return FMath::Clamp(Accumulator / GetStepDeltaTime(), 0.0f, 1.0f);
+	}
+
+	void Reset()
+	{
+		Accumulator = 0.0f;
+	}
+};
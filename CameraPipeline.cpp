@@ -7,6 +7,27 @@
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "PerformanceProfiler.h"
+#include "Camera/CameraState_Free.h"
+#include "Camera/CameraState_LockOn.h"
+#include "Misc/AutomationTest.h"
+
+// ==================== FCameraPipelineEvaluateTickFunction ====================
+
+void FCameraPipelineEvaluateTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && IsValid(Target) && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->BeginStateEvaluation(DeltaTime);
+	}
+}
+
+FString FCameraPipelineEvaluateTickFunction::DiagnosticMessage()
+{
+	return Target ? Target->GetFullName() + TEXT("[EvaluateState]") : TEXT("<NULL>[EvaluateState]");
+}
+
+// ==================== UCameraPipeline ====================
 
 UCameraPipeline::UCameraPipeline()
 {
@@ -14,6 +35,11 @@ UCameraPipeline::UCameraPipeline()
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.TickGroup = TG_PostUpdateWork; // 在物理和动画之后更新
 
+	// 求值Tick：移动与物理结束后采集快照，与PostPhysics剩余的游戏线程工作并行计算
+	EvaluateTickFunction.bCanEverTick = true;
+	EvaluateTickFunction.bStartWithTickEnabled = true;
+	EvaluateTickFunction.TickGroup = TG_PostPhysics;
+
 	// 初始化默认混合配置
 	DefaultBlendInfo = FCameraBlendInfo(0.5f, 2.0f, false);
 
@@ -21,12 +47,6 @@ UCameraPipeline::UCameraPipeline()
 	CurrentState = ECameraPipelineState::Free;
 	PreviousState = ECameraPipelineState::None;
 
-	// 混合状态初始化
-	bIsBlending = false;
-	StateBlendTimer = 0.0f;
-	StateBlendDuration = 0.5f;
-	CurrentBlendExponent = 2.0f;
-
 	// 后处理配置
 	bEnableCollisionDetection = true;
 	CollisionSafetyFactor = 0.9f;
@@ -58,6 +78,10 @@ void UCameraPipeline::BeginPlay()
 		}
 	}
 
+	// 混合栈从初始状态开始
+	ResetBlendStack(CurrentState);
+	PublishedNumBlendLayers = NumBlendLayers;
+
 	if (bEnableDebugLogs)
 	{
 		UE_LOG(LogTemp, Log, TEXT("CameraPipeline: Initialized with %d states"), StateInstances.Num());
@@ -68,6 +92,8 @@ void UCameraPipeline::TickComponent(float DeltaTime, ELevelTick TickType, FActor
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	SOUL_PERFORMANCE_SCOPE(TEXT("CameraPipeline.Tick"));
+
 	// 验证组件引用
 	if (!OwnerCharacter || !CachedSpringArm || !CachedCamera)
 	{
@@ -78,51 +104,32 @@ void UCameraPipeline::TickComponent(float DeltaTime, ELevelTick TickType, FActor
 		return;
 	}
 
-	// 获取当前状态实例
-	UCameraStateBase* CurrentStateInstance = StateInstances.FindRef(CurrentState);
-	if (!CurrentStateInstance)
+	if (bHasEvaluatedOutput)
 	{
-		if (bEnableDebugLogs)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("CameraPipeline: No state instance for current state"));
-		}
-		return;
+		// 汇合工作线程的求值结果
+		WaitForStateEvaluation();
+		FinalOutput = EvaluatedOutput;
+		bHasEvaluatedOutput = false;
 	}
-
-	// 计算当前状态输出
-	FCameraStateOutput NewOutput = CurrentStateInstance->CalculateState(DeltaTime, OwnerCharacter, CachedSpringArm, CachedCamera);
-	
-	// 如果正在切换状态，进行混合
-	if (bIsBlending && StateBlendTimer < StateBlendDuration && PreviousState != ECameraPipelineState::None)
+	else
 	{
-		StateBlendTimer += DeltaTime;
-		float Alpha = FMath::Clamp(StateBlendTimer / StateBlendDuration, 0.0f, 1.0f);
-		
-		// 使用缓动函数实现平滑过渡
-		Alpha = FMath::InterpEaseInOut(0.0f, 1.0f, Alpha, CurrentBlendExponent);
-		
-		// 混合两个状态的输出
-		CurrentStateOutput = BlendStates(PreviousStateOutput, NewOutput, Alpha);
-		
-		// 检查混合是否完成
-		if (StateBlendTimer >= StateBlendDuration)
-		{
-			bIsBlending = false;
+		// 获取当前状态实例
+		if (!StateInstances.FindRef(CurrentState))
+		{
 			if (bEnableDebugLogs)
 			{
-				UE_LOG(LogTemp, Log, TEXT("CameraPipeline: Blend completed"));
+				UE_LOG(LogTemp, Warning, TEXT("CameraPipeline: No state instance for current state"));
 			}
+			return;
 		}
+
+		FinalOutput = EvaluatePipeline(DeltaTime, nullptr);
 	}
-	else
-	{
-		// 不混合时直接使用当前状态输出
-		CurrentStateOutput = NewOutput;
-		bIsBlending = false;
-	}
+
+	// 汇合后发布给游戏线程读取的混合状态
+	PublishedNumBlendLayers = NumBlendLayers;
 	
 	// 应用后处理（碰撞检测等）
-	FinalOutput = CurrentStateOutput;
 	ApplyPostProcessing(FinalOutput);
 
 	// 应用相机输出到组件
@@ -136,7 +143,7 @@ void UCameraPipeline::TickComponent(float DeltaTime, ELevelTick TickType, FActor
 			1, 
 			0.0f, 
 			FColor::Cyan, 
-			FString::Printf(TEXT("Camera State: %s %s"), *StateText, bIsBlending ? TEXT("[BLENDING]") : TEXT(""))
+			FString::Printf(TEXT("Camera State: %s %s"), *StateText, IsBlending() ? TEXT("[BLENDING]") : TEXT(""))
 		);
 		GEngine->AddOnScreenDebugMessage(
 			2, 
@@ -144,21 +151,259 @@ void UCameraPipeline::TickComponent(float DeltaTime, ELevelTick TickType, FActor
 			FColor::White, 
 			FString::Printf(TEXT("Arm Length: %.1f | FOV: %.1f"), FinalOutput.ArmLength, FinalOutput.FieldOfView)
 		);
-		if (bIsBlending)
+		if (IsBlending())
 		{
-			float BlendProgress = (StateBlendTimer / StateBlendDuration) * 100.0f;
+			const FCameraBlendLayer& TopLayer = BlendLayers[NumBlendLayers - 1];
+			float BlendProgress = FMath::Clamp(TopLayer.BlendTimer / FMath::Max(TopLayer.BlendDuration, KINDA_SMALL_NUMBER), 0.0f, 1.0f) * 100.0f;
 			GEngine->AddOnScreenDebugMessage(
 				3, 
 				0.0f, 
 				FColor::Yellow, 
-				FString::Printf(TEXT("Blend Progress: %.1f%%"), BlendProgress)
+				FString::Printf(TEXT("Blend Progress: %.1f%% | Layers: %d"), BlendProgress, NumBlendLayers)
 			);
 		}
 	}
 }
 
+void UCameraPipeline::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	WaitForStateEvaluation();
+	bHasEvaluatedOutput = false;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UCameraPipeline::RegisterComponentTickFunctions(bool bRegister)
+{
+	Super::RegisterComponentTickFunctions(bRegister);
+
+	if (bRegister)
+	{
+		if (SetupActorComponentTickFunction(&EvaluateTickFunction))
+		{
+			EvaluateTickFunction.Target = this;
+		}
+	}
+	else
+	{
+		WaitForStateEvaluation();
+		bHasEvaluatedOutput = false;
+
+		if (EvaluateTickFunction.IsTickFunctionRegistered())
+		{
+			EvaluateTickFunction.UnRegisterTickFunction();
+		}
+	}
+}
+
+void UCameraPipeline::BeginStateEvaluation(float DeltaTime)
+{
+	if (!bEvaluateOnWorkerThread || !OwnerCharacter || !CachedSpringArm || !CachedCamera)
+	{
+		return;
+	}
+
+	// 上一次的任务理应已在主Tick汇合，这里只做保护
+	WaitForStateEvaluation();
+
+	UCameraStateBase* CurrentStateInstance = StateInstances.FindRef(CurrentState);
+	if (!CurrentStateInstance)
+	{
+		return;
+	}
+
+	// 需要访问世界的部分留在游戏线程，可能切换状态，之后重新获取实例
+	CurrentStateInstance->PreEvaluateState(OwnerCharacter);
+
+	CurrentStateInstance = StateInstances.FindRef(CurrentState);
+	if (!CurrentStateInstance || !CurrentStateInstance->CanEvaluateOnWorkerThread())
+	{
+		return;
+	}
+
+	// 混合栈中仍有贡献的状态也必须能在工作线程求值
+	for (int32 i = 0; i < NumBlendLayers; ++i)
+	{
+		const FCameraBlendLayer& Layer = BlendLayers[i];
+		UCameraStateBase* LayerInstance = Layer.bFrozen ? nullptr : StateInstances.FindRef(Layer.State);
+		if (LayerInstance && !LayerInstance->CanEvaluateOnWorkerThread())
+		{
+			return;
+		}
+	}
+
+	EvaluationInputs = FCameraStateInputs::Capture(OwnerCharacter, CachedSpringArm, CachedCamera);
+	bHasEvaluatedOutput = true;
+
+	SOUL_COUNTER_INC(TEXT("CameraPipeline.WorkerEvaluations"));
+	EvaluationTask = FFunctionGraphTask::CreateAndDispatchWhenReady([this, DeltaTime]()
+	{
+		EvaluatedOutput = EvaluatePipeline(DeltaTime, &EvaluationInputs);
+	}, TStatId(), nullptr, ENamedThreads::AnyHiPriThreadNormalTask);
+}
+
+void UCameraPipeline::WaitForStateEvaluation() const
+{
+	if (EvaluationTask.IsValid())
+	{
+		SOUL_PERFORMANCE_SCOPE(TEXT("CameraPipeline.WaitForEvaluation"));
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(EvaluationTask, ENamedThreads::GameThread_Local);
+		EvaluationTask = nullptr;
+	}
+}
+
+FCameraStateOutput UCameraPipeline::EvaluatePipeline(float DeltaTime, const FCameraStateInputs* Inputs)
+{
+	FCameraStateOutput Output;
+
+	if (bUseFixedStepSimulation)
+	{
+		FixedStepClock.StepRate = FixedStepRate;
+		FixedStepClock.MaxSubSteps = MaxFixedSubSteps;
+
+		// 首帧先算一步作为插值起点
+		if (!bHasStepOutput)
+		{
+			CurrentStepOutput = SimulateStep(FixedStepClock.GetStepDeltaTime(), Inputs);
+			PreviousStepOutput = CurrentStepOutput;
+			FixedStepClock.Reset();
+			bHasStepOutput = true;
+		}
+
+		const int32 NumSteps = FixedStepClock.Advance(DeltaTime);
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			PreviousStepOutput = CurrentStepOutput;
+			CurrentStepOutput = SimulateStep(FixedStepClock.GetStepDeltaTime(), Inputs);
+		}
+		SOUL_COUNTER_ADD(TEXT("CameraPipeline.FixedSubSteps"), NumSteps);
+
+		// 在上一步和当前步之间插值，强制标记取当前步
+		Output = BlendStates(PreviousStepOutput, CurrentStepOutput, FixedStepClock.GetAlpha());
+		Output.bForceSpringArmRotation = CurrentStepOutput.bForceSpringArmRotation;
+		Output.bForceControllerRotation = CurrentStepOutput.bForceControllerRotation;
+	}
+	else
+	{
+		bHasStepOutput = false;
+		Output = SimulateStep(DeltaTime, Inputs);
+	}
+
+	return Output;
+}
+
+FCameraStateOutput UCameraPipeline::SimulateStep(float StepDeltaTime, const FCameraStateInputs* Inputs)
+{
+	// 状态计算中可能切换状态（如锁定目标丢失），每步重新获取实例
+	UCameraStateBase* CurrentStateInstance = StateInstances.FindRef(CurrentState);
+	if (!CurrentStateInstance)
+	{
+		return CurrentStateOutput;
+	}
+
+	if (NumBlendLayers == 0)
+	{
+		ResetBlendStack(CurrentState);
+	}
+
+	// 非当前状态的层只做纯数学求值，避免已退出的状态再触发自动解锁等副作用；
+	// 不支持纯数学求值的状态（蓝图重写）冻结在最近一次输出
+	FCameraStateInputs LayerInputs;
+	const FCameraStateInputs* LayerInputsPtr = Inputs;
+
+	// 求值途中可能切换状态并压入新层，每次循环重新读取层数
+	for (int32 i = 0; i < NumBlendLayers; ++i)
+	{
+		const ECameraPipelineState LayerState = BlendLayers[i].State;
+		if (BlendLayers[i].bFrozen)
+		{
+			continue;
+		}
+
+		// 同一状态在栈中出现多次时（快速来回切换）每步只求值一次
+		int32 EvaluatedIndex = INDEX_NONE;
+		for (int32 j = 0; j < i; ++j)
+		{
+			if (!BlendLayers[j].bFrozen && BlendLayers[j].State == LayerState)
+			{
+				EvaluatedIndex = j;
+				break;
+			}
+		}
+		if (EvaluatedIndex != INDEX_NONE)
+		{
+			BlendLayers[i].Output = BlendLayers[EvaluatedIndex].Output;
+			continue;
+		}
+
+		UCameraStateBase* LayerInstance = StateInstances.FindRef(LayerState);
+		if (!LayerInstance)
+		{
+			continue;
+		}
+
+		if (LayerState != CurrentState && !LayerInstance->CanEvaluateOnWorkerThread())
+		{
+			BlendLayers[i].State = ECameraPipelineState::None;
+			BlendLayers[i].bFrozen = true;
+			continue;
+		}
+
+		// 有快照时走纯数学求值，可在工作线程执行
+		SOUL_COUNTER_INC(TEXT("CameraPipeline.StateEvaluations"));
+		FCameraStateOutput LayerOutput;
+		if (LayerState == CurrentState)
+		{
+			LayerOutput = Inputs
+				? LayerInstance->EvaluateState(*Inputs, StepDeltaTime)
+				: LayerInstance->CalculateState(StepDeltaTime, OwnerCharacter, CachedSpringArm, CachedCamera);
+		}
+		else
+		{
+			if (!LayerInputsPtr)
+			{
+				LayerInputs = FCameraStateInputs::Capture(OwnerCharacter, CachedSpringArm, CachedCamera);
+				LayerInputsPtr = &LayerInputs;
+			}
+			LayerOutput = LayerInstance->EvaluateState(*LayerInputsPtr, StepDeltaTime);
+		}
+
+		// 求值中的切换可能合并或重置了栈，层已移动时丢弃本次结果
+		if (i < NumBlendLayers && BlendLayers[i].State == LayerState)
+		{
+			BlendLayers[i].Output = LayerOutput;
+		}
+	}
+
+	// 按权重合成各层输出
+	CurrentStateOutput = ComposeBlendStack(StepDeltaTime);
+
+	// 臂长弹簧：从上一步的臂长出发追随本步输出
+	if (bUseArmLengthSpring)
+	{
+		if (!bHasSpringArmLength)
+		{
+			SpringArmLength = CurrentStateOutput.ArmLength;
+			ArmLengthSpring.Reset();
+			bHasSpringArmLength = true;
+		}
+
+		SpringArmLength = ArmLengthSpring.Update(SpringArmLength, CurrentStateOutput.ArmLength, ArmLengthSpringSmoothTime, StepDeltaTime);
+		CurrentStateOutput.ArmLength = SpringArmLength;
+	}
+	else
+	{
+		bHasSpringArmLength = false;
+	}
+
+	return CurrentStateOutput;
+}
+
 bool UCameraPipeline::SetCameraState(ECameraPipelineState NewState, bool bForceChange)
 {
+	// 切换状态会修改混合参数与状态实例，先等待工作线程求值完成
+	WaitForStateEvaluation();
+
 	// 如果已经是目标状态，不需要切换
 	if (CurrentState == NewState && !bForceChange)
 	{
@@ -206,6 +451,9 @@ bool UCameraPipeline::SetCameraState(ECameraPipelineState NewState, bool bForceC
 
 UCameraStateBase* UCameraPipeline::GetStateInstance(ECameraPipelineState State) const
 {
+	// 调用方可能读写实例成员，先等待工作线程求值结束
+	WaitForStateEvaluation();
+
 	return StateInstances.FindRef(State);
 }
 
@@ -230,6 +478,86 @@ void UCameraPipeline::ApplyCameraOutput()
 	// CachedSpringArm->SetWorldLocation(FinalOutput.TargetPosition);
 }
 
+void UCameraPipeline::ResetBlendStack(ECameraPipelineState State)
+{
+	BlendLayers[0] = FCameraBlendLayer();
+	BlendLayers[0].State = State;
+	BlendLayers[0].Output = CurrentStateOutput;
+	NumBlendLayers = 1;
+}
+
+void UCameraPipeline::PushBlendLayer(ECameraPipelineState State, const FCameraBlendInfo& BlendInfo)
+{
+	if (NumBlendLayers == 0)
+	{
+		ResetBlendStack(State);
+		return;
+	}
+
+	if (NumBlendLayers == MaxBlendLayers)
+	{
+		// 栈满：最底下两层按当前权重合并为冻结层，保持画面连续，代价有上限
+		FCameraBlendLayer& Merged = BlendLayers[1];
+		Merged.Output = BlendStates(BlendLayers[0].Output, Merged.Output, Merged.GetWeight());
+		Merged.State = ECameraPipelineState::None;
+		Merged.bFrozen = true;
+
+		for (int32 i = 1; i < NumBlendLayers; ++i)
+		{
+			BlendLayers[i - 1] = BlendLayers[i];
+		}
+		--NumBlendLayers;
+
+		SOUL_COUNTER_INC(TEXT("CameraPipeline.BlendLayerMerges"));
+	}
+
+	// 新层从切换前的输出起步，本步求值后即被实时输出覆盖
+	FCameraBlendLayer& Layer = BlendLayers[NumBlendLayers++];
+	Layer = FCameraBlendLayer();
+	Layer.State = State;
+	Layer.BlendDuration = BlendInfo.BlendTime;
+	Layer.BlendExponent = BlendInfo.BlendExponent;
+	Layer.Output = CurrentStateOutput;
+}
+
+FCameraStateOutput UCameraPipeline::ComposeBlendStack(float StepDeltaTime)
+{
+	FCameraStateOutput Result = BlendLayers[0].Output;
+
+	// 从栈底向上逐层覆盖，记录最上面一个已完全混入的层
+	int32 NewBaseIndex = 0;
+	for (int32 i = 1; i < NumBlendLayers; ++i)
+	{
+		FCameraBlendLayer& Layer = BlendLayers[i];
+		Layer.BlendTimer += StepDeltaTime;
+
+		// 使用缓动函数实现平滑过渡
+		Result = BlendStates(Result, Layer.Output, Layer.GetWeight());
+
+		if (Layer.IsFullyBlended())
+		{
+			NewBaseIndex = i;
+		}
+	}
+
+	// 完全混入的层覆盖了下面所有层，折叠掉不再有贡献的层
+	if (NewBaseIndex > 0)
+	{
+		for (int32 i = NewBaseIndex; i < NumBlendLayers; ++i)
+		{
+			BlendLayers[i - NewBaseIndex] = BlendLayers[i];
+		}
+		NumBlendLayers -= NewBaseIndex;
+
+		if (bEnableDebugLogs)
+		{
+			UE_LOG(LogTemp, Log, TEXT("CameraPipeline: Blend completed, collapsed %d layer(s), %d remaining"), NewBaseIndex, NumBlendLayers);
+		}
+	}
+
+	return Result;
+}
+
 FCameraStateOutput UCameraPipeline::BlendStates(const FCameraStateOutput& From, const FCameraStateOutput& To, float Alpha) const
 {
 	FCameraStateOutput Result;
@@ -268,6 +596,7 @@ void UCameraPipeline::ApplyPostProcessing(FCameraStateOutput& Output)
 	Params.AddIgnoredActor(OwnerCharacter);
 	Params.bTraceComplex = false; // 使用简单碰撞以提高性能
 
+	SOUL_COUNTER_INC(TEXT("CameraPipeline.Traces"));
 	if (GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_Camera, Params))
 	{
 		// 调整臂长避免穿墙
@@ -360,9 +689,6 @@ bool UCameraPipeline::SwitchToState(ECameraPipelineState NewState)
 		return false;
 	}
 
-	// 保存切换前的输出作为混合起点
-	PreviousStateOutput = CurrentStateOutput;
-	
 	// 调用当前状态的OnExitState
 	if (CurrentStateInstance)
 	{
@@ -382,24 +708,29 @@ bool UCameraPipeline::SwitchToState(ECameraPipelineState NewState)
 		BlendInfo = &DefaultBlendInfo;
 	}
 
-	// 设置混合参数
-	StateBlendDuration = BlendInfo->BlendTime;
-	CurrentBlendExponent = BlendInfo->BlendExponent;
-	StateBlendTimer = 0.0f;
-	
-	// 只有当混合时间大于0时才启用混合
-	bIsBlending = (StateBlendDuration > 0.0f && PreviousState != ECameraPipelineState::None);
+	// 只有当混合时间大于0时才压入混合层；旧的层继续求值，直到被完全覆盖
+	if (BlendInfo->BlendTime > 0.0f && PreviousState != ECameraPipelineState::None)
+	{
+		PushBlendLayer(NewState, *BlendInfo);
+	}
+	else
+	{
+		ResetBlendStack(NewState);
+	}
+
+	PublishedNumBlendLayers = NumBlendLayers;
 
 	// 调用新状态的OnEnterState
 	NewStateInstance->OnEnterState(OwnerCharacter, CurrentStateInstance);
 
 	if (bEnableDebugLogs)
 	{
-		UE_LOG(LogTemp, Log, TEXT("CameraPipeline: Switched from %s to %s (Blending: %s, Duration: %.2f)"), 
+		UE_LOG(LogTemp, Log, TEXT("CameraPipeline: Switched from %s to %s (Blending: %s, Duration: %.2f, Layers: %d)"), 
 			*UEnum::GetValueAsString(PreviousState), 
 			*UEnum::GetValueAsString(CurrentState),
-			bIsBlending ? TEXT("Yes") : TEXT("No"),
-			StateBlendDuration);
+			IsBlending() ? TEXT("Yes") : TEXT("No"),
+			BlendInfo->BlendTime,
+			NumBlendLayers);
 	}
 
 	return true;
@@ -436,3 +767,289 @@ void UCameraPipeline::CacheComponents()
 			CachedCamera ? TEXT("Valid") : TEXT("NULL"));
 	}
 }
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * 直接驱动混合栈：自由/锁定两个C++状态用固定的输入快照求值，
+ * 检查打断过渡时的输出连续性、栈容量、合并、折叠以及各层的求值方式
+ */
+struct FCameraPipelineTestAccess
+{
+	static constexpr float STEP_DELTA_TIME = 1.0f / 60.0f;
+	static constexpr float BLEND_TIME = 0.5f;
+
+	static UCameraPipeline* CreatePipeline()
+	{
+		UCameraPipeline* Pipeline = NewObject<UCameraPipeline>(GetTransientPackage());
+		Pipeline->DefaultBlendInfo = FCameraBlendInfo(BLEND_TIME, 2.0f, false);
+		Pipeline->StateInstances.Add(ECameraPipelineState::Free, NewObject<UCameraState_Free>(Pipeline));
+		Pipeline->StateInstances.Add(ECameraPipelineState::LockOn, NewObject<UCameraState_LockOn>(Pipeline));
+		return Pipeline;
+	}
+
+	/** 玩家站在原点，控制器略向下看，锁定目标在右上方静止不动 */
+	static FCameraStateInputs MakeInputs()
+	{
+		FCameraStateInputs Inputs;
+		Inputs.ControlRotation = FRotator(-15.0f, 0.0f, 0.0f);
+		Inputs.bHasController = true;
+		Inputs.SpringArmRotation = Inputs.ControlRotation;
+		Inputs.LockPoint = FVector(800.0f, 600.0f, 350.0f);
+		Inputs.bHasLockTarget = true;
+		return Inputs;
+	}
+
+	static FCameraStateOutput Step(UCameraPipeline* Pipeline, const FCameraStateInputs& Inputs)
+	{
+		return Pipeline->SimulateStep(STEP_DELTA_TIME, &Inputs);
+	}
+
+	static int32 GetNumLayers(const UCameraPipeline* Pipeline)
+	{
+		return Pipeline->NumBlendLayers;
+	}
+
+	static const FCameraBlendLayer& GetLayer(const UCameraPipeline* Pipeline, int32 Index)
+	{
+		return Pipeline->BlendLayers[Index];
+	}
+
+	static UCameraState_LockOn* GetLockOnState(const UCameraPipeline* Pipeline)
+	{
+		return Cast<UCameraState_LockOn>(Pipeline->StateInstances.FindRef(ECameraPipelineState::LockOn));
+	}
+
+	/** 打开插值平滑跟踪并指定上一步的旋转，使单步求值不会直接收敛到目标朝向 */
+	static void StartSmoothTracking(UCameraState_LockOn* LockOn, const FRotator& LastRotation)
+	{
+		LockOn->bEnableSmoothTracking = true;
+		LockOn->bUseSpringTracking = false;
+		LockOn->LastCameraRotation = LastRotation;
+		LockOn->bLastRotationInitialized = true;
+	}
+
+	static FRotator GetLastTrackingRotation(const UCameraState_LockOn* LockOn)
+	{
+		return LockOn->LastCameraRotation;
+	}
+
+	static void SetLastTrackingRotation(UCameraState_LockOn* LockOn, const FRotator& Rotation)
+	{
+		LockOn->LastCameraRotation = Rotation;
+	}
+
+	/** 模拟蓝图重写了CalculateState的状态 */
+	static void SetGameThreadOnly(UCameraStateBase* State)
+	{
+		State->bCalculateStateInScript = true;
+	}
+
+	/** 两个旋转之间的夹角（度）；球面插值沿大圆匀速移动，用夹角衡量连续性 */
+	static float RotationAngle(const FRotator& A, const FRotator& B)
+	{
+		return FMath::RadiansToDegrees(A.Quaternion().AngularDistance(B.Quaternion()));
+	}
+
+	static bool OutputsMatch(const FCameraStateOutput& A, const FCameraStateOutput& B, float Tolerance)
+	{
+		return A.TargetPosition.Equals(B.TargetPosition, Tolerance)
+			&& RotationAngle(A.TargetRotation, B.TargetRotation) <= Tolerance
+			&& FMath::IsNearlyEqual(A.ArmLength, B.ArmLength, Tolerance)
+			&& FMath::IsNearlyEqual(A.FieldOfView, B.FieldOfView, Tolerance);
+	}
+};
+
+/**
+ * LockOn→Free→LockOn 快速来回切换：输出逐步连续，层数不超过容量，栈满时合并，
+ * 最后一次切换完全混入后折叠回一层
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraBlendStackToggleTest, "Soul.Camera.BlendStackToggle",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCameraBlendStackToggleTest::RunTest(const FString& Parameters)
+{
+	const float DeltaTime = FCameraPipelineTestAccess::STEP_DELTA_TIME;
+	const FCameraStateInputs Inputs = FCameraPipelineTestAccess::MakeInputs();
+	UCameraPipeline* Pipeline = FCameraPipelineTestAccess::CreatePipeline();
+
+	// 两个状态各自的稳定输出，两者之差就是混合的量程
+	const FCameraStateOutput FreeOutput = NewObject<UCameraState_Free>(GetTransientPackage())->EvaluateState(Inputs, DeltaTime);
+	const FCameraStateOutput LockOnOutput = NewObject<UCameraState_LockOn>(GetTransientPackage())->EvaluateState(Inputs, DeltaTime);
+	const float RotationRange = FCameraPipelineTestAccess::RotationAngle(FreeOutput.TargetRotation, LockOnOutput.TargetRotation);
+	const float ArmLengthRange = FMath::Abs(FreeOutput.ArmLength - LockOnOutput.ArmLength);
+	TestTrue(TEXT("Free and lock-on outputs differ"), RotationRange > 10.0f && ArmLengthRange > 10.0f);
+
+	// 每层权重每步最多变化 缓动最大斜率(指数为2时是2) * 步长 / 混合时间，至多 MaxBlendLayers - 1 层同时在变
+	const float MaxWeightStep = (UCameraPipeline::MaxBlendLayers - 1) * 2.0f * DeltaTime / FCameraPipelineTestAccess::BLEND_TIME * 1.25f;
+
+	float MaxRotationStep = 0.0f;
+	float MaxArmLengthStep = 0.0f;
+	int32 MaxLayers = 0;
+	bool bSawDuplicate = false;
+	FCameraStateOutput LastOutput = FCameraPipelineTestAccess::Step(Pipeline, Inputs);
+
+	auto Advance = [&](int32 NumSteps)
+	{
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			const FCameraStateOutput Output = FCameraPipelineTestAccess::Step(Pipeline, Inputs);
+			MaxRotationStep = FMath::Max(MaxRotationStep, FCameraPipelineTestAccess::RotationAngle(Output.TargetRotation, LastOutput.TargetRotation));
+			MaxArmLengthStep = FMath::Max(MaxArmLengthStep, FMath::Abs(Output.ArmLength - LastOutput.ArmLength));
+			LastOutput = Output;
+
+			const int32 NumLayers = FCameraPipelineTestAccess::GetNumLayers(Pipeline);
+			MaxLayers = FMath::Max(MaxLayers, NumLayers);
+
+			// 同一状态出现多次时各层共用同一份求值结果
+			for (int32 i = 1; i < NumLayers; ++i)
+			{
+				const FCameraBlendLayer& Layer = FCameraPipelineTestAccess::GetLayer(Pipeline, i);
+				for (int32 j = 0; j < i; ++j)
+				{
+					const FCameraBlendLayer& Earlier = FCameraPipelineTestAccess::GetLayer(Pipeline, j);
+					if (!Layer.bFrozen && !Earlier.bFrozen && Layer.State == Earlier.State)
+					{
+						bSawDuplicate = true;
+						TestTrue(TEXT("Duplicate layers share one evaluation"), FCameraPipelineTestAccess::OutputsMatch(Layer.Output, Earlier.Output, KINDA_SMALL_NUMBER));
+					}
+				}
+			}
+		}
+	};
+
+	Advance(10);
+	TestEqual(TEXT("Settled free camera has one layer"), FCameraPipelineTestAccess::GetNumLayers(Pipeline), 1);
+
+	// 每隔几步打断一次，过渡远未完成，最后停在锁定
+	const ECameraPipelineState Toggles[] =
+	{
+		ECameraPipelineState::LockOn, ECameraPipelineState::Free, ECameraPipelineState::LockOn, ECameraPipelineState::Free,
+		ECameraPipelineState::LockOn, ECameraPipelineState::Free, ECameraPipelineState::LockOn,
+	};
+	const int32 StepsBetweenToggles = 4;
+	bool bMerged = false;
+
+	for (const ECameraPipelineState Toggle : Toggles)
+	{
+		const bool bWasFull = FCameraPipelineTestAccess::GetNumLayers(Pipeline) == UCameraPipeline::MaxBlendLayers;
+		TestTrue(TEXT("State switch accepted"), Pipeline->SetCameraState(Toggle));
+
+		const int32 NumLayers = FCameraPipelineTestAccess::GetNumLayers(Pipeline);
+		MaxLayers = FMath::Max(MaxLayers, NumLayers);
+
+		// 栈满时最底下两层合并为冻结层，层数保持在容量
+		if (bWasFull)
+		{
+			const FCameraBlendLayer& Bottom = FCameraPipelineTestAccess::GetLayer(Pipeline, 0);
+			TestEqual(TEXT("Full stack stays at capacity"), NumLayers, UCameraPipeline::MaxBlendLayers);
+			TestTrue(TEXT("Bottom layers merged into a frozen layer"), Bottom.bFrozen && Bottom.State == ECameraPipelineState::None);
+			bMerged = true;
+		}
+
+		Advance(StepsBetweenToggles);
+	}
+
+	TestTrue(TEXT("Rapid toggles filled the stack and merged"), bMerged);
+	TestTrue(TEXT("Rapid toggles stacked the same state twice"), bSawDuplicate);
+	TestTrue(FString::Printf(TEXT("Layer count %d <= %d"), MaxLayers, UCameraPipeline::MaxBlendLayers),
+		MaxLayers <= UCameraPipeline::MaxBlendLayers);
+
+	// 最后一次切换完全混入后只剩锁定一层
+	Advance(FMath::CeilToInt(FCameraPipelineTestAccess::BLEND_TIME / DeltaTime) + 2);
+	TestEqual(TEXT("Stack collapses back to one layer"), FCameraPipelineTestAccess::GetNumLayers(Pipeline), 1);
+	TestTrue(TEXT("Remaining layer is lock-on"), FCameraPipelineTestAccess::GetLayer(Pipeline, 0).State == ECameraPipelineState::LockOn);
+	TestTrue(TEXT("Collapsed output is the lock-on output"), FCameraPipelineTestAccess::OutputsMatch(LastOutput, LockOnOutput, 0.01f));
+
+	const float RotationBound = RotationRange * MaxWeightStep;
+	const float ArmLengthBound = ArmLengthRange * MaxWeightStep;
+	TestTrue(FString::Printf(TEXT("Rotation step %.4f <= %.4f deg"), MaxRotationStep, RotationBound), MaxRotationStep <= RotationBound);
+	TestTrue(FString::Printf(TEXT("Arm length step %.4f <= %.4f"), MaxArmLengthStep, ArmLengthBound), MaxArmLengthStep <= ArmLengthBound);
+
+	return true;
+}
+
+/**
+ * 各层的求值方式：栈中重复出现的状态每步只求值一次；
+ * 不能在工作线程求值的状态退出后冻结在最近一次输出，不再求值
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraBlendStackEvaluationTest, "Soul.Camera.BlendStackLayerEvaluation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCameraBlendStackEvaluationTest::RunTest(const FString& Parameters)
+{
+	const float DeltaTime = FCameraPipelineTestAccess::STEP_DELTA_TIME;
+	const FCameraStateInputs Inputs = FCameraPipelineTestAccess::MakeInputs();
+
+	// ==================== 重复状态只求值一次 ====================
+	{
+		UCameraPipeline* Pipeline = FCameraPipelineTestAccess::CreatePipeline();
+		FCameraPipelineTestAccess::Step(Pipeline, Inputs);
+
+		// 栈：Free, LockOn, Free, LockOn
+		for (const ECameraPipelineState Toggle : { ECameraPipelineState::LockOn, ECameraPipelineState::Free, ECameraPipelineState::LockOn })
+		{
+			Pipeline->SetCameraState(Toggle);
+			FCameraPipelineTestAccess::Step(Pipeline, Inputs);
+			FCameraPipelineTestAccess::Step(Pipeline, Inputs);
+		}
+		TestEqual(TEXT("Stack holds four layers"), FCameraPipelineTestAccess::GetNumLayers(Pipeline), 4);
+
+		// 平滑跟踪有状态，多求值一次就会多前进一步，与只求值一次的参考实例比较
+		UCameraState_LockOn* LockOn = FCameraPipelineTestAccess::GetLockOnState(Pipeline);
+		UCameraState_LockOn* Reference = NewObject<UCameraState_LockOn>(GetTransientPackage());
+		FCameraPipelineTestAccess::StartSmoothTracking(LockOn, FRotator::ZeroRotator);
+		FCameraPipelineTestAccess::StartSmoothTracking(Reference, FRotator::ZeroRotator);
+
+		const FRotator Once = Reference->EvaluateState(Inputs, DeltaTime).TargetRotation;
+		const FRotator Twice = Reference->EvaluateState(Inputs, DeltaTime).TargetRotation;
+		TestTrue(TEXT("A second evaluation would move the tracking rotation"), FCameraPipelineTestAccess::RotationAngle(Once, Twice) > 0.1f);
+
+		FCameraPipelineTestAccess::Step(Pipeline, Inputs);
+		const FRotator Tracked = FCameraPipelineTestAccess::GetLastTrackingRotation(LockOn);
+		TestTrue(FString::Printf(TEXT("Lock-on evaluated once per step (%.4f deg off)"), FCameraPipelineTestAccess::RotationAngle(Tracked, Once)),
+			FCameraPipelineTestAccess::RotationAngle(Tracked, Once) <= 0.001f);
+	}
+
+	// ==================== 不能在工作线程求值的层退出后冻结 ====================
+	{
+		UCameraPipeline* Pipeline = FCameraPipelineTestAccess::CreatePipeline();
+		FCameraPipelineTestAccess::Step(Pipeline, Inputs);
+		Pipeline->SetCameraState(ECameraPipelineState::LockOn);
+		for (int32 Step = 0; Step < 3; ++Step)
+		{
+			FCameraPipelineTestAccess::Step(Pipeline, Inputs);
+		}
+
+		UCameraState_LockOn* LockOn = FCameraPipelineTestAccess::GetLockOnState(Pipeline);
+		FCameraPipelineTestAccess::SetGameThreadOnly(LockOn);
+		const FCameraStateOutput LockOnLayerOutput = FCameraPipelineTestAccess::GetLayer(Pipeline, 1).Output;
+
+		// 栈：Free, LockOn, Free；锁定层不再是当前状态
+		Pipeline->SetCameraState(ECameraPipelineState::Free);
+		const FRotator Sentinel(1.0f, 2.0f, 0.0f);
+		FCameraPipelineTestAccess::SetLastTrackingRotation(LockOn, Sentinel);
+
+		for (int32 Step = 0; Step < 3; ++Step)
+		{
+			FCameraPipelineTestAccess::Step(Pipeline, Inputs);
+		}
+
+		const FCameraBlendLayer& OutgoingLayer = FCameraPipelineTestAccess::GetLayer(Pipeline, 1);
+		TestTrue(TEXT("Outgoing game-thread-only layer is frozen"), OutgoingLayer.bFrozen && OutgoingLayer.State == ECameraPipelineState::None);
+		TestTrue(TEXT("Frozen layer keeps its last output"), FCameraPipelineTestAccess::OutputsMatch(OutgoingLayer.Output, LockOnLayerOutput, KINDA_SMALL_NUMBER));
+		TestTrue(TEXT("Frozen state is not evaluated"), FCameraPipelineTestAccess::GetLastTrackingRotation(LockOn).Equals(Sentinel));
+
+		// 冻结层照常参与混合，新层完全混入后折叠掉
+		for (int32 Step = 0; Step < FMath::CeilToInt(FCameraPipelineTestAccess::BLEND_TIME / DeltaTime) + 2; ++Step)
+		{
+			FCameraPipelineTestAccess::Step(Pipeline, Inputs);
+		}
+		TestEqual(TEXT("Stack collapses back to one layer"), FCameraPipelineTestAccess::GetNumLayers(Pipeline), 1);
+		TestTrue(TEXT("Remaining layer is free"), FCameraPipelineTestAccess::GetLayer(Pipeline, 0).State == ECameraPipelineState::Free);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "CameraStateBase.h"
+#include "CameraFixedStep.h"
+#include "CameraSpring.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "CameraPipeline.generated.h"
 
 // Forward declarations
@@ -12,6 +15,7 @@ class AMyCharacter;
 class USpringArmComponent;
 class UCameraComponent;
 class UCameraStateBase;
+class UCameraPipeline;
 
 /**
  * 相机管线状态枚举
@@ -74,6 +78,72 @@ struct SOUL_API FCameraBlendInfo
 	}
 };
 
+/**
+ * 混合栈中的一层
+ * 栈底是最早的状态，栈顶是当前状态；每层以自己的权重覆盖下面所有层的混合结果
+ * 权重大于0的层每步都会重新求值，打断过渡时从各状态的实时输出继续混合
+ */
+struct FCameraBlendLayer
+{
+	/** 该层对应的状态（冻结层为None） */
+	ECameraPipelineState State = ECameraPipelineState::None;
+
+	/** 冻结层：栈满时由最底下两层合并而成，输出不再更新 */
+	bool bFrozen = false;
+
+	/** 混合计时与参数（栈底层不使用） */
+	float BlendTimer = 0.0f;
+	float BlendDuration = 0.0f;
+	float BlendExponent = 2.0f;
+
+	/** 该层最近一步的输出 */
+	FCameraStateOutput Output;
+
+	/** 覆盖下层的权重（已应用缓动曲线） */
+	float GetWeight() const
+	{
+		if (BlendDuration <= 0.0f)
+		{
+			return 1.0f;
+		}
+
+		const float Alpha = FMath::Clamp(BlendTimer / BlendDuration, 0.0f, 1.0f);
+		return FMath::InterpEaseInOut(0.0f, 1.0f, Alpha, BlendExponent);
+	}
+
+	/** 是否已完全混入 */
+	bool IsFullyBlended() const
+	{
+		return BlendTimer >= BlendDuration;
+	}
+};
+
+/**
+ * 相机状态求值Tick
+ * 在TG_PostPhysics采集输入快照并把状态求值与混合派发到工作线程，
+ * 管线主Tick（TG_PostUpdateWork）汇合结果后再做后处理与应用
+ */
+USTRUCT()
+struct FCameraPipelineEvaluateTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	/** 所属管线 */
+	UCameraPipeline* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FCameraPipelineEvaluateTickFunction> : public TStructOpsTypeTraitsBase2<FCameraPipelineEvaluateTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
 /**
  * 相机管线组件
  * 负责管理不同相机状态，处理状态切换和混合
@@ -90,9 +160,28 @@ public:
 	/** 组件开始时调用 */
 	virtual void BeginPlay() override;
 
+	/** 组件结束时调用 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** 每帧更新 */
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	/** 注册/注销求值Tick */
+	virtual void RegisterComponentTickFunctions(bool bRegister) override;
+
+	/**
+	 * 采集输入快照并把状态求值派发到工作线程
+	 * 由求值Tick调用；未启用工作线程求值或当前状态不支持时不做任何事，主Tick同步求值
+	 * @param DeltaTime - 帧时间间隔
+	 */
+	void BeginStateEvaluation(float DeltaTime);
+
+	/**
+	 * 等待工作线程上的状态求值完成
+	 * 游戏线程修改状态、混合参数，或读取状态实例前必须调用
+	 */
+	void WaitForStateEvaluation() const;
+
 	/**
 	 * 设置相机状态
 	 * @param NewState - 新的相机状态
@@ -136,7 +225,17 @@ public:
 	 * @return 是否正在混合
 	 */
 	UFUNCTION(BlueprintPure, Category = "Camera Pipeline")
-	bool IsBlending() const { return bIsBlending; }
+	bool IsBlending() const { return PublishedNumBlendLayers > 1; }
+
+	/**
+	 * 获取混合栈当前层数（取最近一次汇合时发布的值，不会读到工作线程正在写的数据）
+	 * @return 参与混合的层数（不混合时为1）
+	 */
+	UFUNCTION(BlueprintPure, Category = "Camera Pipeline")
+	int32 GetNumBlendLayers() const { return PublishedNumBlendLayers; }
+
+	/** 混合栈容量，打断过渡超出容量时合并最底下两层 */
+	static constexpr int32 MaxBlendLayers = 4;
 
 protected:
 	/**
@@ -166,6 +265,41 @@ protected:
 	 */
 	FCameraStateOutput BlendStates(const FCameraStateOutput& From, const FCameraStateOutput& To, float Alpha) const;
 
+	/**
+	 * 清空混合栈，只保留一个状态
+	 * @param State - 栈底状态
+	 */
+	void ResetBlendStack(ECameraPipelineState State);
+
+	/**
+	 * 在栈顶压入一个混入中的状态，栈满时先合并最底下两层
+	 * @param State - 新状态
+	 * @param BlendInfo - 混合参数
+	 */
+	void PushBlendLayer(ECameraPipelineState State, const FCameraBlendInfo& BlendInfo);
+
+	/**
+	 * 按权重从栈底到栈顶合成输出，并移除被完全覆盖的层
+	 * @param StepDeltaTime - 本步时长，用于推进各层混合计时
+	 * @return 混合后的状态输出
+	 */
+	FCameraStateOutput ComposeBlendStack(float StepDeltaTime);
+
+	/**
+	 * 推进一步状态计算与状态混合
+	 * @param StepDeltaTime - 本步时长（固定步长模式下为子步时长）
+	 * @return 混合后的状态输出（未经后处理）
+	 */
+	FCameraStateOutput SimulateStep(float StepDeltaTime, const FCameraStateInputs* Inputs);
+
+	/**
+	 * 计算本帧的状态输出（固定步长时包含子步与插值），不含后处理
+	 * @param DeltaTime - 帧时间间隔
+	 * @param Inputs - 输入快照；为空时在游戏线程直接调用CalculateState
+	 * @return 本帧的状态输出
+	 */
+	FCameraStateOutput EvaluatePipeline(float DeltaTime, const FCameraStateInputs* Inputs);
+
 	/**
 	 * 应用后处理效果到相机输出
 	 * 包括碰撞检测、防穿墙等
@@ -221,6 +355,52 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Pipeline|Post Processing", meta = (ClampMin = "10.0", ClampMax = "500.0"))
 	float MinimumArmLength = 50.0f;
 
+	// ==================== 固定步长配置 ====================
+
+	/**
+	 * 是否以固定步长计算状态与混合
+	 * 状态平滑按固定频率积分，结果与帧率无关；呈现时在两步之间插值
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Pipeline|Fixed Step")
+	bool bUseFixedStepSimulation = false;
+
+	/**
+	 * 固定步频率（Hz）
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Pipeline|Fixed Step", meta = (ClampMin = "30.0", ClampMax = "480.0", EditCondition = "bUseFixedStepSimulation"))
+	float FixedStepRate = 120.0f;
+
+	/**
+	 * 单帧最多子步数
+	 * 卡顿时超出部分丢弃
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Pipeline|Fixed Step", meta = (ClampMin = "1", ClampMax = "32", EditCondition = "bUseFixedStepSimulation"))
+	int32 MaxFixedSubSteps = 8;
+
+	// ==================== 弹簧配置 ====================
+
+	/**
+	 * 臂长是否用临界阻尼弹簧跟随状态输出
+	 * 状态切换、锁定进出时臂长平滑过渡而不是跟随混合曲线直接变化
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Pipeline|Spring")
+	bool bUseArmLengthSpring = false;
+
+	/**
+	 * 臂长弹簧平滑时间（秒）
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Pipeline|Spring", meta = (ClampMin = "0.02", ClampMax = "2.0", EditCondition = "bUseArmLengthSpring"))
+	float ArmLengthSpringSmoothTime = 0.3f;
+
+	// ==================== 线程配置 ====================
+
+	/**
+	 * 是否在工作线程计算状态与混合
+	 * 输入在TG_PostPhysics采集快照，结果在主Tick应用前汇合；蓝图状态始终在游戏线程求值
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Pipeline|Threading")
+	bool bEvaluateOnWorkerThread = false;
+
 	// ==================== 运行时状态 ====================
 	
 	/**
@@ -256,13 +436,6 @@ protected:
 	UPROPERTY(Transient)
 	FCameraStateOutput CurrentStateOutput;
 
-	/**
-	 * 上一个状态的输出
-	 * 用于混合计算
-	 */
-	UPROPERTY(Transient)
-	FCameraStateOutput PreviousStateOutput;
-
 	// ==================== 组件缓存 ====================
 	
 	/**
@@ -286,30 +459,66 @@ protected:
 	// ==================== 混合相关 ====================
 	
 	/**
-	 * 是否正在进行状态混合
+	 * 混合栈（固定容量，不分配堆内存）
+	 * [0]为栈底，[NumBlendLayers - 1]为当前状态
 	 */
-	UPROPERTY(Transient)
-	bool bIsBlending = false;
+	FCameraBlendLayer BlendLayers[MaxBlendLayers];
+
+	/** 混合栈当前层数 */
+	int32 NumBlendLayers = 0;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/** 自动化测试直接驱动SimulateStep并检查混合栈（无 Owner 时无法走 TickComponent） */
+	friend struct FCameraPipelineTestAccess;
+#endif
+
+	// ==================== 固定步长 ====================
+
+	/** 固定步长时钟 */
+	FCameraFixedStepClock FixedStepClock;
 
 	/**
-	 * 状态混合计时器
-	 * 记录当前混合已进行的时间
+	 * 上一步、当前步的输出（未经后处理）
+	 * 呈现时按时钟剩余时间在两者之间插值
 	 */
 	UPROPERTY(Transient)
-	float StateBlendTimer = 0.0f;
+	FCameraStateOutput PreviousStepOutput;
 
-	/**
-	 * 当前混合持续时间
-	 * 从BlendSettings或DefaultBlendInfo获取
-	 */
 	UPROPERTY(Transient)
-	float StateBlendDuration = 0.5f;
+	FCameraStateOutput CurrentStepOutput;
+
+	/** 步输出是否已初始化 */
+	bool bHasStepOutput = false;
+
+	// ==================== 弹簧 ====================
+
+	/** 臂长弹簧速度与当前值 */
+	FCameraSpringFloat ArmLengthSpring;
+	float SpringArmLength = 0.0f;
+
+	/** 臂长弹簧是否已初始化 */
+	bool bHasSpringArmLength = false;
+
+	// ==================== 工作线程求值 ====================
+
+	/** 求值Tick（TG_PostPhysics） */
+	FCameraPipelineEvaluateTickFunction EvaluateTickFunction;
+
+	/** 工作线程求值任务（const 读取接口也需要汇合） */
+	mutable FGraphEventRef EvaluationTask;
+
+	/** 本帧的输入快照与求值结果 */
+	FCameraStateInputs EvaluationInputs;
+	FCameraStateOutput EvaluatedOutput;
+
+	/** 本帧是否有尚未应用的工作线程求值结果 */
+	bool bHasEvaluatedOutput = false;
 
 	/**
-	 * 当前混合曲线指数
+	 * 游戏线程可见的混合栈层数
+	 * 混合栈在派发到汇合之间归工作线程所有，只在汇合后和状态切换后发布
 	 */
-	UPROPERTY(Transient)
-	float CurrentBlendExponent = 2.0f;
+	int32 PublishedNumBlendLayers = 0;
 
 	// ==================== 调试 ====================
 	
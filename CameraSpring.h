@@ -0,0 +1,128 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 临界阻尼弹簧（解析解）
+ * FInterpTo/RInterpTo 是一阶滞后：起步突变、需要很高的插值速度，多段叠加时容易过冲
+ * 弹簧额外保存速度，起步和停止都平滑，且临界阻尼不会超调
+ * 每步按闭式解精确积分，任意步长都稳定，目标不变时结果与步长划分无关
+ *
+ * SmoothTime 约等于追上目标所需的时间，角频率 Omega = 2 / SmoothTime
+ */
+namespace CameraSpring
+{
+	FORCEINLINE float GetAngularFrequency(float SmoothTime)
+	{
+		return 2.0f / FMath::Max(SmoothTime, KINDA_SMALL_NUMBER);
+	}
+
+	/**
+	 * 推进一步，Value 与 Velocity 原地更新
+	 * x(t) = Target + (C1 + C2 * t) * e^(-Omega * t)，C1 = x0 - Target，C2 = v0 + Omega * C1
+	 */
+	template <typename T>
+	FORCEINLINE void Step(T& Value, T& Velocity, const T& Target, float SmoothTime, float DeltaTime)
+	{
+		if (DeltaTime <= 0.0f)
+		{
+			return;
+		}
+
+		const float Omega = GetAngularFrequency(SmoothTime);
+		const float Decay = FMath::Exp(-Omega * DeltaTime);
+		const T Offset = Value - Target;
+		const T Impulse = (Velocity + Offset * Omega) * DeltaTime;
+
+		Value = Target + (Offset + Impulse) * Decay;
+		Velocity = (Velocity - Impulse * Omega) * Decay;
+	}
+}
+
+/**
+ * 标量弹簧（臂长、视野等）
+ */
+struct FCameraSpringFloat
+{
+	float Velocity = 0.0f;
+
+	float Update(float Current, float Target, float SmoothTime, float DeltaTime)
+	{
+		CameraSpring::Step(Current, Velocity, Target, SmoothTime, DeltaTime);
+		return Current;
+	}
+
+	void Reset()
+	{
+		Velocity = 0.0f;
+	}
+};
+
+/**
+ * 向量弹簧（Socket Offset、目标位置等）
+ */
+struct FCameraSpringVector
+{
+	FVector Velocity = FVector::ZeroVector;
+
+	FVector Update(FVector Current, const FVector& Target, float SmoothTime, float DeltaTime)
+	{
+		CameraSpring::Step(Current, Velocity, Target, SmoothTime, DeltaTime);
+		return Current;
+	}
+
+	void Reset()
+	{
+		Velocity = FVector::ZeroVector;
+	}
+};
+
+/**
+ * 欧拉角弹簧（控制器旋转）
+ * 与 RInterpTo 一样逐分量沿最短角度差收敛，不会引入滚转
+ */
+struct FCameraSpringRotator
+{
+	/** 角速度（Pitch/Yaw/Roll，度/秒） */
+	FVector Velocity = FVector::ZeroVector;
+
+	FRotator Update(const FRotator& Current, const FRotator& Target, float SmoothTime, float DeltaTime)
+	{
+		const FRotator Delta = (Current - Target).GetNormalized();
+		FVector Offset(Delta.Pitch, Delta.Yaw, Delta.Roll);
+		CameraSpring::Step(Offset, Velocity, FVector::ZeroVector, SmoothTime, DeltaTime);
+		return (Target + FRotator(Offset.X, Offset.Y, Offset.Z)).GetNormalized();
+	}
+
+	void Reset()
+	{
+		Velocity = FVector::ZeroVector;
+	}
+};
+
+/**
+ * 四元数弹簧（弹簧臂世界旋转）
+ * 误差取相对目标的旋转向量，沿最短弧收敛
+ */
+struct FCameraSpringQuat
+{
+	/** 角速度（旋转向量，弧度/秒） */
+	FVector AngularVelocity = FVector::ZeroVector;
+
+	FQuat Update(const FQuat& Current, const FQuat& Target, float SmoothTime, float DeltaTime)
+	{
+		FQuat Error = Current * Target.Inverse();
+		Error.EnforceShortestArcWith(FQuat::Identity);
+
+		FVector Offset = Error.ToRotationVector();
+		CameraSpring::Step(Offset, AngularVelocity, FVector::ZeroVector, SmoothTime, DeltaTime);
+		return (FQuat::MakeFromRotationVector(Offset) * Target).GetNormalized();
+	}
+
+	void Reset()
+	{
+		AngularVelocity = FVector::ZeroVector;
+	}
+};
@@ -4,6 +4,44 @@
 #include "MyCharacter.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Camera/CameraComponent.h"
+#include "GameFramework/Controller.h"
+
+FCameraStateInputs FCameraStateInputs::Capture(AMyCharacter* OwnerCharacter, USpringArmComponent* SpringArm, UCameraComponent* Camera)
+{
+	FCameraStateInputs Inputs;
+
+	if (OwnerCharacter)
+	{
+		Inputs.PawnLocation = OwnerCharacter->GetActorLocation();
+		Inputs.PawnRotation = OwnerCharacter->GetActorRotation();
+
+		if (AController* Controller = OwnerCharacter->GetController())
+		{
+			Inputs.ControlRotation = Controller->GetControlRotation();
+			Inputs.bHasController = true;
+		}
+
+		if (AActor* LockOnTarget = OwnerCharacter->GetLockOnTarget())
+		{
+			Inputs.LockPoint = OwnerCharacter->GetOptimalLockPosition(LockOnTarget);
+			Inputs.bHasLockTarget = true;
+		}
+	}
+
+	if (SpringArm)
+	{
+		Inputs.SpringArmLocation = SpringArm->GetComponentLocation();
+		Inputs.SpringArmRotation = SpringArm->GetComponentRotation();
+		Inputs.SpringArmLength = SpringArm->TargetArmLength;
+	}
+
+	if (Camera)
+	{
+		Inputs.FieldOfView = Camera->FieldOfView;
+	}
+
+	return Inputs;
+}
 
 UCameraStateBase::UCameraStateBase()
 {
@@ -16,19 +54,37 @@ UCameraStateBase::UCameraStateBase()
 FCameraStateOutput UCameraStateBase::CalculateState_Implementation(float DeltaTime, AMyCharacter* OwnerCharacter, USpringArmComponent* SpringArm, UCameraComponent* Camera)
 {
 	// 基类默认实现：返回当前相机的状态
-	FCameraStateOutput Output;
-
 	if (SpringArm && Camera)
 	{
-		Output.TargetPosition = SpringArm->GetComponentLocation();
-		Output.TargetRotation = SpringArm->GetComponentRotation();
-		Output.ArmLength = SpringArm->TargetArmLength;
-		Output.FieldOfView = Camera->FieldOfView;
+		return EvaluateState(FCameraStateInputs::Capture(OwnerCharacter, SpringArm, Camera), DeltaTime);
 	}
 
+	return FCameraStateOutput();
+}
+
+FCameraStateOutput UCameraStateBase::EvaluateState(const FCameraStateInputs& Inputs, float DeltaTime)
+{
+	// 基类默认实现：保持弹簧臂与相机的当前状态
+	FCameraStateOutput Output;
+	Output.TargetPosition = Inputs.SpringArmLocation;
+	Output.TargetRotation = Inputs.SpringArmRotation;
+	Output.ArmLength = Inputs.SpringArmLength;
+	Output.FieldOfView = Inputs.FieldOfView;
 	return Output;
 }
 
+void UCameraStateBase::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	bCalculateStateInScript = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UCameraStateBase, CalculateState));
+}
+
+bool UCameraStateBase::CanEvaluateOnWorkerThread() const
+{
+	return !bCalculateStateInScript;
+}
+
 void UCameraStateBase::OnEnterState_Implementation(AMyCharacter* OwnerCharacter, UCameraStateBase* PreviousState)
 {
 	// 基类默认实现：记录日志
@@ -77,6 +77,39 @@ struct SOUL_API FCameraStateOutput
 	}
 };
 
+/**
+ * 相机状态求值输入快照
+ * 在游戏线程采集，状态求值只读取这里的数据、不访问任何UObject，因此可以放到工作线程执行
+ */
+struct SOUL_API FCameraStateInputs
+{
+	/** 角色位置与朝向 */
+	FVector PawnLocation = FVector::ZeroVector;
+	FRotator PawnRotation = FRotator::ZeroRotator;
+
+	/** 控制器旋转（没有控制器时bHasController为false） */
+	FRotator ControlRotation = FRotator::ZeroRotator;
+	bool bHasController = false;
+
+	/** 弹簧臂与相机的当前状态 */
+	FVector SpringArmLocation = FVector::ZeroVector;
+	FRotator SpringArmRotation = FRotator::ZeroRotator;
+	float SpringArmLength = 300.0f;
+	float FieldOfView = 90.0f;
+
+	/** 锁定目标的锁定点（没有锁定目标时bHasLockTarget为false） */
+	FVector LockPoint = FVector::ZeroVector;
+	bool bHasLockTarget = false;
+
+	/**
+	 * 在游戏线程采集快照
+	 * @param OwnerCharacter - 拥有相机的角色
+	 * @param SpringArm - 弹簧臂组件
+	 * @param Camera - 相机组件
+	 */
+	static FCameraStateInputs Capture(AMyCharacter* OwnerCharacter, USpringArmComponent* SpringArm, UCameraComponent* Camera);
+};
+
 /**
  * 相机状态基类
  * 所有相机状态（自由、锁定、处决、死亡等）都继承自此类
@@ -90,6 +123,9 @@ public:
 	/** 构造函数 */
 	UCameraStateBase();
 
+	/** 缓存该类是否在蓝图中重写了CalculateState */
+	virtual void PostInitProperties() override;
+
 	/** 
 	 * 计算相机状态输出
 	 * @param DeltaTime - 帧时间间隔
@@ -102,6 +138,28 @@ public:
 	FCameraStateOutput CalculateState(float DeltaTime, AMyCharacter* OwnerCharacter, USpringArmComponent* SpringArm, UCameraComponent* Camera);
 	virtual FCameraStateOutput CalculateState_Implementation(float DeltaTime, AMyCharacter* OwnerCharacter, USpringArmComponent* SpringArm, UCameraComponent* Camera);
 
+	/**
+	 * 基于输入快照计算相机状态输出（纯数学，可在工作线程调用）
+	 * C++状态的CalculateState采集快照后转发到这里，两条路径结果一致
+	 * @param Inputs - 游戏线程采集的输入快照
+	 * @param DeltaTime - 帧时间间隔
+	 * @return 相机状态输出数据
+	 */
+	virtual FCameraStateOutput EvaluateState(const FCameraStateInputs& Inputs, float DeltaTime);
+
+	/**
+	 * 工作线程求值前在游戏线程执行的部分（如距离自动解锁）
+	 * 可能切换相机状态
+	 * @param OwnerCharacter - 拥有此相机状态的角色
+	 */
+	virtual void PreEvaluateState(AMyCharacter* OwnerCharacter) {}
+
+	/**
+	 * 是否可以在工作线程求值
+	 * 蓝图重写了CalculateState的状态只能在游戏线程求值
+	 */
+	bool CanEvaluateOnWorkerThread() const;
+
 	/**
 	 * 进入状态时调用
 	 * @param OwnerCharacter - 拥有此相机状态的角色
@@ -185,4 +243,13 @@ protected:
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera State")
 	FString StateName = TEXT("BaseState");
+
+private:
+	/** 蓝图是否重写了CalculateState（创建时确定，求值时不再逐层查找函数） */
+	bool bCalculateStateInScript = false;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/** 自动化测试模拟只能在游戏线程求值的状态 */
+	friend struct FCameraPipelineTestAccess;
+#endif
 };
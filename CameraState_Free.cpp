@@ -33,29 +33,30 @@ FCameraStateOutput UCameraState_Free::CalculateState_Implementation(float DeltaT
 		return Output;
 	}
 
+	return EvaluateState(FCameraStateInputs::Capture(OwnerCharacter, SpringArm, Camera), DeltaTime);
+}
+
+FCameraStateOutput UCameraState_Free::EvaluateState(const FCameraStateInputs& Inputs, float DeltaTime)
+{
+	FCameraStateOutput Output;
+
 	// 获取当前SpringArm的位置和旋转
-	FVector CurrentArmLocation = SpringArm->GetComponentLocation();
-	FRotator CurrentArmRotation = SpringArm->GetComponentRotation();
+	FVector CurrentArmLocation = Inputs.SpringArmLocation;
+	FRotator CurrentArmRotation = Inputs.SpringArmRotation;
 
 	// 如果启用平滑旋转，使用插值
 	FRotator TargetRotation = CurrentArmRotation;
-	if (bEnableSmoothRotation)
+	if (Inputs.bHasController)
 	{
-		// 获取控制器旋转作为目标
-		AController* Controller = OwnerCharacter->GetController();
-		if (Controller)
+		if (bEnableSmoothRotation)
 		{
-			FRotator ControlRotation = Controller->GetControlRotation();
-			TargetRotation = UKismetMathLibrary::RInterpTo(CurrentArmRotation, ControlRotation, DeltaTime, SmoothRotationSpeed);
+			// 以控制器旋转作为目标
+			TargetRotation = UKismetMathLibrary::RInterpTo(CurrentArmRotation, Inputs.ControlRotation, DeltaTime, SmoothRotationSpeed);
 		}
-	}
-	else
-	{
-		// 直接使用控制器旋转
-		AController* Controller = OwnerCharacter->GetController();
-		if (Controller)
+		else
 		{
-			TargetRotation = Controller->GetControlRotation();
+			// 直接使用控制器旋转
+			TargetRotation = Inputs.ControlRotation;
 		}
 	}
 
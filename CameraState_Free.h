@@ -25,6 +25,11 @@ public:
 	 */
 	virtual FCameraStateOutput CalculateState_Implementation(float DeltaTime, AMyCharacter* OwnerCharacter, USpringArmComponent* SpringArm, UCameraComponent* Camera) override;
 
+	/**
+	 * 基于输入快照计算自由相机状态（可在工作线程调用）
+	 */
+	virtual FCameraStateOutput EvaluateState(const FCameraStateInputs& Inputs, float DeltaTime) override;
+
 	/**
 	 * 进入自由相机状态
 	 */
@@ -7,6 +7,7 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "TargetDetectionComponent.h"  // ✅ 新增
 #include "Camera/CameraPipeline.h"     // ✅ 新增
+#include "PerformanceProfiler.h"
 
 UCameraState_LockOn::UCameraState_LockOn()
 {
@@ -59,8 +60,33 @@ FCameraStateOutput UCameraState_LockOn::CalculateState_Implementation(float Delt
 	}
 
 	// ==================== ✅ 距离检测自动解锁 ====================
+	if (UpdateDistanceAutoUnlock(OwnerCharacter, LockOnTarget))
+	{
+		// 返回自由相机的默认输出
+		Output.TargetPosition = SpringArm->GetComponentLocation();
+		Output.TargetRotation = SpringArm->GetComponentRotation();
+		Output.ArmLength = 400.0f;
+		Output.FieldOfView = 90.0f;
+		Output.bForceSpringArmRotation = false;
+		Output.bForceControllerRotation = false;
+		return Output;
+	}
+
+	return EvaluateState(FCameraStateInputs::Capture(OwnerCharacter, SpringArm, Camera), DeltaTime);
+}
+
+void UCameraState_LockOn::PreEvaluateState(AMyCharacter* OwnerCharacter)
+{
+	if (OwnerCharacter)
+	{
+		UpdateDistanceAutoUnlock(OwnerCharacter, OwnerCharacter->GetLockOnTarget());
+	}
+}
+
+bool UCameraState_LockOn::UpdateDistanceAutoUnlock(AMyCharacter* OwnerCharacter, AActor* LockOnTarget)
+{
 	// 只有启用距离自动解锁功能时才执行检测
-	if (bEnableDistanceAutoUnlock)
+	if (bEnableDistanceAutoUnlock && LockOnTarget)
 	{
 		float CurrentTime = OwnerCharacter->GetWorld()->GetTimeSeconds();
 		if (CurrentTime - LastDistanceCheckTime >= DistanceCheckInterval)
@@ -68,6 +94,7 @@ FCameraStateOutput UCameraState_LockOn::CalculateState_Implementation(float Delt
 			LastDistanceCheckTime = CurrentTime;
 			
 			// 获取TargetDetectionComponent进行距离检测
+			SOUL_COUNTER_INC(TEXT("CameraPipeline.ComponentLookups"));
 			UTargetDetectionComponent* DetectionComp = 
 				OwnerCharacter->FindComponentByClass<UTargetDetectionComponent>();
 			
@@ -99,14 +126,7 @@ FCameraStateOutput UCameraState_LockOn::CalculateState_Implementation(float Delt
 						UE_LOG(LogTemp, Error, TEXT("❌ LockOn Camera: CameraPipeline component not found!"));
 					}
 					
-					// 返回自由相机的默认输出
-					Output.TargetPosition = SpringArm->GetComponentLocation();
-					Output.TargetRotation = SpringArm->GetComponentRotation();
-					Output.ArmLength = 400.0f;
-					Output.FieldOfView = 90.0f;
-					Output.bForceSpringArmRotation = false;
-					Output.bForceControllerRotation = false;
-					return Output;
+					return true;
 				}
 			}
 			else
@@ -122,15 +142,31 @@ FCameraStateOutput UCameraState_LockOn::CalculateState_Implementation(float Delt
 		}
 	}
 
-	// 使用Character的GetOptimalLockPosition()获取目标锁定位置
-	FVector TargetLocation = OwnerCharacter->GetOptimalLockPosition(LockOnTarget);
+	return false;
+}
+
+FCameraStateOutput UCameraState_LockOn::EvaluateState(const FCameraStateInputs& Inputs, float DeltaTime)
+{
+	FCameraStateOutput Output;
+
+	// 没有锁定目标时，返回当前相机状态
+	if (!Inputs.bHasLockTarget)
+	{
+		Output.TargetPosition = Inputs.SpringArmLocation;
+		Output.TargetRotation = Inputs.SpringArmRotation;
+		Output.ArmLength = LockOnArmLength;
+		Output.FieldOfView = LockOnFieldOfView;
+		return Output;
+	}
+
+	// 快照中的锁定点来自Character的GetOptimalLockPosition()
+	FVector TargetLocation = Inputs.LockPoint;
 
 	// 应用目标偏移
 	TargetLocation += TargetOffset;
 
 	// 计算从角色到目标的方向
-	FVector CharacterLocation = OwnerCharacter->GetActorLocation();
-	FVector DirectionToTarget = (TargetLocation - CharacterLocation).GetSafeNormal();
+	FVector CharacterLocation = Inputs.PawnLocation;
 
 	// 计算相机应该朝向的旋转
 	FRotator LookAtRotation = UKismetMathLibrary::FindLookAtRotation(CharacterLocation, TargetLocation);
@@ -145,8 +181,16 @@ FCameraStateOutput UCameraState_LockOn::CalculateState_Implementation(float Delt
 	FRotator FinalRotation = LookAtRotation;
 	if (bEnableSmoothTracking && bLastRotationInitialized)
 	{
-		// 使用插值平滑相机旋转
-		FinalRotation = UKismetMathLibrary::RInterpTo(LastCameraRotation, LookAtRotation, DeltaTime, TrackingSpeed);
+		if (bUseSpringTracking)
+		{
+			// 临界阻尼弹簧，逐分量收敛偏航/俯仰；目标与起点滚转均为0，结果不会产生滚转
+			FinalRotation = TrackingSpring.Update(LastCameraRotation, LookAtRotation, TrackingSpringSmoothTime, DeltaTime);
+		}
+		else
+		{
+			// 使用插值平滑相机旋转
+			FinalRotation = UKismetMathLibrary::RInterpTo(LastCameraRotation, LookAtRotation, DeltaTime, TrackingSpeed);
+		}
 	}
 
 	// 更新上一帧旋转记录
@@ -154,7 +198,7 @@ FCameraStateOutput UCameraState_LockOn::CalculateState_Implementation(float Delt
 	bLastRotationInitialized = true;
 
 	// 填充输出结构
-	Output.TargetPosition = SpringArm->GetComponentLocation(); // 位置由SpringArm自动处理
+	Output.TargetPosition = Inputs.SpringArmLocation; // 位置由SpringArm自动处理
 	Output.TargetRotation = FinalRotation;
 	Output.ArmLength = LockOnArmLength;
 	Output.FieldOfView = LockOnFieldOfView;
@@ -174,6 +218,7 @@ void UCameraState_LockOn::OnEnterState_Implementation(AMyCharacter* OwnerCharact
 
 	// 重置平滑跟踪状态
 	bLastRotationInitialized = false;
+	TrackingSpring.Reset();
 
 	// ✅ 新增：重置距离检测计时器
 	LastDistanceCheckTime = 0.0f;
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Camera/CameraStateBase.h"
+#include "CameraSpring.h"
 #include "CameraState_LockOn.generated.h"
 
 /**
@@ -25,6 +26,16 @@ public:
 	 */
 	virtual FCameraStateOutput CalculateState_Implementation(float DeltaTime, AMyCharacter* OwnerCharacter, USpringArmComponent* SpringArm, UCameraComponent* Camera) override;
 
+	/**
+	 * 基于输入快照计算锁定相机朝向（可在工作线程调用）
+	 */
+	virtual FCameraStateOutput EvaluateState(const FCameraStateInputs& Inputs, float DeltaTime) override;
+
+	/**
+	 * 工作线程求值前执行距离自动解锁检测
+	 */
+	virtual void PreEvaluateState(AMyCharacter* OwnerCharacter) override;
+
 	/**
 	 * 进入锁定相机状态
 	 */
@@ -58,6 +69,14 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LockOn Camera|Configuration")
 	bool bEnableSmoothTracking = false;
 
+	/** 平滑跟踪是否使用临界阻尼弹簧（替代RInterpTo，起停平滑且不超调） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LockOn Camera|Configuration", meta = (EditCondition = "bEnableSmoothTracking"))
+	bool bUseSpringTracking = false;
+
+	/** 弹簧跟踪的平滑时间（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LockOn Camera|Configuration", meta = (ClampMin = "0.02", ClampMax = "2.0", EditCondition = "bEnableSmoothTracking && bUseSpringTracking"))
+	float TrackingSpringSmoothTime = 0.2f;
+
 	/** 相机偏移角度（可用于调整相机在目标上方/下方的角度） */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LockOn Camera|Configuration", meta = (ClampMin = "-45.0", ClampMax = "45.0"))
 	float CameraPitchOffset = 0.0f;
@@ -80,14 +99,28 @@ protected:
 	float DistanceCheckInterval = 0.2f;
 
 private:
+	/**
+	 * 距离自动解锁检测（游戏线程）
+	 * @return 是否已触发解锁并切换到自由相机
+	 */
+	bool UpdateDistanceAutoUnlock(AMyCharacter* OwnerCharacter, AActor* LockOnTarget);
+
 	/** 上一帧的相机旋转（用于平滑插值） */
 	FRotator LastCameraRotation = FRotator::ZeroRotator;
 
 	/** 是否已经初始化上一帧旋转 */
 	bool bLastRotationInitialized = false;
 
+	/** 弹簧跟踪的角速度（逐分量欧拉弹簧：目标滚转恒为0，滚转分量不会积累速度） */
+	FCameraSpringRotator TrackingSpring;
+
 	// ==================== ✅ 新增：距离检测状态 ====================
 	
 	/** 上次距离检测时间 */
 	float LastDistanceCheckTime = 0.0f;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/** 自动化测试打开平滑跟踪并检查跟踪状态 */
+	friend struct FCameraPipelineTestAccess;
+#endif
 };
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "PerformanceProfiler.h"
 #include "DebugManager.generated.h"
 
 // ǰ������
@@ -100,21 +101,6 @@ public:
 	static void SetGlobalLogLevel(EDebugLogLevel NewRequestedLogLevel);
 };
 
-/**
- * ����������ṹ��
- * �����Զ���������ִ��ʱ��
- */
-struct SOUL_API FSoulPerformanceScope
-{
-public:
-	FSoulPerformanceScope(const FString& InFunctionName);
-	~FSoulPerformanceScope();
-
-private:
-	FString FunctionName;
-	double StartTime;
-};
-
 // ==================== ���ܵ��Ժ궨�� ====================
 
 /**
@@ -167,13 +153,4 @@ private:
         UE_LOG(LogTemp, VeryVerbose, TEXT("[%s] ") Format, *ModuleName, ##__VA_ARGS__); \
     }
 
-// ���ܼ�غ궨��
-#define SOUL_PERFORMANCE_SCOPE(FunctionName) \
-	FSoulPerformanceScope PerformanceScope(FunctionName)
-
-#define SOUL_PERFORMANCE_SCOPE_CONDITIONAL(FunctionName, Condition) \
-	TOptional<FSoulPerformanceScope> PerformanceScope; \
-	if (Condition) \
-	{ \
-		PerformanceScope.Emplace(FunctionName); \
-	}
\ No newline at end of file
+// 性能监控宏（SOUL_PERFORMANCE_SCOPE 等）统一定义在 PerformanceProfiler.h
@@ -12,12 +12,25 @@
 #include "DrawDebugHelpers.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Engine/Engine.h"
+#include "GameFramework/RootMotionSource.h"
+#include "PerformanceProfiler.h"
+
+// 时间轴上速度曲线轨道的名称，曲线变化时按名称替换
+static const FName DodgeSpeedTrackName(TEXT("DodgeSpeed"));
+
+// 烘焙强度曲线的采样段数
+static constexpr int32 DODGE_CURVE_BAKE_SAMPLES = 32;
+
+// 闪避根运动源的实例名
+static const FName DodgeRootMotionName(TEXT("Dodge"));
 
 // Sets default values for this component's properties
 UDodgeComponent::UDodgeComponent()
 {
 	// Set this component to be ticked every frame
 	PrimaryComponentTick.bCanEverTick = true;
+	// 只在原生积分器驱动闪避时开启Tick
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 	
 	// ��ʼ��״̬����
 	bIsDodging = false;
@@ -29,6 +42,40 @@ UDodgeComponent::UDodgeComponent()
 	DodgeStartTime = 0.0f;
 	StaminaCost = 25.0f;
 	bEnableDebugLogs = false;
+	BakedDodgeStrengthCurve = nullptr;
+	DodgeRootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
+
+	// 路径预计算状态
+	for (int32 i = 0; i < NUM_DODGE_DIRECTIONS; ++i)
+	{
+		PendingPathBlocked[i] = false;
+		CachedPathSafe[i] = false;
+	}
+	PendingPathTraces = 0;
+	bHasCachedPaths = false;
+	CachedPathOrigin = FVector::ZeroVector;
+	CachedPathYaw = 0.0f;
+	CachedPathTime = 0.0f;
+	PendingPathOrigin = FVector::ZeroVector;
+	PendingPathYaw = 0.0f;
+	PendingWalkableFloorZ = 0.0f;
+	PathGeneration = 0;
+	bCombatPathValidationEnabled = false;
+
+	// 查找表在 BeginPlay 中烘焙
+	for (int32 i = 0; i <= DODGE_ALPHA_LUT_SIZE; ++i)
+	{
+		DodgeAlphaLUT[i] = 0.0f;
+	}
+	for (int32 i = 0; i < NUM_DODGE_DIRECTIONS; ++i)
+	{
+		DirectionMontages[i] = nullptr;
+		DirectionPlayRates[i] = 1.0f;
+	}
+	DodgeTablesDuration = 0.0f;
+	bHasDodgeSpeedTrack = false;
+	DodgeElapsedTime = 0.0f;
+	bUsingNativeIntegrator = false;
 	
 	// ����ʱ�������
 	DodgeTimeline = CreateDefaultSubobject<UTimelineComponent>(TEXT("DodgeTimeline"));
@@ -43,7 +90,10 @@ void UDodgeComponent::BeginPlay()
 	Super::BeginPlay();
 	
 	// ��ʼ��ʱ����
+	RebuildDodgeTables();
 	InitializeTimeline();
+
+	PathTraceDelegate.BindUObject(this, &UDodgeComponent::OnDodgePathTraceDone);
 	
 	// ���Ի�ȡ����������ã���ѡ��
 	AActor* Owner = GetOwner();
@@ -113,6 +163,9 @@ bool UDodgeComponent::StartDodge(const FVector& InputDirection)
 		}
 		return false;
 	}
+
+	// 预计算结果显示该方向被挡时，直接换成相邻的已验证方向
+	Direction = ResolveValidatedDirection(Direction);
 	
 	return StartDodgeInDirection(Direction);
 }
@@ -159,7 +212,19 @@ bool UDodgeComponent::StartDodgeInDirection(EDodgeDirection Direction)
 	FVector TargetLocation = CalculateDodgeTargetLocation(Direction);
 	
 	// ���·����ȫ��
-	if (!IsPathSafe(GetOwner()->GetActorLocation(), TargetLocation))
+	// 优先使用预计算结果，缓存过期时才同步扫掠
+	bool bPathSafe = false;
+	if (GetCachedPathSafety(Direction, bPathSafe))
+	{
+		SOUL_COUNTER_INC(TEXT("Dodge.PathCacheHits"));
+	}
+	else
+	{
+		SOUL_COUNTER_INC(TEXT("Dodge.PathCacheMisses"));
+		bPathSafe = IsPathSafe(GetOwner()->GetActorLocation(), TargetLocation);
+	}
+
+	if (!bPathSafe)
 	{
 		if (bEnableDebugLogs)
 		{
@@ -193,12 +258,27 @@ bool UDodgeComponent::StartDodgeInDirection(EDodgeDirection Direction)
 	DodgeStartLocation = GetOwner()->GetActorLocation();
 	DodgeTargetLocation = TargetLocation;
 	DodgeStartTime = GetWorld()->GetTimeSeconds();
+
+	// 设置可能被直接修改过，先同步查找表与时间轴
+	SyncDodgeSettings();
 	
 	// �������ܶ���
 	PlayDodgeAnimation(Direction);
+
+	// 根运动源模式不需要时间轴；应用失败时退回时间轴
+	const bool bUsingRootMotion = DodgeSettings.bUseRootMotionSource &&
+		ApplyDodgeRootMotion(DodgeTargetLocation - DodgeStartLocation);
+
+	// 原生积分器查表推进位移，同样不需要时间轴
+	bUsingNativeIntegrator = !bUsingRootMotion && DodgeSettings.bUseNativeIntegrator;
+	if (bUsingNativeIntegrator)
+	{
+		DodgeElapsedTime = 0.0f;
+		SetComponentTickEnabled(true);
+	}
 	
 	// ����ʱ����
-	if (DodgeTimeline)
+	if (!bUsingRootMotion && !bUsingNativeIntegrator && DodgeTimeline)
 	{
 		DodgeTimeline->PlayFromStart();
 	}
@@ -248,6 +328,11 @@ void UDodgeComponent::EndDodge()
 	{
 		DodgeTimeline->Stop();
 	}
+
+	RemoveDodgeRootMotion();
+
+	bUsingNativeIntegrator = false;
+	SetComponentTickEnabled(false);
 	
 	// �����޵�֡
 	EndInvincibilityFrames();
@@ -417,13 +502,27 @@ float UDodgeComponent::GetDodgeProgress() const
 
 void UDodgeComponent::UpdateDodgeMovement(float DeltaTime)
 {
-	if (!bIsDodging || !DodgeTimeline)
+	if (!bIsDodging || !bUsingNativeIntegrator)
 	{
 		return;
 	}
-	
-	// ʱ������Զ������ƶ�����
-	// ����������Ӷ�����ƶ��߼�����ײ���
+
+	AActor* Owner = GetOwner();
+	if (!Owner)
+	{
+		return;
+	}
+
+	DodgeElapsedTime += DeltaTime;
+	const float NormalizedTime = DodgeSettings.DodgeDuration > 0.0f
+		? FMath::Min(DodgeElapsedTime / DodgeSettings.DodgeDuration, 1.0f) : 1.0f;
+
+	Owner->SetActorLocation(FMath::Lerp(DodgeStartLocation, DodgeTargetLocation, SampleDodgeAlpha(NormalizedTime)), true);
+
+	if (NormalizedTime >= 1.0f)
+	{
+		OnDodgeTimelineFinished();
+	}
 }
 
 EDodgeDirection UDodgeComponent::CalculateDodgeDirection(const FVector& InputDirection) const
@@ -556,6 +655,212 @@ void UDodgeComponent::OnDodgeTimelineUpdate(float Value)
 	}
 }
 
+float UDodgeComponent::ComputeDodgeAlpha(float CurveValue) const
+{
+	const float SpeedMultiplier = DodgeSettings.DodgeSpeedCurve ? DodgeSettings.DodgeSpeedCurve->GetFloatValue(CurveValue) : 1.0f;
+	return CurveValue * SpeedMultiplier;
+}
+
+void UDodgeComponent::RebuildDodgeTables()
+{
+	// 位移比例 alpha(t) 与时间轴路径一致：时间轴按秒求值速度曲线，再由 ComputeDodgeAlpha 换算
+	// 没有速度曲线时匀速
+	const float Duration = DodgeSettings.DodgeDuration;
+	UCurveFloat* SpeedCurve = DodgeSettings.DodgeSpeedCurve;
+	for (int32 i = 0; i <= DODGE_ALPHA_LUT_SIZE; ++i)
+	{
+		const float NormalizedTime = (float)i / DODGE_ALPHA_LUT_SIZE;
+		DodgeAlphaLUT[i] = SpeedCurve ? ComputeDodgeAlpha(SpeedCurve->GetFloatValue(NormalizedTime * Duration)) : NormalizedTime;
+	}
+
+	// 蒙太奇按闪避时长缩放播放速率
+	for (int32 i = 0; i < NUM_DODGE_DIRECTIONS; ++i)
+	{
+		UAnimMontage* Montage = GetDodgeMontageForDirection((EDodgeDirection)(i + 1));
+		DirectionMontages[i] = Montage;
+
+		float PlayRate = 1.0f;
+		if (Montage && Duration > 0.0f && Montage->GetPlayLength() > 0.0f)
+		{
+			PlayRate = Montage->GetPlayLength() / Duration;
+		}
+		DirectionPlayRates[i] = PlayRate;
+	}
+
+	DodgeTablesCurveKey = FObjectKey(SpeedCurve);
+	DodgeTablesDuration = Duration;
+
+	if (bEnableDebugLogs)
+	{
+		UE_LOG(LogTemp, Log, TEXT("DodgeComponent: Dodge tables rebuilt (curve: %s, duration: %.2f)"),
+			SpeedCurve ? *SpeedCurve->GetName() : TEXT("None"), Duration);
+	}
+}
+
+float UDodgeComponent::SampleDodgeAlpha(float NormalizedTime) const
+{
+	const float Position = FMath::Clamp(NormalizedTime, 0.0f, 1.0f) * DODGE_ALPHA_LUT_SIZE;
+	const int32 Index = FMath::Min(FMath::FloorToInt(Position), DODGE_ALPHA_LUT_SIZE - 1);
+	return FMath::Lerp(DodgeAlphaLUT[Index], DodgeAlphaLUT[Index + 1], Position - Index);
+}
+
+void UDodgeComponent::SetDodgeSettings(const FDodgeSettings& NewSettings)
+{
+	DodgeSettings = NewSettings;
+	RebuildDodgeTables();
+	BindDodgeTimelineCurve();
+}
+
+void UDodgeComponent::BindDodgeTimelineCurve()
+{
+	if (!DodgeTimeline)
+	{
+		return;
+	}
+
+	// 已有轨道时只替换曲线（为空时轨道不再求值，与未添加轨道一致）
+	if (bHasDodgeSpeedTrack)
+	{
+		DodgeTimeline->SetFloatCurve(DodgeSettings.DodgeSpeedCurve, DodgeSpeedTrackName);
+	}
+	else if (DodgeSettings.DodgeSpeedCurve)
+	{
+		FOnTimelineFloat UpdateDelegate;
+		UpdateDelegate.BindUFunction(this, FName("OnDodgeTimelineUpdate"));
+		DodgeTimeline->AddInterpFloat(DodgeSettings.DodgeSpeedCurve, UpdateDelegate, NAME_None, DodgeSpeedTrackName);
+		bHasDodgeSpeedTrack = true;
+	}
+
+	DodgeTimeline->SetTimelineLength(DodgeSettings.DodgeDuration);
+}
+
+bool UDodgeComponent::AreDodgeTablesCurrent() const
+{
+	if (DodgeTablesCurveKey != FObjectKey(DodgeSettings.DodgeSpeedCurve) || DodgeTablesDuration != DodgeSettings.DodgeDuration)
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < NUM_DODGE_DIRECTIONS; ++i)
+	{
+		if (DirectionMontages[i] != GetDodgeMontageForDirection((EDodgeDirection)(i + 1)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void UDodgeComponent::SyncDodgeSettings()
+{
+	if (AreDodgeTablesCurrent())
+	{
+		return;
+	}
+
+	RebuildDodgeTables();
+	BindDodgeTimelineCurve();
+}
+
+void UDodgeComponent::BakeDodgeStrengthCurve()
+{
+	if (!BakedDodgeStrengthCurve)
+	{
+		BakedDodgeStrengthCurve = NewObject<UCurveFloat>(this, NAME_None, RF_Transient);
+	}
+
+	FRichCurve& Curve = BakedDodgeStrengthCurve->FloatCurve;
+	Curve.Reset();
+
+	// 位移比例取自烘焙好的查找表
+	auto EvaluateAlpha = [this](float NormalizedTime)
+	{
+		return SampleDodgeAlpha(NormalizedTime);
+	};
+
+	// 每段取平均速率（alpha 差分），常量插值保证积分后的总位移与采样一致
+	float PreviousAlpha = EvaluateAlpha(0.0f);
+	float Strength = 0.0f;
+	for (int32 i = 0; i < DODGE_CURVE_BAKE_SAMPLES; ++i)
+	{
+		const float SegmentStart = (float)i / DODGE_CURVE_BAKE_SAMPLES;
+		const float SegmentEnd = (float)(i + 1) / DODGE_CURVE_BAKE_SAMPLES;
+		const float Alpha = EvaluateAlpha(SegmentEnd);
+
+		Strength = (Alpha - PreviousAlpha) * DODGE_CURVE_BAKE_SAMPLES;
+		const FKeyHandle Key = Curve.AddKey(SegmentStart, Strength);
+		Curve.SetKeyInterpMode(Key, RCIM_Constant);
+
+		PreviousAlpha = Alpha;
+	}
+
+	const FKeyHandle EndKey = Curve.AddKey(1.0f, Strength);
+	Curve.SetKeyInterpMode(EndKey, RCIM_Constant);
+}
+
+bool UDodgeComponent::ApplyDodgeRootMotion(const FVector& Displacement)
+{
+	ACharacter* Character = Cast<ACharacter>(GetOwner());
+	UCharacterMovementComponent* MovementComponent = Character ? Character->GetCharacterMovement() : nullptr;
+	if (!MovementComponent || DodgeSettings.DodgeDuration <= 0.0f)
+	{
+		return false;
+	}
+
+	BakeDodgeStrengthCurve();
+
+	// 恒定力 * 强度曲线 = 各段平均速度；只覆盖水平速度，重力照常作用
+	TSharedPtr<FRootMotionSource_ConstantForce> Source = MakeShared<FRootMotionSource_ConstantForce>();
+	Source->InstanceName = DodgeRootMotionName;
+	Source->AccumulateMode = ERootMotionAccumulateMode::Override;
+	Source->Settings.SetFlag(ERootMotionSourceSettingsFlags::IgnoreZAccumulate);
+	Source->Duration = DodgeSettings.DodgeDuration;
+	Source->Force = Displacement.GetSafeNormal2D() * (Displacement.Size2D() / DodgeSettings.DodgeDuration);
+	Source->StrengthOverTime = BakedDodgeStrengthCurve;
+	Source->FinishVelocityParams.Mode = ERootMotionFinishVelocityMode::SetVelocity;
+	Source->FinishVelocityParams.SetVelocity = FVector::ZeroVector;
+
+	DodgeRootMotionSourceID = MovementComponent->ApplyRootMotionSource(Source);
+
+	// 时间轴不播放，由定时器结束闪避
+	GetWorld()->GetTimerManager().SetTimer(
+		DodgeEndTimerHandle,
+		this,
+		&UDodgeComponent::OnDodgeTimelineFinished,
+		DodgeSettings.DodgeDuration,
+		false
+	);
+
+	if (bEnableDebugLogs)
+	{
+		UE_LOG(LogTemp, Log, TEXT("DodgeComponent: Applied root motion source %d, Force: %s"),
+			(int32)DodgeRootMotionSourceID, *Source->Force.ToString());
+	}
+
+	return true;
+}
+
+void UDodgeComponent::RemoveDodgeRootMotion()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(DodgeEndTimerHandle);
+	}
+
+	if (DodgeRootMotionSourceID == (uint16)ERootMotionSourceID::Invalid)
+	{
+		return;
+	}
+
+	ACharacter* Character = Cast<ACharacter>(GetOwner());
+	if (Character && Character->GetCharacterMovement())
+	{
+		Character->GetCharacterMovement()->RemoveRootMotionSourceByID(DodgeRootMotionSourceID);
+	}
+
+	DodgeRootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
+}
+
 void UDodgeComponent::OnDodgeTimelineFinished()
 {
 	if (bEnableDebugLogs)
@@ -573,23 +878,14 @@ void UDodgeComponent::InitializeTimeline()
 		return;
 	}
 	
-	// ����ʱ�������ߣ����û�������ٶ����ߣ�ʹ��Ĭ�ϵ��������ߣ�
-	if (DodgeSettings.DodgeSpeedCurve)
-	{
-		// ��ʱ��������¼�
-		FOnTimelineFloat UpdateDelegate;
-		UpdateDelegate.BindUFunction(this, FName("OnDodgeTimelineUpdate"));
-		DodgeTimeline->AddInterpFloat(DodgeSettings.DodgeSpeedCurve, UpdateDelegate);
-	}
+	// 速度曲线轨道与时间轴长度
+	BindDodgeTimelineCurve();
 	
 	// ��ʱ��������¼�
 	FOnTimelineEvent FinishDelegate;
 	FinishDelegate.BindUFunction(this, FName("OnDodgeTimelineFinished"));
 	DodgeTimeline->SetTimelineFinishedFunc(FinishDelegate);
 	
-	// ����ʱ���᳤��
-	DodgeTimeline->SetTimelineLength(DodgeSettings.DodgeDuration);
-	
 	if (bEnableDebugLogs)
 	{
 		UE_LOG(LogTemp, Log, TEXT("DodgeComponent: Timeline initialized with duration: %.2f"), DodgeSettings.DodgeDuration);
@@ -598,7 +894,13 @@ void UDodgeComponent::InitializeTimeline()
 
 void UDodgeComponent::PlayDodgeAnimation(EDodgeDirection Direction)
 {
-	UAnimMontage* MontageToPlay = GetDodgeMontageForDirection(Direction);
+	// 查表取蒙太奇与播放速率（闪避开始前已由 SyncDodgeSettings 保证与设置一致）
+	const int32 DirectionIndex = (int32)Direction - 1;
+	if (DirectionIndex < 0 || DirectionIndex >= NUM_DODGE_DIRECTIONS)
+	{
+		return;
+	}
+	UAnimMontage* MontageToPlay = DirectionMontages[DirectionIndex];
 	
 	if (!MontageToPlay)
 	{
@@ -627,12 +929,7 @@ void UDodgeComponent::PlayDodgeAnimation(EDodgeDirection Direction)
 		return;
 	}
 	
-	// ���Ŷ�����̫��
-	float PlayRate = 1.0f;
-	if (DodgeSettings.DodgeDuration > 0.0f && MontageToPlay->GetPlayLength() > 0.0f)
-	{
-		PlayRate = MontageToPlay->GetPlayLength() / DodgeSettings.DodgeDuration;
-	}
+	const float PlayRate = DirectionPlayRates[DirectionIndex];
 	
 	AnimInstance->Montage_Play(MontageToPlay, PlayRate);
 	
@@ -698,48 +995,308 @@ FVector UDodgeComponent::GetDirectionVector(EDodgeDirection Direction) const
 	}
 }
 
+// 地面探测点：沿路径均匀分布，最后一个在终点
+static FVector GetGroundProbeLocation(const FVector& StartLocation, const FVector& EndLocation, int32 Sample, int32 NumSamples)
+{
+	return FMath::Lerp(StartLocation, EndLocation, (float)Sample / NumSamples);
+}
+
+// 地面探测：没有地面（悬崖）或地面过陡
+static bool IsGroundProbeBlocked(const FHitResult* Hit, float WalkableFloorZ)
+{
+	return !Hit || Hit->ImpactNormal.Z < WalkableFloorZ;
+}
+
+UDodgeComponent::FDodgePathProbeSettings UDodgeComponent::GetPathProbeSettings() const
+{
+	FDodgePathProbeSettings Settings;
+
+	ACharacter* Character = Cast<ACharacter>(GetOwner());
+	if (!Character)
+	{
+		return Settings;
+	}
+
+	float CapsuleHalfHeight = 90.0f;
+	if (UCapsuleComponent* Capsule = Character->GetCapsuleComponent())
+	{
+		Settings.SweepRadius = Capsule->GetScaledCapsuleRadius();
+		CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	}
+
+	if (UCharacterMovementComponent* MovementComponent = Character->GetCharacterMovement())
+	{
+		// 地面探测从胶囊中心向下，超过可跨越台阶高度仍无地面视为悬崖
+		Settings.ProbeDepth = CapsuleHalfHeight + MovementComponent->MaxStepHeight;
+		Settings.WalkableFloorZ = MovementComponent->GetWalkableFloorZ();
+		Settings.NumGroundSamples = FMath::Clamp(PathGroundSamples, 1, 8);
+	}
+
+	return Settings;
+}
+
 bool UDodgeComponent::IsPathSafe(const FVector& StartLocation, const FVector& EndLocation) const
 {
+	SOUL_PERFORMANCE_SCOPE(TEXT("DodgeComponent.IsPathSafe"));
+
 	UWorld* World = GetWorld();
 	if (!World)
 	{
 		return false;
 	}
 	
-	// �������߼�⣬���·�����Ƿ����ϰ���
+	// 与异步预计算相同的检测：一条整段扫掠 + 若干地面探测，预计算缓存是否命中不影响结果
+	const FDodgePathProbeSettings Probe = GetPathProbeSettings();
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(DodgePathValidation), false, GetOwner());
+	
 	FHitResult HitResult;
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(GetOwner());
-	QueryParams.bTraceComplex = false;
-	QueryParams.bReturnPhysicalMaterial = false;
+	if (World->SweepSingleByChannel(HitResult, StartLocation, EndLocation, FQuat::Identity,
+		ECC_WorldStatic, FCollisionShape::MakeSphere(Probe.SweepRadius), QueryParams))
+	{
+		if (bEnableDebugLogs)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DodgeComponent: Dodge path blocked by: %s"), 
+				HitResult.GetActor() ? *HitResult.GetActor()->GetName() : TEXT("Unknown"));
+		}
+		return false;
+	}
 	
-	// ʹ�ý�ɫ������İ뾶��������׷��
-	float CapsuleRadius = 50.0f; // Ĭ�ϰ뾶
+	for (int32 Sample = 1; Sample <= Probe.NumGroundSamples; ++Sample)
+	{
+		const FVector ProbeLocation = GetGroundProbeLocation(StartLocation, EndLocation, Sample, Probe.NumGroundSamples);
+		const bool bHit = World->LineTraceSingleByChannel(HitResult, ProbeLocation, ProbeLocation - FVector(0.0f, 0.0f, Probe.ProbeDepth),
+			ECC_WorldStatic, QueryParams);
+		
+		if (IsGroundProbeBlocked(bHit ? &HitResult : nullptr, Probe.WalkableFloorZ))
+		{
+			if (bEnableDebugLogs)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("DodgeComponent: Dodge path has no walkable ground at sample %d"), Sample);
+			}
+			return false;
+		}
+	}
 	
+	return true;
+}
+
+// ==================== 路径预计算 ====================
+
+// UserData 编码：批次号(16位) | 方向索引(8位) | 采样索引(8位)，采样0为整段扫掠，其余为地面探测
+static uint32 PackPathTraceUserData(uint16 Generation, int32 DirectionIndex, int32 SampleIndex)
+{
+	return ((uint32)Generation << 16) | ((uint32)DirectionIndex << 8) | (uint32)SampleIndex;
+}
+
+void UDodgeComponent::SetCombatPathValidationEnabled(bool bEnabled)
+{
+	UWorld* World = GetWorld();
+	if (!World || bCombatPathValidationEnabled == bEnabled)
+	{
+		return;
+	}
+
+	bCombatPathValidationEnabled = bEnabled;
+
+	if (bEnabled && bPrecomputeDodgePaths)
+	{
+		World->GetTimerManager().SetTimer(
+			PathValidationTimerHandle,
+			this,
+			&UDodgeComponent::RefreshDodgePaths,
+			PathValidationInterval,
+			true,
+			0.0f
+		);
+	}
+	else
+	{
+		World->GetTimerManager().ClearTimer(PathValidationTimerHandle);
+		InvalidateDodgePaths();
+	}
+}
+
+bool UDodgeComponent::GetCachedPathSafety(EDodgeDirection Direction, bool& bOutSafe) const
+{
+	const int32 DirectionIndex = (int32)Direction - 1;
+	if (!bHasCachedPaths || DirectionIndex < 0 || DirectionIndex >= NUM_DODGE_DIRECTIONS)
+	{
+		return false;
+	}
+
+	const AActor* Owner = GetOwner();
+	const UWorld* World = GetWorld();
+	if (!Owner || !World)
+	{
+		return false;
+	}
+
+	// 结果只在发起位置/朝向附近、且不超过几个刷新周期时可信
+	const float Age = World->GetTimeSeconds() - CachedPathTime;
+	const float Drift = FVector::Dist2D(Owner->GetActorLocation(), CachedPathOrigin);
+	const float YawDelta = FMath::Abs(FMath::FindDeltaAngleDegrees(CachedPathYaw, Owner->GetActorRotation().Yaw));
+	if (Age > PathValidationInterval * 3.0f || Drift > PathCacheMaxDrift || YawDelta > PathCacheMaxYawDelta)
+	{
+		return false;
+	}
+
+	bOutSafe = CachedPathSafe[DirectionIndex];
+	return true;
+}
+
+EDodgeDirection UDodgeComponent::ResolveValidatedDirection(EDodgeDirection Direction) const
+{
+	bool bSafe = false;
+	if (!GetCachedPathSafety(Direction, bSafe) || bSafe)
+	{
+		return Direction;
+	}
+
+	// 按顺时针环排列，相邻方向夹角45度
+	static const EDodgeDirection Ring[NUM_DODGE_DIRECTIONS] =
+	{
+		EDodgeDirection::Forward, EDodgeDirection::ForwardRight, EDodgeDirection::Right, EDodgeDirection::BackwardRight,
+		EDodgeDirection::Backward, EDodgeDirection::BackwardLeft, EDodgeDirection::Left, EDodgeDirection::ForwardLeft
+	};
+
+	int32 RingIndex = 0;
+	for (int32 i = 0; i < NUM_DODGE_DIRECTIONS; ++i)
+	{
+		if (Ring[i] == Direction)
+		{
+			RingIndex = i;
+			break;
+		}
+	}
+
+	// 先顺时针再逆时针，结果确定
+	for (const int32 Offset : { 1, NUM_DODGE_DIRECTIONS - 1 })
+	{
+		const EDodgeDirection Neighbor = Ring[(RingIndex + Offset) % NUM_DODGE_DIRECTIONS];
+		bool bNeighborSafe = false;
+		if (GetCachedPathSafety(Neighbor, bNeighborSafe) && bNeighborSafe)
+		{
+			if (bEnableDebugLogs)
+			{
+				UE_LOG(LogTemp, Log, TEXT("DodgeComponent: Direction %d blocked, using validated neighbor %d"),
+					(int32)Direction, (int32)Neighbor);
+			}
+			return Neighbor;
+		}
+	}
+
+	return Direction;
+}
+
+void UDodgeComponent::InvalidateDodgePaths()
+{
+	// 批次号递增后进行中的回调全部作废
+	++PathGeneration;
+	PendingPathTraces = 0;
+	bHasCachedPaths = false;
+}
+
+void UDodgeComponent::RefreshDodgePaths()
+{
+	SOUL_PERFORMANCE_SCOPE(TEXT("DodgeComponent.RefreshDodgePaths"));
+
+	UWorld* World = GetWorld();
 	ACharacter* Character = Cast<ACharacter>(GetOwner());
-	if (Character && Character->GetCapsuleComponent())
+	if (!World || !Character)
 	{
-		CapsuleRadius = Character->GetCapsuleComponent()->GetScaledCapsuleRadius();
+		return;
 	}
-	
-	bool bHit = World->SweepSingleByChannel(
-		HitResult,
-		StartLocation,
-		EndLocation,
-		FQuat::Identity,
-		ECC_WorldStatic,
-		FCollisionShape::MakeSphere(CapsuleRadius),
-		QueryParams
-	);
-	
-	// ���û��ײ�����κζ�����·���ǰ�ȫ��
-	bool bIsSafe = !bHit;
-	
-	if (bEnableDebugLogs && !bIsSafe)
+
+	// 闪避中或离地时位置变化太快，缓存没有意义
+	UCharacterMovementComponent* MovementComponent = Character->GetCharacterMovement();
+	if (bIsDodging || !MovementComponent || !MovementComponent->IsMovingOnGround())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("DodgeComponent: Dodge path blocked by: %s"), 
-			HitResult.GetActor() ? *HitResult.GetActor()->GetName() : TEXT("Unknown"));
+		InvalidateDodgePaths();
+		return;
 	}
-	
-	return bIsSafe;
-}
\ No newline at end of file
+
+	// 上一批还没回来（通常下一帧返回）就跳过本次，避免堆积
+	if (PendingPathTraces > 0)
+	{
+		return;
+	}
+
+	++PathGeneration;
+
+	const FDodgePathProbeSettings Probe = GetPathProbeSettings();
+
+	const FVector StartLocation = Character->GetActorLocation();
+	PendingPathOrigin = StartLocation;
+	PendingPathYaw = Character->GetActorRotation().Yaw;
+	PendingWalkableFloorZ = Probe.WalkableFloorZ;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(DodgePathValidation), false, Character);
+	const FCollisionShape SweepShape = FCollisionShape::MakeSphere(Probe.SweepRadius);
+	const float ProbeDepth = Probe.ProbeDepth;
+	const int32 NumGroundSamples = Probe.NumGroundSamples;
+
+	for (int32 DirectionIndex = 0; DirectionIndex < NUM_DODGE_DIRECTIONS; ++DirectionIndex)
+	{
+		PendingPathBlocked[DirectionIndex] = false;
+
+		const EDodgeDirection Direction = (EDodgeDirection)(DirectionIndex + 1);
+		const FVector EndLocation = StartLocation + GetDirectionVector(Direction) * DodgeSettings.DodgeDistance;
+
+		World->AsyncSweepByChannel(EAsyncTraceType::Single, StartLocation, EndLocation, FQuat::Identity,
+			ECC_WorldStatic, SweepShape, QueryParams, FCollisionResponseParams::DefaultResponseParam,
+			&PathTraceDelegate, PackPathTraceUserData(PathGeneration, DirectionIndex, 0));
+
+		for (int32 Sample = 1; Sample <= NumGroundSamples; ++Sample)
+		{
+			const FVector ProbeLocation = GetGroundProbeLocation(StartLocation, EndLocation, Sample, NumGroundSamples);
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single, ProbeLocation, ProbeLocation - FVector(0.0f, 0.0f, ProbeDepth),
+				ECC_WorldStatic, QueryParams, FCollisionResponseParams::DefaultResponseParam,
+				&PathTraceDelegate, PackPathTraceUserData(PathGeneration, DirectionIndex, Sample));
+		}
+	}
+
+	PendingPathTraces = NUM_DODGE_DIRECTIONS * (1 + NumGroundSamples);
+	SOUL_COUNTER_ADD(TEXT("Dodge.PathTracesIssued"), PendingPathTraces);
+}
+
+void UDodgeComponent::OnDodgePathTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	const uint16 Generation = (uint16)(TraceDatum.UserData >> 16);
+	const int32 DirectionIndex = (TraceDatum.UserData >> 8) & 0xFF;
+	const int32 SampleIndex = TraceDatum.UserData & 0xFF;
+
+	if (Generation != PathGeneration || PendingPathTraces <= 0 || DirectionIndex >= NUM_DODGE_DIRECTIONS)
+	{
+		return;
+	}
+
+	const FHitResult* Hit = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit ? &TraceDatum.OutHits[0] : nullptr;
+
+	bool bBlocked = false;
+	if (SampleIndex == 0)
+	{
+		// 整段扫掠：撞到静态几何体
+		bBlocked = Hit != nullptr;
+	}
+	else
+	{
+		bBlocked = IsGroundProbeBlocked(Hit, PendingWalkableFloorZ);
+	}
+
+	PendingPathBlocked[DirectionIndex] |= bBlocked;
+
+	if (--PendingPathTraces > 0)
+	{
+		return;
+	}
+
+	// 整批完成后一次性提交，保证八个方向来自同一位置
+	for (int32 i = 0; i < NUM_DODGE_DIRECTIONS; ++i)
+	{
+		CachedPathSafe[i] = !PendingPathBlocked[i];
+	}
+	CachedPathOrigin = PendingPathOrigin;
+	CachedPathYaw = PendingPathYaw;
+	CachedPathTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+	bHasCachedPaths = true;
+}
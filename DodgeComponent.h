@@ -8,6 +8,8 @@
 #include "Engine/DataTable.h"
 #include "Animation/AnimMontage.h"
 #include "Curves/CurveFloat.h"
+#include "WorldCollision.h"
+#include "UObject/ObjectKey.h"
 #include "DodgeComponent.generated.h"
 
 // ǰ������
@@ -54,6 +56,15 @@ struct FDodgeSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dodge Settings")
 	UCurveFloat* DodgeSpeedCurve;
 
+	// 使用根运动源驱动闪避位移（速度曲线在闪避开始时烘焙，由角色移动组件按正常的每帧单次扫掠积分）
+	// 关闭时沿用时间轴逐帧 SetActorLocation
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dodge Settings")
+	bool bUseRootMotionSource;
+
+	// 使用原生积分器：按烘焙好的查找表推进位移，不播放时间轴组件（根运动源优先）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dodge Settings")
+	bool bUseNativeIntegrator;
+
 	// ǰ�����ܶ�����̫��
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animations")
 	UAnimMontage* ForwardDodgeMontage;
@@ -78,6 +89,8 @@ struct FDodgeSettings
 		InvincibilityStartTime = 0.1f;
 		InvincibilityDuration = 0.4f;
 		DodgeSpeedCurve = nullptr;
+		bUseRootMotionSource = false;
+		bUseNativeIntegrator = false;
 		ForwardDodgeMontage = nullptr;
 		BackwardDodgeMontage = nullptr;
 		LeftDodgeMontage = nullptr;
@@ -129,6 +142,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Dodge")
 	void CancelDodge();
 
+	// 更新闪避设置并重新烘焙查找表
+	UFUNCTION(BlueprintCallable, Category = "Dodge")
+	void SetDodgeSettings(const FDodgeSettings& NewSettings);
+
+	// 开启/关闭战斗中的闪避路径预计算（锁定目标时由角色调用）
+	UFUNCTION(BlueprintCallable, Category = "Dodge")
+	void SetCombatPathValidationEnabled(bool bEnabled);
+
+	// 查询某方向的预计算结果；缓存过期或未开启时返回false
+	UFUNCTION(BlueprintCallable, Category = "Dodge")
+	bool GetCachedPathSafety(EDodgeDirection Direction, bool& bOutSafe) const;
+
 	// ==================== �޵�֡���� ====================
 	
 	// ��ʼ�޵�֡
@@ -185,6 +210,28 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	bool bEnableDebugLogs = false;
 
+	// ==================== 路径预计算 ====================
+
+	// 战斗中按固定间隔异步验证八个方向的闪避路径，StartDodge 直接使用结果
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Path Validation")
+	bool bPrecomputeDodgePaths = true;
+
+	// 预计算刷新间隔（秒）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Path Validation", meta = (ClampMin = "0.05", ClampMax = "1.0"))
+	float PathValidationInterval = 0.15f;
+
+	// 每条路径上的地面探测数（检测悬崖与不可行走的斜坡）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Path Validation", meta = (ClampMin = "1", ClampMax = "8"))
+	int32 PathGroundSamples = 3;
+
+	// 角色离开预计算位置超过此距离后缓存失效，退回同步检测
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Path Validation", meta = (ClampMin = "0.0", ClampMax = "200.0"))
+	float PathCacheMaxDrift = 50.0f;
+
+	// 角色朝向变化超过此角度后缓存失效
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Path Validation", meta = (ClampMin = "0.0", ClampMax = "45.0"))
+	float PathCacheMaxYawDelta = 10.0f;
+
 protected:
 	// ==================== ������� ====================
 	
@@ -226,6 +273,74 @@ protected:
 	// �޵�֡��ʱ�����
 	FTimerHandle InvincibilityTimerHandle;
 
+	// ==================== 根运动源 ====================
+
+	// 闪避开始时由 DodgeSpeedCurve 烘焙出的强度曲线（归一化时间 -> 位移速率倍数）
+	UPROPERTY(Transient)
+	UCurveFloat* BakedDodgeStrengthCurve;
+
+	// 当前闪避的根运动源ID（0表示无）
+	uint16 DodgeRootMotionSourceID;
+
+	// 根运动源模式下代替时间轴完成回调的定时器
+	FTimerHandle DodgeEndTimerHandle;
+
+	// ==================== 路径预计算状态 ====================
+
+	static constexpr int32 NUM_DODGE_DIRECTIONS = 8;
+
+	// 当前一批异步检测的累积结果
+	bool PendingPathBlocked[NUM_DODGE_DIRECTIONS];
+	int32 PendingPathTraces;
+
+	// 最近一批完成的结果及其发起时的位置/朝向/时间
+	bool CachedPathSafe[NUM_DODGE_DIRECTIONS];
+	bool bHasCachedPaths;
+	FVector CachedPathOrigin;
+	float CachedPathYaw;
+	float CachedPathTime;
+
+	// 本批发起时的位置/朝向/可行走地面阈值
+	FVector PendingPathOrigin;
+	float PendingPathYaw;
+	float PendingWalkableFloorZ;
+
+	// 批次号，丢弃过期批次的回调
+	uint16 PathGeneration;
+
+	bool bCombatPathValidationEnabled;
+
+	FTimerHandle PathValidationTimerHandle;
+
+	FTraceDelegate PathTraceDelegate;
+
+	// ==================== 烘焙查找表 ====================
+
+	static constexpr int32 DODGE_ALPHA_LUT_SIZE = 64;
+
+	// 归一化时间 -> 位移比例（与时间轴路径的换算一致），DODGE_ALPHA_LUT_SIZE 段
+	float DodgeAlphaLUT[DODGE_ALPHA_LUT_SIZE + 1];
+
+	// 各方向（Forward..BackwardRight，下标为 EDodgeDirection - 1）的蒙太奇与按闪避时长缩放的播放速率
+	// 蒙太奇以 UPROPERTY 持有，GC 可见；DodgeSettings 中的蒙太奇被替换时由 SyncDodgeSettings 重建
+	UPROPERTY(Transient)
+	UAnimMontage* DirectionMontages[NUM_DODGE_DIRECTIONS];
+
+	float DirectionPlayRates[NUM_DODGE_DIRECTIONS];
+
+	// 查找表烘焙时使用的速度曲线与时长，DodgeSettings 被直接写入时据此发现表已过期
+	FObjectKey DodgeTablesCurveKey;
+	float DodgeTablesDuration;
+
+	// 时间轴上是否已添加速度曲线轨道
+	bool bHasDodgeSpeedTrack;
+
+	// 原生积分器：本次闪避已用时间
+	float DodgeElapsedTime;
+
+	// 本次闪避是否由原生积分器驱动
+	bool bUsingNativeIntegrator;
+
 private:
 	// ==================== ˽�и������� ====================
 	
@@ -242,6 +357,33 @@ private:
 	UFUNCTION()
 	void OnDodgeTimelineUpdate(float Value);
 
+	// 由时间轴曲线输出计算位移插值比例，与 OnDodgeTimelineUpdate 的换算一致
+	float ComputeDodgeAlpha(float CurveValue) const;
+
+	// 烘焙速度曲线的位移比例表与各方向蒙太奇播放速率（设置加载或变化时调用）
+	void RebuildDodgeTables();
+
+	// 查找表是否仍与 DodgeSettings 一致（速度曲线、时长、各方向蒙太奇）
+	bool AreDodgeTablesCurrent() const;
+
+	// 把速度曲线与时长重新绑定到时间轴，保持时间轴路径与查表路径一致
+	void BindDodgeTimelineCurve();
+
+	// DodgeSettings 可被蓝图或编辑器直接写入而绕过 SetDodgeSettings，闪避开始时检查并重新同步
+	void SyncDodgeSettings();
+
+	// 查表得到归一化时间对应的位移比例（线性插值）
+	float SampleDodgeAlpha(float NormalizedTime) const;
+
+	// 把速度曲线烘焙为根运动源的强度曲线
+	void BakeDodgeStrengthCurve();
+
+	// 以根运动源开始闪避位移，失败时返回false（退回时间轴）
+	bool ApplyDodgeRootMotion(const FVector& Displacement);
+
+	// 移除当前闪避的根运动源
+	void RemoveDodgeRootMotion();
+
 	// ʱ������ɻص�
 	UFUNCTION()
 	void OnDodgeTimelineFinished();
@@ -260,4 +402,27 @@ private:
 
 	// �������·���Ƿ�ȫ
 	bool IsPathSafe(const FVector& StartLocation, const FVector& EndLocation) const;
+
+	// 路径检测参数，同步检测与异步预计算共用，保证两条路径对悬崖/斜坡的判定一致
+	struct FDodgePathProbeSettings
+	{
+		float SweepRadius = 50.0f;
+		float ProbeDepth = 0.0f;
+		float WalkableFloorZ = 0.0f;
+		int32 NumGroundSamples = 0;	// 没有移动组件时为0，只做整段扫掠
+	};
+
+	FDodgePathProbeSettings GetPathProbeSettings() const;
+
+	// 发起一批八方向异步检测（一条扫掠 + 若干地面探测）
+	void RefreshDodgePaths();
+
+	// 异步检测回调
+	void OnDodgePathTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	// 请求方向预计算为不安全时，改用相邻的已验证方向
+	EDodgeDirection ResolveValidatedDirection(EDodgeDirection Direction) const;
+
+	// 丢弃缓存和进行中的批次
+	void InvalidateDodgePaths();
 };
\ No newline at end of file
@@ -11,6 +11,23 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "TimerManager.h"
 #include "CollisionQueryParams.h"
+#include "WorldCollision.h"
+#include "PerformanceProfiler.h"
+#include "Components/CapsuleComponent.h"
+#include "MyCharacter.h"
+#include "SoulInputBufferSubsystem.h"
+
+// 坠落检测异步结果的 UserData：高位为下落代数，最低位区分检测类型
+static constexpr uint32 PLUNGE_TRACE_TARGETS = 0;
+static constexpr uint32 PLUNGE_TRACE_GROUND = 1;
+
+// 玩家是否位于目标背后的锥形范围内
+// ToPlayer = 玩家位置 - 目标位置；等价于 acos(Dot(Forward, Normalize(ToPlayer))) > 180 - BackstabAngle，
+// 因 BackstabAngle <= 90 度，阈值余弦为负，可以两边平方去掉开方与反三角函数
+static FORCEINLINE bool IsInBackstabCone(float ForwardDotToPlayer, float ToPlayerSizeSquared, float ConeCosSquared)
+{
+	return ForwardDotToPlayer < 0.0f && ForwardDotToPlayer * ForwardDotToPlayer > ConeCosSquared * ToPlayerSizeSquared;
+}
 
 // Sets default values for this component's properties
 UExecutionComponent::UExecutionComponent()
@@ -43,6 +60,41 @@ void UExecutionComponent::BeginPlay()
 	UE_LOG(LogTemp, Warning, TEXT("ExecutionComponent: Component initialized successfully"));
 	UE_LOG(LogTemp, Warning, TEXT("ExecutionComponent: BackstabRange=%.1f, BackstabAngle=%.1f"), 
 		ExecutionSettings.BackstabRange, ExecutionSettings.BackstabAngle);
+
+	// 背刺机会定期扫描，结果缓存供UI读取，CheckBackstabOpportunity 只在当帧命中时走快速路径
+	if (bEnableBackstabScanner)
+	{
+		GetWorld()->GetTimerManager().SetTimer(BackstabScanTimerHandle, this,
+			&UExecutionComponent::ScanBackstabOpportunities, BACKSTAB_SCAN_INTERVAL, true);
+	}
+
+	// 坠落攻击检测只在下落期间运行
+	PlungeTraceDelegate.BindUObject(this, &UExecutionComponent::OnPlungeTraceDone);
+	if (ACharacter* Character = Cast<ACharacter>(GetOwner()))
+	{
+		Character->MovementModeChangedDelegate.AddDynamic(this, &UExecutionComponent::OnOwnerMovementModeChanged);
+		if (IsCharacterInAir())
+		{
+			StartPlungeDetection();
+		}
+	}
+}
+
+void UExecutionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearAllTimersForObject(this);
+	}
+	BackstabScanTimerHandle.Invalidate();
+	PlungeCheckTimerHandle.Invalidate();
+
+	if (ACharacter* Character = Cast<ACharacter>(GetOwner()))
+	{
+		Character->MovementModeChangedDelegate.RemoveDynamic(this, &UExecutionComponent::OnOwnerMovementModeChanged);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -61,19 +113,6 @@ void UExecutionComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 	{
 		UpdatePositioning(DeltaTime);
 	}
-
-	// ���ڼ�鱳�̻��ᣨ����Ƶ�����Ż����ܣ�
-	static float LastBackstabCheckTime = 0.0f;
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	if (CurrentTime - LastBackstabCheckTime > 0.2f) // ÿ0.2����һ��
-	{
-		// ��鸽���Ƿ��пɱ��̵�Ŀ��
-		TArray<AActor*> NearbyActors;
-		// ����������Ӹ����ӵ�Ŀ�������߼�
-		// Ϊ�˱�����������ԣ���ʱ��������ʵ��
-		
-		LastBackstabCheckTime = CurrentTime;
-	}
 }
 
 // ==================== ���Ľӿں���ʵ�� ====================
@@ -129,6 +168,16 @@ bool UExecutionComponent::StartExecution(AActor* Target, EExecutionType Executio
 	ExecutionStartTime = GetWorld()->GetTimeSeconds();
 	bExecutionAnimationPlaying = false;
 
+	// 处决开始后双方缓冲中的闪避、锁定切换等指令都不应再提交
+	if (USoulInputBufferSubsystem* InputBuffer = GetWorld()->GetSubsystem<USoulInputBufferSubsystem>())
+	{
+		InputBuffer->ClearCommands(Cast<AMyCharacter>(GetOwner()));
+		if (AMyCharacter* TargetCharacter = Cast<AMyCharacter>(Target))
+		{
+			InputBuffer->ClearCommands(TargetCharacter);
+		}
+	}
+
 	// ����������ʼ�¼�
 	OnExecutionStarted.Broadcast(Target, ExecutionType);
 
@@ -190,6 +239,18 @@ void UExecutionComponent::CancelExecution()
 // ==================== ����ϵͳ����ʵ�� ====================
 
 bool UExecutionComponent::CheckBackstabOpportunity(AActor* Target) const
+{
+	// 缓存只作为快速通过路径：本帧刚扫描出的最佳目标直接通过；
+	// 其他目标（非最佳、玩家控制的Pawn）或缓存已过期时做完整检查
+	if (Target && BackstabScanFrame == GFrameCounter && Target == BackstabOpportunityTarget.Get())
+	{
+		return true;
+	}
+
+	return EvaluateBackstabOpportunity(Target);
+}
+
+bool UExecutionComponent::EvaluateBackstabOpportunity(AActor* Target) const
 {
 	if (!ValidateExecutionTarget(Target))
 	{
@@ -310,64 +371,140 @@ void UExecutionComponent::EndRiposteWindow()
 
 bool UExecutionComponent::CanPlungeAttack() const
 {
-	// ����ɫ�Ƿ��ڿ���
 	if (!IsCharacterInAir())
 	{
 		return false;
 	}
 
-	// ���߶��Ƿ��㹻
-	float Height = GetCharacterHeight();
-	if (Height < ExecutionSettings.PlungeHeightRequirement)
+	// 读取下落期间最近一次异步检测的结果，不在这里发起查询
+	if (PlungeGroundDistance < ExecutionSettings.PlungeHeightRequirement)
 	{
 		return false;
 	}
 
-	// ����·��Ƿ��пɹ�����Ŀ��
-	TArray<AActor*> Targets = GetPlungeTargets();
-	return Targets.Num() > 0;
+	for (const TWeakObjectPtr<AActor>& Target : PlungeTargetBuffer)
+	{
+		if (Target.IsValid())
+		{
+			return true;
+		}
+	}
+	return false;
 }
 
 TArray<AActor*> UExecutionComponent::GetPlungeTargets() const
 {
 	TArray<AActor*> PlungeTargets;
+	PlungeTargets.Reserve(PlungeTargetBuffer.Num());
 
-	if (!GetOwner())
+	for (const TWeakObjectPtr<AActor>& Target : PlungeTargetBuffer)
 	{
-		return PlungeTargets;
+		if (AActor* Actor = Target.Get())
+		{
+			PlungeTargets.Add(Actor);
+		}
 	}
 
-	// �ӽ�ɫλ���������߼��
-	FVector StartLocation = GetOwner()->GetActorLocation();
-	FVector EndLocation = StartLocation - FVector(0.0f, 0.0f, ExecutionSettings.PlungeHeightRequirement * 2.0f);
+	return PlungeTargets;
+}
 
-	// �������߼�����
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(GetOwner());
-	QueryParams.bTraceComplex = false;
+void UExecutionComponent::OnOwnerMovementModeChanged(ACharacter* Character, EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
+{
+	if (IsCharacterInAir())
+	{
+		StartPlungeDetection();
+	}
+	else
+	{
+		StopPlungeDetection();
+	}
+}
 
-	// ִ�����߼��
-	TArray<FHitResult> HitResults;
-	bool bHit = GetWorld()->LineTraceMultiByChannel(
-		HitResults,
-		StartLocation,
-		EndLocation,
-		ECC_Pawn,
-		QueryParams
-	);
+void UExecutionComponent::StartPlungeDetection()
+{
+	UWorld* World = GetWorld();
+	if (!World || World->GetTimerManager().IsTimerActive(PlungeCheckTimerHandle))
+	{
+		return;
+	}
 
-	if (bHit)
+	++PlungeTraceGeneration;
+	PlungeTargetBuffer.Reset();
+	PlungeGroundDistance = 0.0f;
+
+	RequestPlungeTraces();
+	World->GetTimerManager().SetTimer(PlungeCheckTimerHandle, this,
+		&UExecutionComponent::RequestPlungeTraces, PLUNGE_HEIGHT_CHECK_INTERVAL, true);
+}
+
+void UExecutionComponent::StopPlungeDetection()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(PlungeCheckTimerHandle);
+	}
+
+	// 使仍在途中的异步结果作废，保留缓冲区容量
+	++PlungeTraceGeneration;
+	PlungeTargetBuffer.Reset();
+	PlungeGroundDistance = 0.0f;
+}
+
+void UExecutionComponent::RequestPlungeTraces()
+{
+	SOUL_PERFORMANCE_SCOPE(TEXT("ExecutionComponent.RequestPlungeTraces"));
+
+	ACharacter* Character = Cast<ACharacter>(GetOwner());
+	UWorld* World = GetWorld();
+	if (!Character || !World)
+	{
+		return;
+	}
+
+	const FVector StartLocation = Character->GetActorLocation();
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PlungeDetection), false, Character);
+
+	// 用胶囊半径向下扫掠，覆盖角色落点而不只是正下方一条线
+	const float SweepRadius = Character->GetCapsuleComponent() ? Character->GetCapsuleComponent()->GetScaledCapsuleRadius() : 0.0f;
+	const FVector SweepEnd = StartLocation - FVector(0.0f, 0.0f, ExecutionSettings.PlungeHeightRequirement * 2.0f);
+	World->AsyncSweepByChannel(EAsyncTraceType::Multi, StartLocation, SweepEnd, FQuat::Identity,
+		ECC_Pawn, FCollisionShape::MakeSphere(SweepRadius), QueryParams, FCollisionResponseParams::DefaultResponseParam,
+		&PlungeTraceDelegate, (PlungeTraceGeneration << 1) | PLUNGE_TRACE_TARGETS);
+
+	// 离地高度
+	const FVector GroundEnd = StartLocation - FVector(0.0f, 0.0f, 10000.0f);
+	World->AsyncLineTraceByChannel(EAsyncTraceType::Single, StartLocation, GroundEnd,
+		ECC_WorldStatic, QueryParams, FCollisionResponseParams::DefaultResponseParam,
+		&PlungeTraceDelegate, (PlungeTraceGeneration << 1) | PLUNGE_TRACE_GROUND);
+
+	SOUL_COUNTER_ADD(TEXT("Execution.PlungeAsyncTraces"), 2);
+}
+
+void UExecutionComponent::OnPlungeTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	// 上一次下落发出的结果
+	if ((TraceDatum.UserData >> 1) != (PlungeTraceGeneration & 0x7FFFFFFF))
+	{
+		return;
+	}
+
+	if ((TraceDatum.UserData & 1) == PLUNGE_TRACE_GROUND)
+	{
+		PlungeGroundDistance = TraceDatum.OutHits.Num() > 0
+			? FVector::Dist(TraceDatum.Start, TraceDatum.OutHits[0].Location) : 0.0f;
+		return;
+	}
+
+	PlungeTargetBuffer.Reset();
+	for (const FHitResult& Hit : TraceDatum.OutHits)
 	{
-		for (const FHitResult& Hit : HitResults)
+		AActor* HitActor = Hit.GetActor();
+		if (HitActor && ValidateExecutionTarget(HitActor))
 		{
-			if (Hit.GetActor() && ValidateExecutionTarget(Hit.GetActor()))
-			{
-				PlungeTargets.Add(Hit.GetActor());
-			}
+			PlungeTargetBuffer.AddUnique(HitActor);
 		}
 	}
-
-	return PlungeTargets;
 }
 
 // ==================== ˽�и�������ʵ�� ====================
@@ -410,19 +547,20 @@ void UExecutionComponent::PositionCharacterForExecution(AActor* Target, EExecuti
 
 	bIsPositioningForExecution = true;
 	ExecutionStartPosition = GetOwner()->GetActorLocation();
+	PositioningElapsedTime = 0.0f;
+	PositioningFrames = 0;
 
 	// ���ݴ������ͼ���Ŀ��λ��
 	switch (ExecutionType)
 	{
 		case EExecutionType::Backstab:
 		case EExecutionType::Critical:
-			TargetExecutionPosition = GetBackstabPositionBehindTarget(Target);
+			TargetExecutionPosition = GetExecutionAnchor(Target->GetActorLocation(), Target->GetActorForwardVector(), ExecutionType);
 			break;
 			
 		case EExecutionType::Riposte:
 			// ����λ����Ŀ��ǰ��
-			TargetExecutionPosition = Target->GetActorLocation() + 
-				Target->GetActorForwardVector() * ExecutionSettings.BackstabRange * 0.8f;
+			TargetExecutionPosition = GetExecutionAnchor(Target->GetActorLocation(), Target->GetActorForwardVector(), ExecutionType);
 			break;
 			
 		case EExecutionType::Plunge:
@@ -493,11 +631,6 @@ bool UExecutionComponent::IsCharacterInAir() const
 	return MovementComp->IsFalling();
 }
 
-float UExecutionComponent::GetCharacterHeight() const
-{
-	return GetDistanceToGround();
-}
-
 float UExecutionComponent::GetDistanceToGround() const
 {
 	if (!GetOwner())
@@ -696,26 +829,38 @@ void UExecutionComponent::UpdatePositioning(float DeltaTime)
 		return;
 	}
 
-	FVector CurrentPosition = GetOwner()->GetActorLocation();
-	float DistanceToTarget = FVector::Dist(CurrentPosition, TargetExecutionPosition);
-
-	// ����Ƿ񵽴�Ŀ��λ��
-	if (DistanceToTarget < EXECUTION_POSITION_THRESHOLD)
+	AActor* Target = CurrentExecutionTarget;
+	if (!Target)
 	{
 		bIsPositioningForExecution = false;
-		UE_LOG(LogTemp, Log, TEXT("ExecutionComponent: Reached execution position"));
 		return;
 	}
 
-	// ƽ���ƶ���Ŀ��λ��
-	FVector NewPosition = FMath::VInterpTo(
-		CurrentPosition,
-		TargetExecutionPosition,
-		DeltaTime,
-		BACKSTAB_POSITION_INTERP_SPEED
-	);
+	PositioningElapsedTime += DeltaTime;
+	++PositioningFrames;
+
+	// 按目标当前速度预测对位窗口结束时的站位
+	const float RemainingTime = FMath::Max(ExecutionSettings.PositioningSnapWindow - PositioningElapsedTime, 0.0f);
+	const FVector PredictedTargetLocation = Target->GetActorLocation() + Target->GetVelocity() * RemainingTime;
+	TargetExecutionPosition = GetExecutionAnchor(PredictedTargetLocation, Target->GetActorForwardVector(), CurrentExecutionType);
+
+	// 每帧按剩余时间比例逼近预测站位，窗口结束时恰好到达；帧数上限保证一定收敛
+	const bool bWindowElapsed = RemainingTime <= 0.0f || PositioningFrames >= MAX_EXECUTION_ALIGN_FRAMES;
+	const float Alpha = bWindowElapsed ? 1.0f : DeltaTime / (DeltaTime + RemainingTime);
 
+	const FVector NewPosition = FMath::Lerp(GetOwner()->GetActorLocation(), TargetExecutionPosition, Alpha);
 	GetOwner()->SetActorLocation(NewPosition);
+
+	if (bWindowElapsed || FVector::Dist(NewPosition, TargetExecutionPosition) < EXECUTION_POSITION_THRESHOLD)
+	{
+		bIsPositioningForExecution = false;
+		LastAlignmentTime = PositioningElapsedTime;
+		LastAlignmentFrames = PositioningFrames;
+
+		SOUL_COUNTER_ADD(TEXT("Execution.AlignmentFrames"), PositioningFrames);
+		UE_LOG(LogTemp, Log, TEXT("ExecutionComponent: Reached execution position in %.1f ms (%d frames)"),
+			PositioningElapsedTime * 1000.0f, PositioningFrames);
+	}
 }
 
 void UExecutionComponent::ApplyExecutionDamage(AActor* Target, EExecutionType ExecutionType)
@@ -757,14 +902,15 @@ FVector UExecutionComponent::GetBackstabPositionBehindTarget(AActor* Target) con
 		return FVector::ZeroVector;
 	}
 
-	// ��ȡĿ�걳���λ��
-	FVector TargetLocation = Target->GetActorLocation();
-	FVector TargetForward = Target->GetActorForwardVector();
-	
-	// ��Ŀ�걳�����λ��
-	FVector BackstabPosition = TargetLocation - (TargetForward * ExecutionSettings.BackstabRange * 0.8f);
-	
-	return BackstabPosition;
+	return GetExecutionAnchor(Target->GetActorLocation(), Target->GetActorForwardVector(), EExecutionType::Backstab);
+}
+
+FVector UExecutionComponent::GetExecutionAnchor(const FVector& TargetLocation, const FVector& TargetForward, EExecutionType ExecutionType) const
+{
+	const float Offset = ExecutionSettings.BackstabRange * 0.8f;
+	return ExecutionType == EExecutionType::Riposte
+		? TargetLocation + TargetForward * Offset
+		: TargetLocation - TargetForward * Offset;
 }
 
 bool UExecutionComponent::IsBackstabAngleValid(AActor* Target) const
@@ -774,18 +920,9 @@ bool UExecutionComponent::IsBackstabAngleValid(AActor* Target) const
 		return false;
 	}
 
-	// ������������Ŀ��ĽǶ�
-	FVector TargetForward = Target->GetActorForwardVector();
-	FVector ToPlayer = (GetOwner()->GetActorLocation() - Target->GetActorLocation()).GetSafeNormal();
-	
-	// ����Ƕ�
-	float DotProduct = FVector::DotProduct(TargetForward, ToPlayer);
-	float Angle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(DotProduct, -1.0f, 1.0f)));
-	
-	// �������Ƿ���Ŀ�걳�󣨽Ƕȴ���90�ȱ�ʾ�ڱ���
-	bool bIsBehindTarget = Angle > (180.0f - ExecutionSettings.BackstabAngle);
-	
-	return bIsBehindTarget;
+	const FVector ToPlayer = GetOwner()->GetActorLocation() - Target->GetActorLocation();
+	const float ConeCos = FMath::Cos(FMath::DegreesToRadians(ExecutionSettings.BackstabAngle));
+	return IsInBackstabCone(FVector::DotProduct(Target->GetActorForwardVector(), ToPlayer), ToPlayer.SizeSquared(), ConeCos * ConeCos);
 }
 
 bool UExecutionComponent::IsBackstabDistanceValid(AActor* Target) const
@@ -795,6 +932,93 @@ bool UExecutionComponent::IsBackstabDistanceValid(AActor* Target) const
 		return false;
 	}
 
-	float Distance = FVector::Dist(GetOwner()->GetActorLocation(), Target->GetActorLocation());
-	return Distance <= ExecutionSettings.BackstabRange;
-}
\ No newline at end of file
+	return FVector::DistSquared(GetOwner()->GetActorLocation(), Target->GetActorLocation()) <= FMath::Square(ExecutionSettings.BackstabRange);
+}
+
+void UExecutionComponent::ScanBackstabOpportunities()
+{
+	SOUL_PERFORMANCE_SCOPE(TEXT("ExecutionComponent.ScanBackstab"));
+
+	AActor* Owner = GetOwner();
+	UWorld* World = GetWorld();
+	if (!Owner || !World)
+	{
+		return;
+	}
+
+	AActor* BestTarget = nullptr;
+	BackstabScanFrame = GFrameCounter;
+
+	if (!IsExecuting())
+	{
+		const FVector OwnerLocation = Owner->GetActorLocation();
+
+		// 以背刺距离为半径的球形重叠查询，只取Pawn通道
+		TArray<FOverlapResult> Overlaps;
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BackstabScan), false, Owner);
+		World->OverlapMultiByObjectType(Overlaps, OwnerLocation, FQuat::Identity,
+			FCollisionObjectQueryParams(ECC_Pawn), FCollisionShape::MakeSphere(ExecutionSettings.BackstabRange), QueryParams);
+		SOUL_COUNTER_INC(TEXT("Execution.BackstabScans"));
+
+		// 候选的相对位置与朝向按分量连续存放，下面的检测循环没有分支和开方，可被编译器向量化
+		TArray<AActor*, TInlineAllocator<16>> Candidates;
+		TArray<float, TInlineAllocator<16>> ToPlayerX, ToPlayerY, ToPlayerZ;
+		TArray<float, TInlineAllocator<16>> ForwardX, ForwardY, ForwardZ;
+
+		for (const FOverlapResult& Overlap : Overlaps)
+		{
+			// 敌对角色：非玩家控制的Pawn（同一Pawn的多个组件只取一次）
+			APawn* Pawn = Cast<APawn>(Overlap.GetActor());
+			if (!Pawn || Pawn->IsPlayerControlled() || Candidates.Contains(Pawn) || !ValidateExecutionTarget(Pawn))
+			{
+				continue;
+			}
+
+			const FVector ToPlayer = OwnerLocation - Pawn->GetActorLocation();
+			const FVector Forward = Pawn->GetActorForwardVector();
+
+			Candidates.Add(Pawn);
+			ToPlayerX.Add(ToPlayer.X);
+			ToPlayerY.Add(ToPlayer.Y);
+			ToPlayerZ.Add(ToPlayer.Z);
+			ForwardX.Add(Forward.X);
+			ForwardY.Add(Forward.Y);
+			ForwardZ.Add(Forward.Z);
+		}
+
+		const int32 NumCandidates = Candidates.Num();
+		SOUL_COUNTER_ADD(TEXT("Execution.BackstabCandidates"), NumCandidates);
+
+		const float RangeSquared = FMath::Square(ExecutionSettings.BackstabRange);
+		const float ConeCos = FMath::Cos(FMath::DegreesToRadians(ExecutionSettings.BackstabAngle));
+		const float ConeCosSquared = ConeCos * ConeCos;
+
+		// 不满足条件的候选得分为 MAX_flt，满足的得分为距离平方
+		TArray<float, TInlineAllocator<16>> Scores;
+		Scores.SetNumUninitialized(NumCandidates);
+		for (int32 i = 0; i < NumCandidates; ++i)
+		{
+			const float SizeSquared = ToPlayerX[i] * ToPlayerX[i] + ToPlayerY[i] * ToPlayerY[i] + ToPlayerZ[i] * ToPlayerZ[i];
+			const float ForwardDot = ForwardX[i] * ToPlayerX[i] + ForwardY[i] * ToPlayerY[i] + ForwardZ[i] * ToPlayerZ[i];
+			const bool bValid = SizeSquared <= RangeSquared && IsInBackstabCone(ForwardDot, SizeSquared, ConeCosSquared);
+			Scores[i] = bValid ? SizeSquared : MAX_flt;
+		}
+
+		// 最近的有效目标即最佳背刺目标
+		float BestScore = MAX_flt;
+		for (int32 i = 0; i < NumCandidates; ++i)
+		{
+			if (Scores[i] < BestScore && IsTargetVulnerableToBackstab(Candidates[i]))
+			{
+				BestScore = Scores[i];
+				BestTarget = Candidates[i];
+			}
+		}
+	}
+
+	if (BestTarget != BackstabOpportunityTarget.Get())
+	{
+		BackstabOpportunityTarget = BestTarget;
+		OnBackstabOpportunity.Broadcast(BestTarget);
+	}
+}
@@ -8,10 +8,12 @@
 #include "Animation/AnimMontage.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "TimerManager.h"
+#include "WorldCollision.h"
 #include "ExecutionComponent.generated.h"
 
 // ǰ������
 class AActor;
+class ACharacter;
 class UAnimMontage;
 
 /** ��������ö�� */
@@ -51,6 +53,10 @@ struct FExecutionSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Critical", meta = (ClampMin = "1.5", ClampMax = "10.0"))
 	float CriticalDamageMultiplier = 3.0f;
 
+	/** 处决对位窗口（秒）：按目标速度预测窗口结束时的位置，在窗口内收敛到位 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Positioning", meta = (ClampMin = "0.05", ClampMax = "1.0"))
+	float PositioningSnapWindow = 0.15f;
+
 	/** ���̶�����̫�� */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animations")
 	UAnimMontage* BackstabMontage = nullptr;
@@ -70,6 +76,7 @@ struct FExecutionSettings
 		RiposteWindow = 0.5f;
 		PlungeHeightRequirement = 200.0f;
 		CriticalDamageMultiplier = 3.0f;
+		PositioningSnapWindow = 0.15f;
 		BackstabMontage = nullptr;
 		RiposteMontage = nullptr;
 		PlungeMontage = nullptr;
@@ -103,8 +110,8 @@ protected:
 	virtual void BeginPlay() override;
 
 	// ==================== �������� ====================
-	/** ���̶�λ��ֵ�ٶ� */
-	static constexpr float BACKSTAB_POSITION_INTERP_SPEED = 8.0f;
+	/** 处决对位的最大帧数（对位窗口之外的安全上限） */
+	static constexpr int32 MAX_EXECUTION_ALIGN_FRAMES = 60;
 	
 	/** ����λ�õ���������ֵ */
 	static constexpr float EXECUTION_POSITION_THRESHOLD = 5.0f;
@@ -118,6 +125,11 @@ protected:
 	/** ����״̬����Ƶ�ʣ��룩 */
 	static constexpr float EXECUTION_UPDATE_INTERVAL = 0.02f;
 
+	/** 背刺机会扫描间隔（秒） */
+	static constexpr float BACKSTAB_SCAN_INTERVAL = 0.2f;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -127,6 +139,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Execution Settings")
 	FExecutionSettings ExecutionSettings;
 
+	/** 定期扫描周围可背刺的敌人并缓存最佳目标供UI使用（CheckBackstabOpportunity 始终以完整检查为准） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Execution Settings")
+	bool bEnableBackstabScanner = true;
+
 	// ==================== �¼�ί�� ====================
 	/** ������ʼ�¼� */
 	UPROPERTY(BlueprintAssignable, Category = "Execution Events")
@@ -170,6 +186,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Backstab")
 	FVector GetOptimalBackstabPosition(AActor* Target) const;
 
+	/** 当前最佳背刺目标（扫描器缓存，供UI提示读取），没有时为空 */
+	UFUNCTION(BlueprintPure, Category = "Backstab")
+	AActor* GetBackstabOpportunity() const { return BackstabOpportunityTarget.Get(); }
+
+	/** 最近一次处决对位耗时（秒）与帧数 */
+	UFUNCTION(BlueprintPure, Category = "Execution")
+	float GetLastAlignmentTime() const { return LastAlignmentTime; }
+
+	UFUNCTION(BlueprintPure, Category = "Execution")
+	int32 GetLastAlignmentFrames() const { return LastAlignmentFrames; }
+
 	// ==================== ����ϵͳ���� ====================
 	/** ����Ƿ���Ե��� */
 	UFUNCTION(BlueprintCallable, Category = "Riposte")
@@ -237,6 +264,39 @@ protected:
 	/** Ŀ�괦��λ�� */
 	FVector TargetExecutionPosition = FVector::ZeroVector;
 
+	/** 本次对位已用时间与帧数 */
+	float PositioningElapsedTime = 0.0f;
+	int32 PositioningFrames = 0;
+
+	/** 最近一次对位完成的耗时与帧数 */
+	float LastAlignmentTime = 0.0f;
+	int32 LastAlignmentFrames = 0;
+
+	/** 扫描器缓存的最佳背刺目标 */
+	TWeakObjectPtr<AActor> BackstabOpportunityTarget;
+
+	/** 最近一次扫描的帧号，缓存只在同一帧内视为有效 */
+	uint64 BackstabScanFrame = 0;
+
+	/** 背刺扫描定时器 */
+	FTimerHandle BackstabScanTimerHandle;
+
+	// ==================== 坠落攻击检测 ====================
+	/** 下落期间最近一次异步检测到的下方目标（复用同一缓冲区） */
+	TArray<TWeakObjectPtr<AActor>> PlungeTargetBuffer;
+
+	/** 最近一次异步检测到的离地高度 */
+	float PlungeGroundDistance = 0.0f;
+
+	/** 下落期间的检测定时器 */
+	FTimerHandle PlungeCheckTimerHandle;
+
+	/** 异步检测回调 */
+	FTraceDelegate PlungeTraceDelegate;
+
+	/** 每次进入下落状态递增，丢弃上一次下落的迟到结果 */
+	uint32 PlungeTraceGeneration = 0;
+
 	// ==================== ˽�и������� ====================
 	/** ��֤����Ŀ�����Ч�� */
 	bool ValidateExecutionTarget(AActor* Target) const;
@@ -250,9 +310,6 @@ protected:
 	/** ����ɫ�Ƿ��ڿ��У�����׹�乥���� */
 	bool IsCharacterInAir() const;
 
-	/** ��ȡ��ɫ��ǰ�߶� */
-	float GetCharacterHeight() const;
-
 	/** ��ȡ��ɫ������ľ��� */
 	float GetDistanceToGround() const;
 
@@ -296,4 +353,27 @@ protected:
 
 	/** ��鱳�̾����Ƿ���� */
 	bool IsBackstabDistanceValid(AActor* Target) const;
+
+	/** 给定目标位置与朝向时的处决站位（弹反在正面，其余在背后） */
+	FVector GetExecutionAnchor(const FVector& TargetLocation, const FVector& TargetForward, EExecutionType ExecutionType) const;
+
+	/** 完整检查单个目标的背刺条件（不读缓存） */
+	bool EvaluateBackstabOpportunity(AActor* Target) const;
+
+	/** 空间查询附近的敌对角色，批量检测距离与角度，更新最佳背刺目标 */
+	void ScanBackstabOpportunities();
+
+	/** 角色移动模式变化：进入下落时开始坠落检测，落地后停止 */
+	UFUNCTION()
+	void OnOwnerMovementModeChanged(ACharacter* Character, EMovementMode PrevMovementMode, uint8 PreviousCustomMode);
+
+	/** 开始/停止坠落攻击检测 */
+	void StartPlungeDetection();
+	void StopPlungeDetection();
+
+	/** 发起一次异步检测：胶囊半径的向下扫掠找目标，射线测离地高度 */
+	void RequestPlungeTraces();
+
+	/** 异步检测完成回调 */
+	void OnPlungeTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
 };
\ No newline at end of file
@@ -49,6 +49,11 @@ public:
 		meta = (EditCondition = "bPreferSocket", DisplayName = "Custom Socket Name"))
 	FName CustomSocketName = TEXT("LockOnSocket");
 	
+	// ==================== 多部位锁定点 ====================
+	/** 多部位锁定点（Bone或Socket名，按切换顺序排列），非空时替代UIManager的默认部位表，适用于多部位Boss */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lock On Override", meta = (DisplayName = "Lock-On Part Points"))
+	TArray<FName> LockOnPartNames;
+	
 	// ==================== 辅助函数 ====================
 	/** 验证配置是否有效 */
 	UFUNCTION(BlueprintCallable, Category = "Lock On Override")
@@ -0,0 +1,43 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LockOnWidgetBase.h"
+
+void ULockOnWidgetBase::NativeConstruct()
+{
+	Super::NativeConstruct();
+	
+	if (bPositionInViewport)
+	{
+		SetAlignmentInViewport(ViewportAlignment);
+	}
+}
+
+void ULockOnWidgetBase::SetLockOnScreenPosition(const FVector2D& ScreenPosition)
+{
+	LockOnScreenPosition = ScreenPosition;
+	
+	if (bPositionInViewport)
+	{
+		// ProjectWorldLocationToScreen returns raw viewport pixels, so strip DPI scale
+		SetPositionInViewport(ScreenPosition, true);
+	}
+	
+	if (bNotifyBlueprintOnPositionChanged)
+	{
+		OnLockOnScreenPositionChanged(ScreenPosition);
+	}
+}
+
+void ULockOnWidgetBase::SetLockOnScale(float Scale)
+{
+	LockOnScale = Scale;
+	SetRenderScale(FVector2D(Scale, Scale));
+	OnLockOnAppearanceChanged(LockOnScale, LockOnColor);
+}
+
+void ULockOnWidgetBase::SetLockOnColor(const FLinearColor& Color)
+{
+	LockOnColor = Color;
+	SetColorAndOpacity(Color);
+	OnLockOnAppearanceChanged(LockOnScale, LockOnColor);
+}
@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "LockOnWidgetBase.generated.h"
+
+/**
+ * Native base class for lock-on indicator widgets
+ *
+ * UIManagerComponent drives widgets derived from this class through plain virtual
+ * calls instead of looking up and invoking Blueprint functions by name every tick.
+ * The default implementations position, scale and tint the widget natively;
+ * Blueprint subclasses can opt into the matching events for custom visuals.
+ */
+UCLASS(Abstract, Blueprintable)
+class SOUL_API ULockOnWidgetBase : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Move the indicator to a screen position
+	 * @param ScreenPosition - Projected position in viewport pixels
+	 */
+	virtual void SetLockOnScreenPosition(const FVector2D& ScreenPosition);
+
+	/**
+	 * Apply size-adaptive scale to the indicator
+	 * @param Scale - Uniform render scale
+	 */
+	virtual void SetLockOnScale(float Scale);
+
+	/**
+	 * Apply size-adaptive color to the indicator
+	 * @param Color - Tint color
+	 */
+	virtual void SetLockOnColor(const FLinearColor& Color);
+
+	/** Get last screen position applied to this widget */
+	UFUNCTION(BlueprintPure, Category = "Lock-On Widget")
+	FVector2D GetLockOnScreenPosition() const { return LockOnScreenPosition; }
+
+protected:
+	virtual void NativeConstruct() override;
+
+	/** Called after the screen position changes (only when bNotifyBlueprintOnPositionChanged is set) */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Lock-On Widget")
+	void OnLockOnScreenPositionChanged(FVector2D ScreenPosition);
+
+	/** Called after the size-adaptive scale or color changes */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Lock-On Widget")
+	void OnLockOnAppearanceChanged(float Scale, FLinearColor Color);
+
+	/** Position the widget in the viewport natively (disable if the Blueprint lays itself out) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lock-On Widget")
+	bool bPositionInViewport = true;
+
+	/** Alignment used when positioning in viewport (0.5, 0.5 centers the indicator on the target) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lock-On Widget")
+	FVector2D ViewportAlignment = FVector2D(0.5f, 0.5f);
+
+	/** Forward every position change to Blueprint (costs one ProcessEvent per update) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lock-On Widget")
+	bool bNotifyBlueprintOnPositionChanged = false;
+
+	/** Last applied screen position */
+	FVector2D LockOnScreenPosition = FVector2D::ZeroVector;
+
+	/** Last applied scale */
+	float LockOnScale = 1.0f;
+
+	/** Last applied color */
+	FLinearColor LockOnColor = FLinearColor::White;
+};
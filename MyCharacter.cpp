@@ -609,13 +609,16 @@ void AMyCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompone
 	// ==================== ????????? ====================
 	// ???????? - ?????????????????
 	PlayerInputComponent->BindAction("LockOn", IE_Pressed, this, &AMyCharacter::HandleLockOnButton);
+
+	// 闪避（经过输入缓冲）
+	PlayerInputComponent->BindAction("Dodge", IE_Pressed, this, &AMyCharacter::HandleDodgeButton);
 	
 	// ?????????? ?????????? Gep?
 	PlayerInputComponent->BindAxis("RightStickX", this, &AMyCharacter::HandleRightStickX);
 	
 	// ????????????????
-	PlayerInputComponent->BindAction("SwitchTargetLeft", IE_Pressed, this, &AMyCharacter::SwitchLockOnTargetLeft);
-	PlayerInputComponent->BindAction("SwitchTargetRight", IE_Pressed, this, &AMyCharacter::SwitchLockOnTargetRight);
+	PlayerInputComponent->BindAction("SwitchTargetLeft", IE_Pressed, this, &AMyCharacter::HandleSwitchTargetLeftButton);
+	PlayerInputComponent->BindAction("SwitchTargetRight", IE_Pressed, this, &AMyCharacter::HandleSwitchTargetRightButton);
 
 	// ==================== ????????? ====================
 	// ????????key (F??) ??????????
@@ -1045,6 +1048,12 @@ void AMyCharacter::StartLockOn(AActor* Target)
 		
 	bIsLockedOn = true;
 	CurrentLockOnTarget = Target;
+
+	// 战斗中预先验证闪避路径
+	if (DodgeComponent)
+	{
+		DodgeComponent->SetCombatPathValidationEnabled(true);
+	}
 	
 	// 使用配置的臂长调整
 	if (CameraControlComponent && CameraBoom)
@@ -1120,6 +1129,18 @@ void AMyCharacter::CancelLockOn()
 	// 清除锁定状态
 	bIsLockedOn = false;
 	PreviousLockOnTarget = CurrentLockOnTarget;
+
+	// 锁定期间缓冲、尚未提交的切换指令随锁定一起作废
+	if (USoulInputBufferSubsystem* InputBuffer = GetWorld() ? GetWorld()->GetSubsystem<USoulInputBufferSubsystem>() : nullptr)
+	{
+		InputBuffer->ClearCommand(this, ESoulInputCommand::SwitchTargetLeft);
+		InputBuffer->ClearCommand(this, ESoulInputCommand::SwitchTargetRight);
+	}
+
+	if (DodgeComponent)
+	{
+		DodgeComponent->SetCombatPathValidationEnabled(false);
+	}
 	CurrentLockOnTarget = nullptr;
 	
 	// 清除相机跟随状态
@@ -1198,6 +1219,16 @@ FVector AMyCharacter::GetOptimalLockPosition(AActor* Target) const
 {
 	if (!Target) return FVector::ZeroVector;
 	
+	// ==================== 多部位锁定：与UI共用同一份已解析的部位变换 ====================
+	if (UIManagerComponent)
+	{
+		FTransform PartTransform;
+		if (UIManagerComponent->GetActiveTargetPartTransform(Target, PartTransform))
+		{
+			return PartTransform.GetLocation();
+		}
+	}
+	
 	// ==================== Step 2.5: �����Ի�������� ====================
 	if (ULockOnConfigComponent* Config = Target->FindComponentByClass<ULockOnConfigComponent>())
 	{
@@ -1845,46 +1876,26 @@ void AMyCharacter::HandleRightStickX(float Value)
 	}
 
 	// ==================== 锁定状态：用于切换目标 ====================
-	// ==================== 1. 冷却时间检查 ====================
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	if (CurrentTime - LastTargetSwitchTime < TargetSwitchCooldown)
-	{
-		// 还在冷却中，更新状态但不切换
-		LastRightStickX = Value;
-		return;
-	}
-
-	// ==================== 2. 边缘检测（只在跨越阈值瞬间触发）====================
+	// ==================== 1. 边缘检测（只在跨越阈值瞬间触发）====================
+	// 冷却检查在 TryCommitBufferedInput 中，冷却期间的拨动会被缓冲到冷却结束
 	bool bWasLeftPressed = (LastRightStickX < -THUMBSTICK_THRESHOLD);
 	bool bIsLeftPressed = (Value < -THUMBSTICK_THRESHOLD);
 	bool bWasRightPressed = (LastRightStickX > THUMBSTICK_THRESHOLD);
 	bool bIsRightPressed = (Value > THUMBSTICK_THRESHOLD);
 
-	// ==================== 3. 只在新按下且上一帧未按下的情况下标为"按下"====================
+	// ==================== 2. 只在新按下且上一帧未按下的情况下标为"按下"====================
 	if (bIsLeftPressed && !bWasLeftPressed)
 	{
 		// 向左切换目标
-		SwitchLockOnTargetLeft();
-		LastTargetSwitchTime = CurrentTime; // 记录操作时间，启动冷却
-		
-		if (bEnableLockOnDebugLogs)
-		{
-			UE_LOG(LogTemp, Log, TEXT("HandleRightStickX: Switched target LEFT (Value=%.2f)"), Value);
-		}
+		SubmitBufferedInput(ESoulInputCommand::SwitchTargetLeft, TargetSwitchInputBufferWindow);
 	}
 	else if (bIsRightPressed && !bWasRightPressed)
 	{
 		// 向右切换目标
-		SwitchLockOnTargetRight();
-		LastTargetSwitchTime = CurrentTime; // 记录操作时间，启动冷却
-		
-		if (bEnableLockOnDebugLogs)
-		{
-			UE_LOG(LogTemp, Log, TEXT("HandleRightStickX: Switched target RIGHT (Value=%.2f)"), Value);
-		}
+		SubmitBufferedInput(ESoulInputCommand::SwitchTargetRight, TargetSwitchInputBufferWindow);
 	}
 
-	// ==================== 4. 记录这一帧的值（用于下次边缘检测）====================
+	// ==================== 3. 记录这一帧的值（用于下次边缘检测）====================
 	LastRightStickX = Value;
 }
 
@@ -2099,7 +2110,114 @@ void AMyCharacter::UpdateLockOnCamera()
 
 void AMyCharacter::HandleLockOnButton()
 {
-	ToggleLockOn();
+	SubmitBufferedInput(ESoulInputCommand::ToggleLockOn, LockOnInputBufferWindow);
+}
+
+void AMyCharacter::HandleDodgeButton()
+{
+	// 优先取本帧的移动输入，没有时取上一帧
+	FVector Direction = GetPendingMovementInputVector();
+	if (Direction.IsNearlyZero())
+	{
+		Direction = GetLastMovementInputVector();
+	}
+
+	SubmitBufferedInput(ESoulInputCommand::Dodge, DodgeInputBufferWindow, Direction);
+}
+
+void AMyCharacter::HandleSwitchTargetLeftButton()
+{
+	// 未锁定时的切换输入直接丢弃，不进缓冲，否则会在随后锁定时立刻跳到第二个目标
+	if (!bIsLockedOn)
+	{
+		return;
+	}
+	SubmitBufferedInput(ESoulInputCommand::SwitchTargetLeft, TargetSwitchInputBufferWindow);
+}
+
+void AMyCharacter::HandleSwitchTargetRightButton()
+{
+	if (!bIsLockedOn)
+	{
+		return;
+	}
+	SubmitBufferedInput(ESoulInputCommand::SwitchTargetRight, TargetSwitchInputBufferWindow);
+}
+
+void AMyCharacter::SubmitBufferedInput(ESoulInputCommand Command, float Window, const FVector& Direction)
+{
+	UWorld* World = GetWorld();
+	if (USoulInputBufferSubsystem* InputBuffer = World ? World->GetSubsystem<USoulInputBufferSubsystem>() : nullptr)
+	{
+		InputBuffer->SubmitCommand(this, Command, Window, Direction);
+	}
+	else
+	{
+		TryCommitBufferedInput(Command, Direction);
+	}
+}
+
+bool AMyCharacter::TryCommitBufferedInput(ESoulInputCommand Command, const FVector& Direction)
+{
+	// 处决期间不接受闪避和锁定切换
+	const bool bIsExecuting = ExecutionComponent && ExecutionComponent->IsExecuting();
+
+	switch (Command)
+	{
+	case ESoulInputCommand::Dodge:
+	{
+		if (bIsExecuting || !DodgeComponent)
+		{
+			return false;
+		}
+
+		// 没有方向输入时向后撤步
+		const FVector DodgeDirection = Direction.IsNearlyZero() ? -GetActorForwardVector() : Direction;
+		return DodgeComponent->StartDodge(DodgeDirection);
+	}
+
+	case ESoulInputCommand::ToggleLockOn:
+	{
+		if (bIsExecuting)
+		{
+			return false;
+		}
+
+		ToggleLockOn();
+		return true;
+	}
+
+	case ESoulInputCommand::SwitchTargetLeft:
+	case ESoulInputCommand::SwitchTargetRight:
+	{
+		// 未锁定或仍在切换冷却中
+		const float CurrentTime = GetWorld()->GetTimeSeconds();
+		if (!bIsLockedOn || CurrentTime - LastTargetSwitchTime < TargetSwitchCooldown)
+		{
+			return false;
+		}
+
+		const bool bLeft = Command == ESoulInputCommand::SwitchTargetLeft;
+		if (bLeft)
+		{
+			SwitchLockOnTargetLeft();
+		}
+		else
+		{
+			SwitchLockOnTargetRight();
+		}
+		LastTargetSwitchTime = CurrentTime; // 记录操作时间，启动冷却
+
+		if (bEnableLockOnDebugLogs)
+		{
+			UE_LOG(LogTemp, Log, TEXT("TryCommitBufferedInput: Switched target %s"), bLeft ? TEXT("LEFT") : TEXT("RIGHT"));
+		}
+		return true;
+	}
+
+	default:
+		return false;
+	}
 }
 
 void AMyCharacter::ShowLockOnWidget()
@@ -14,6 +14,7 @@
 #include "CameraDebugComponent.h"
 #include "LockOnConfig.h"
 #include "CameraSetupConfig.h"
+#include "SoulInputBufferSubsystem.h"
 #include "MyCharacter.generated.h"
 
 // 前置声明
@@ -250,6 +251,19 @@ protected:
 	bool bShouldSmoothSwitchCamera = false;		// 相机是否需要平滑切换
 	bool bShouldSmoothSwitchCharacter = false;	// 角色是否需要平滑切换
 
+	// ==================== 输入缓冲 ====================
+	/** 闪避输入缓冲窗口（秒），按下时不能闪避则在窗口内第一帧可闪避时执行，0 表示不缓冲 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Buffer", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float DodgeInputBufferWindow = 0.2f;
+
+	/** 锁定切换输入缓冲窗口（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Buffer", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float LockOnInputBufferWindow = 0.15f;
+
+	/** 切换目标输入缓冲窗口（秒），覆盖切换冷却期间的输入 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Buffer", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float TargetSwitchInputBufferWindow = 0.2f;
+
 	// 新增：相机跟随控制
 	bool bShouldCameraFollowTarget = true;		// 相机是否应该跟随目标
 	bool bShouldCharacterRotateToTarget = true; // 角色身体是否应该转向目标
@@ -385,6 +399,16 @@ protected:
 	// 锁定按钮处理
 	void HandleLockOnButton();
 
+	// 闪避按钮处理
+	void HandleDodgeButton();
+
+	// 切换目标按钮处理
+	void HandleSwitchTargetLeftButton();
+	void HandleSwitchTargetRightButton();
+
+	// 输入经过缓冲提交（没有输入缓冲时直接执行）
+	void SubmitBufferedInput(ESoulInputCommand Command, float Window, const FVector& Direction = FVector::ZeroVector);
+
 	// 调试函数
 	void DebugInputTest();
 
@@ -555,6 +579,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lock On System")
 	FVector GetSizeBasedSocketOffset(AActor* Target) const;
 
+	// ==================== 输入缓冲 ====================
+	/**
+	 * 指令当前合法则执行并返回 true，否则返回 false 留在缓冲中
+	 * 由 USoulInputBufferSubsystem 在按下当帧及之后每帧调用
+	 */
+	bool TryCommitBufferedInput(ESoulInputCommand Command, const FVector& Direction);
+
 private:
 	// ==================== 相机组件查找辅助函数 ====================
 	/** 查找CameraBoom组件（多策略容错） */
@@ -1,12 +1,228 @@
 #include "PerformanceProfiler.h"
+#include "SoulMetricsWriter.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "HAL/PlatformFileManager.h"
 #include "Misc/DateTime.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "HAL/FileManager.h"
 
 // ǰ������
 class USoulDebugSettings;
 
+// ==================== 预算看门狗控制台命令 ====================
+
+static FAutoConsoleCommand CmdSetScopeBudget(
+	TEXT("Soul.Profiler.Budget"),
+	TEXT("Set per-frame budget for a profiler scope: Soul.Profiler.Budget <ScopeName> <Ms> (Ms <= 0 removes)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() < 2)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Usage: Soul.Profiler.Budget <ScopeName> <Ms>"));
+			return;
+		}
+
+		const float BudgetMs = FCString::Atof(*Args[1]);
+		for (TObjectIterator<UPerformanceProfiler> It; It; ++It)
+		{
+			if (!It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				It->SetScopeBudget(Args[0], BudgetMs);
+			}
+		}
+	})
+);
+
+static FAutoConsoleCommand CmdSetFrameBudget(
+	TEXT("Soul.Profiler.FrameBudget"),
+	TEXT("Set budget for the summed time of all profiler scopes in one frame: Soul.Profiler.FrameBudget <Ms> (0 disables)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Usage: Soul.Profiler.FrameBudget <Ms>"));
+			return;
+		}
+
+		const float BudgetMs = FCString::Atof(*Args[0]);
+		for (TObjectIterator<UPerformanceProfiler> It; It; ++It)
+		{
+			if (!It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				It->SetFrameBudget(BudgetMs);
+			}
+		}
+	})
+);
+
+static FAutoConsoleCommand CmdSetSampleRate(
+	TEXT("Soul.Profiler.SampleRate"),
+	TEXT("Measure one in N scope calls: Soul.Profiler.SampleRate <N> [ScopeName] (no scope sets the default; N <= 0 clears a scope override)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Usage: Soul.Profiler.SampleRate <N> [ScopeName]"));
+			return;
+		}
+
+		const int32 SampleRate = FCString::Atoi(*Args[0]);
+		for (TObjectIterator<UPerformanceProfiler> It; It; ++It)
+		{
+			if (It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				continue;
+			}
+
+			if (Args.Num() > 1)
+			{
+				It->SetScopeSampleRate(Args[1], SampleRate);
+			}
+			else
+			{
+				It->SetDefaultSampleRate(SampleRate);
+			}
+		}
+	})
+);
+
+static FAutoConsoleCommand CmdMeasureScopeOverhead(
+	TEXT("Soul.Profiler.MeasureOverhead"),
+	TEXT("Measure per-scope profiler overhead in each mode: Soul.Profiler.MeasureOverhead [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000000;
+		for (TObjectIterator<UPerformanceProfiler> It; It; ++It)
+		{
+			if (!It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				It->MeasureScopeOverhead(Iterations);
+			}
+		}
+	})
+);
+
+static FAutoConsoleCommand CmdStreamMetrics(
+	TEXT("Soul.Profiler.Stream"),
+	TEXT("Stream per-frame scope metrics to disk on a writer thread: Soul.Profiler.Stream <csv|bin|stop> [FilePrefix]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString Mode = Args.Num() > 0 ? Args[0] : TEXT("csv");
+		const FString Prefix = Args.Num() > 1 ? Args[1] : TEXT("Soak");
+		for (TObjectIterator<UPerformanceProfiler> It; It; ++It)
+		{
+			if (It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				continue;
+			}
+
+			if (Mode.Equals(TEXT("stop"), ESearchCase::IgnoreCase))
+			{
+				It->StopMetricsStream();
+			}
+			else
+			{
+				It->StartMetricsStream(Mode.Equals(TEXT("bin"), ESearchCase::IgnoreCase)
+					? EProfilerMetricsFormat::Binary : EProfilerMetricsFormat::Csv, Prefix);
+			}
+		}
+	})
+);
+
+static FAutoConsoleCommand CmdConvertMetrics(
+	TEXT("Soul.Profiler.ConvertMetrics"),
+	TEXT("Convert a binary metrics file to CSV: Soul.Profiler.ConvertMetrics <InFile> [OutFile]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Usage: Soul.Profiler.ConvertMetrics <InFile> [OutFile]"));
+			return;
+		}
+
+		const FString OutPath = Args.Num() > 1 ? Args[1] : FPaths::ChangeExtension(Args[0], TEXT("csv"));
+		FSoulMetricsWriter::ConvertBinaryToCsv(Args[0], OutPath);
+	})
+);
+
+static FAutoConsoleCommand CmdSaveBaseline(
+	TEXT("Soul.Profiler.SaveBaseline"),
+	TEXT("Save the current performance report as a baseline: Soul.Profiler.SaveBaseline <Name>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString BaselineName = Args.Num() > 0 ? Args[0] : TEXT("Default");
+		for (TObjectIterator<UPerformanceProfiler> It; It; ++It)
+		{
+			if (!It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				It->SavePerformanceBaseline(BaselineName);
+			}
+		}
+	})
+);
+
+static FAutoConsoleCommand CmdCompareBaseline(
+	TEXT("Soul.Profiler.CompareBaseline"),
+	TEXT("Compare against a baseline and log an error for each regressed scope: Soul.Profiler.CompareBaseline <Name> [P50Percent=10] [P99Percent=20] [ScopePrefix...] (default prefixes: Camera, TargetDetection)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString BaselineName = Args.Num() > 0 ? Args[0] : TEXT("Default");
+		const float P50Threshold = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 10.0f;
+		const float P99Threshold = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 20.0f;
+
+		TArray<FString> Prefixes;
+		for (int32 i = 3; i < Args.Num(); ++i)
+		{
+			Prefixes.Add(Args[i]);
+		}
+		if (Prefixes.Num() == 0)
+		{
+			Prefixes.Add(TEXT("Camera"));
+			Prefixes.Add(TEXT("TargetDetection"));
+		}
+
+		for (TObjectIterator<UPerformanceProfiler> It; It; ++It)
+		{
+			if (!It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				TArray<FPerformanceScopeDelta> Deltas;
+				It->ComparePerformanceToBaseline(BaselineName, P50Threshold, P99Threshold, Prefixes, Deltas);
+			}
+		}
+	})
+);
+
+static FAutoConsoleCommand CmdDumpFrameHistory(
+	TEXT("Soul.Profiler.DumpFrames"),
+	TEXT("Dump the profiler frame history ring buffer to CSV"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		for (TObjectIterator<UPerformanceProfiler> It; It; ++It)
+		{
+			if (!It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				It->DumpFrameHistory(TEXT("Manual"));
+			}
+		}
+	})
+);
+
+UPerformanceProfiler* UPerformanceProfiler::ActiveProfiler = nullptr;
+TArray<UPerformanceProfiler*> UPerformanceProfiler::LiveProfilers;
+bool UPerformanceProfiler::bProfilingActive = false;
+int32 UPerformanceProfiler::SamplingGeneration = 0;
+
 // UPerformanceProfilerʵ��
 
 void UPerformanceProfiler::Initialize(FSubsystemCollectionBase& Collection)
@@ -21,6 +237,23 @@ void UPerformanceProfiler::Initialize(FSubsystemCollectionBase& Collection)
 	
 	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Performance monitoring %s"), 
 		bIsPerformanceMonitoringEnabled ? TEXT("ENABLED") : TEXT("DISABLED"));
+
+	// 帧预算看门狗：默认给相机管线一个 0.3ms 的预算
+	ScopeBudgets.Reset();
+	ScopeBudgets.Add(TEXT("CameraPipeline.Tick"), 0.3f);
+	CurrentFrameScopes.Reset();
+	FrameHistory.SetNum(FrameHistorySize);
+	FrameHistoryHead = 0;
+	FrameHistoryCount = 0;
+	PendingDumps.Reset();
+
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UPerformanceProfiler::OnEndFrame);
+
+	// 作用域通过静态指针直接找到分析器，不再每次查找 World
+	// 多个游戏实例并存时（PIE多客户端）最新初始化的实例生效
+	LiveProfilers.Add(this);
+	ActiveProfiler = this;
+	UpdateProfilingActiveState();
 }
 
 void UPerformanceProfiler::Deinitialize()
@@ -31,6 +264,25 @@ void UPerformanceProfiler::Deinitialize()
 		PrintPerformanceReport();
 	}
 	
+	StopMetricsStream();
+
+	if (EndFrameHandle.IsValid())
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+		EndFrameHandle.Reset();
+	}
+
+	// 只有自己是激活实例时才交出，交给仍存活的最新实例
+	LiveProfilers.Remove(this);
+	if (ActiveProfiler == this)
+	{
+		ActiveProfiler = LiveProfilers.Num() > 0 ? LiveProfilers.Last() : nullptr;
+	}
+	UpdateProfilingActiveState();
+
+	PendingDumps.Reset();
+	FrameHistory.Reset();
+	CurrentFrameScopes.Reset();
 	PerformanceMap.Reset();
 	Super::Deinitialize();
 }
@@ -57,6 +309,27 @@ void UPerformanceProfiler::RecordFunctionTime(const FString& FunctionName, float
 	FPerformanceData& Data = PerformanceMap[FunctionName];
 	UpdatePerformanceStatistics(Data, ElapsedTime);
 
+	// 分位数样本窗口（环形覆盖最旧的样本）
+	FScopeSampleWindow& Window = SampleWindows.FindOrAdd(FunctionName);
+	if (Window.Samples.Num() < PERCENTILE_WINDOW_SIZE)
+	{
+		Window.Samples.Add(ElapsedTime);
+	}
+	else
+	{
+		Window.Samples[Window.NextIndex] = ElapsedTime;
+		Window.NextIndex = (Window.NextIndex + 1) % PERCENTILE_WINDOW_SIZE;
+	}
+
+	// 累积到当前帧，供帧预算看门狗使用
+	if (bIsBudgetWatchdogEnabled || MetricsWriter.IsValid())
+	{
+		FFrameScopeSample& Sample = CurrentFrameScopes.FindOrAdd(FunctionName);
+		Sample.TotalTime += ElapsedTime;
+		Sample.MaxTime = FMath::Max(Sample.MaxTime, ElapsedTime);
+		Sample.CallCount++;
+	}
+
 	// ��ϸ������־
 	UE_LOG(LogTemp, VeryVerbose, TEXT("PerformanceProfiler: Recorded %s - Time: %.3fms (Avg: %.3fms, Max: %.3fms, Calls: %d)"), 
 		*FunctionName, ElapsedTime, Data.AverageTime, Data.MaxTime, Data.CallCount);
@@ -68,7 +341,11 @@ TArray<FPerformanceData> UPerformanceProfiler::GetPerformanceReport()
 	
 	for (const auto& Pair : PerformanceMap)
 	{
-		Report.Add(Pair.Value);
+		FPerformanceData& Entry = Report.Add_GetRef(Pair.Value);
+		if (const FScopeSampleWindow* Window = SampleWindows.Find(Pair.Key))
+		{
+			ComputePercentiles(*Window, Entry.P50Time, Entry.P99Time);
+		}
 	}
 	
 	// ��ƽ��ִ��ʱ�併������
@@ -84,6 +361,8 @@ void UPerformanceProfiler::ResetPerformanceData()
 {
 	int32 PreviousCount = PerformanceMap.Num();
 	PerformanceMap.Reset();
+	SampleWindows.Reset();
+	CounterStats.Reset();
 	
 	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Reset performance data (%d functions cleared)"), PreviousCount);
 }
@@ -106,11 +385,11 @@ void UPerformanceProfiler::PrintPerformanceReport()
 	TArray<FPerformanceData> SortedReport = GetPerformanceReport();
 
 	// ��ӡ��ͷ
-	UE_LOG(LogTemp, Warning, TEXT("%-40s | %10s | %10s | %10s | %8s"), 
-		TEXT("Function Name"), TEXT("Avg (ms)"), TEXT("Max (ms)"), TEXT("Min (ms)"), TEXT("Calls"));
-	UE_LOG(LogTemp, Warning, TEXT("%-40s-|-%10s-|-%10s-|-%10s-|-%8s"), 
+	UE_LOG(LogTemp, Warning, TEXT("%-40s | %10s | %10s | %10s | %10s | %10s | %8s | %6s"), 
+		TEXT("Function Name"), TEXT("Avg (ms)"), TEXT("P50 (ms)"), TEXT("P99 (ms)"), TEXT("Max (ms)"), TEXT("Min (ms)"), TEXT("Calls"), TEXT("Sample"));
+	UE_LOG(LogTemp, Warning, TEXT("%-40s-|-%10s-|-%10s-|-%10s-|-%10s-|-%10s-|-%8s-|-%6s"), 
 		TEXT("----------------------------------------"), 
-		TEXT("----------"), TEXT("----------"), TEXT("----------"), TEXT("--------"));
+		TEXT("----------"), TEXT("----------"), TEXT("----------"), TEXT("----------"), TEXT("----------"), TEXT("--------"), TEXT("------"));
 
 	// ��ӡÿ����������������
 	for (const FPerformanceData& Data : SortedReport)
@@ -124,12 +403,15 @@ void UPerformanceProfiler::PrintPerformanceReport()
 		// ������Сʱ����ʾֵ
 		float MinTimeDisplay = (Data.MinTime == FLT_MAX) ? 0.0f : Data.MinTime;
 
-		UE_LOG(LogTemp, Warning, TEXT("%-40s | %10s | %10s | %10s | %8d"), 
+		UE_LOG(LogTemp, Warning, TEXT("%-40s | %10s | %10s | %10s | %10s | %10s | %8d | %6s"), 
 			*FunctionDisplayName,
 			*FormatTime(Data.AverageTime),
+			*FormatTime(Data.P50Time),
+			*FormatTime(Data.P99Time),
 			*FormatTime(Data.MaxTime),
 			*FormatTime(MinTimeDisplay),
-			Data.CallCount);
+			Data.CallCount,
+			*FString::Printf(TEXT("1/%d"), Data.SampleRate));
 	}
 
 	UE_LOG(LogTemp, Warning, TEXT(""));
@@ -156,6 +438,23 @@ void UPerformanceProfiler::PrintPerformanceReport()
 	UE_LOG(LogTemp, Warning, TEXT("- Total execution time: %s"), *FormatTime(TotalTime));
 	UE_LOG(LogTemp, Warning, TEXT("- Total function calls: %d"), TotalCalls);
 	UE_LOG(LogTemp, Warning, TEXT("- Slowest function: %s (avg: %s)"), *SlowestFunction, *FormatTime(MaxAvgTime));
+
+	// 计数器与耗时放在同一份报告里，方便对照尖峰原因
+	const TArray<FPerformanceCounterData> Counters = GetCounterReport();
+	if (Counters.Num() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT(""));
+		UE_LOG(LogTemp, Warning, TEXT("COUNTERS (per frame):"));
+		UE_LOG(LogTemp, Warning, TEXT("%-40s | %10s | %10s | %10s | %12s"),
+			TEXT("Counter Name"), TEXT("Last"), TEXT("Avg"), TEXT("Max"), TEXT("Total"));
+		for (const FPerformanceCounterData& Counter : Counters)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%-40s | %10d | %10.2f | %10d | %12lld"),
+				*Counter.CounterName, Counter.LastFrameValue, Counter.AveragePerFrame, Counter.MaxPerFrame,
+				static_cast<long long>(Counter.TotalCount));
+		}
+	}
+
 	UE_LOG(LogTemp, Warning, TEXT("=============================="));
 	UE_LOG(LogTemp, Warning, TEXT(""));
 }
@@ -184,6 +483,8 @@ void UPerformanceProfiler::SetPerformanceMonitoringEnabled(bool bEnabled)
 	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Performance monitoring %s -> %s"), 
 		bPreviousState ? TEXT("ENABLED") : TEXT("DISABLED"),
 		bEnabled ? TEXT("ENABLED") : TEXT("DISABLED"));
+
+	UpdateProfilingActiveState();
 	
 	if (!bEnabled && PerformanceMap.Num() > 0)
 	{
@@ -259,29 +560,891 @@ FString UPerformanceProfiler::FormatTime(float TimeInMs) const
 	}
 }
 
-// FSoulPerformanceScopeʵ��
+// ==================== 帧预算看门狗 ====================
+
+void UPerformanceProfiler::SetScopeBudget(const FString& ScopeName, float BudgetMs)
+{
+	if (ScopeName.IsEmpty())
+	{
+		return;
+	}
+
+	if (BudgetMs <= 0.0f)
+	{
+		ScopeBudgets.Remove(ScopeName);
+		UE_LOG(LogTemp, Log, TEXT("PerformanceProfiler: Budget removed for %s"), *ScopeName);
+		return;
+	}
+
+	ScopeBudgets.Add(ScopeName, BudgetMs);
+	UE_LOG(LogTemp, Log, TEXT("PerformanceProfiler: Budget for %s set to %.3fms"), *ScopeName, BudgetMs);
+}
+
+void UPerformanceProfiler::SetFrameBudget(float BudgetMs)
+{
+	FrameBudgetMs = FMath::Max(0.0f, BudgetMs);
+	UE_LOG(LogTemp, Log, TEXT("PerformanceProfiler: Frame budget %s"),
+		FrameBudgetMs > 0.0f ? *FString::Printf(TEXT("set to %.3fms"), FrameBudgetMs) : TEXT("disabled"));
+}
+
+TArray<FPerformanceBudget> UPerformanceProfiler::GetScopeBudgets() const
+{
+	TArray<FPerformanceBudget> Budgets;
+	Budgets.Reserve(ScopeBudgets.Num());
+	for (const auto& Pair : ScopeBudgets)
+	{
+		Budgets.Add(FPerformanceBudget(Pair.Key, Pair.Value));
+	}
+	return Budgets;
+}
+
+void UPerformanceProfiler::SetBudgetWatchdogEnabled(bool bEnabled)
+{
+	bIsBudgetWatchdogEnabled = bEnabled;
+	CurrentFrameScopes.Reset();
+	PendingDumps.Reset();
+}
+
+void UPerformanceProfiler::SetFrameCaptureSettings(int32 HistoryFrames, int32 NeighborFrames)
+{
+	NeighborFrameCount = FMath::Clamp(NeighborFrames, 0, 60);
+
+	// 环形缓冲至少要能容纳超标帧前后的邻近帧
+	FrameHistorySize = FMath::Clamp(HistoryFrames, NeighborFrameCount * 2 + 1, 3600);
+	FrameHistory.Reset();
+	FrameHistory.SetNum(FrameHistorySize);
+	FrameHistoryHead = 0;
+	FrameHistoryCount = 0;
+	PendingDumps.Reset();
+}
+
+FString UPerformanceProfiler::DumpFrameHistory(const FString& Reason)
+{
+	return WriteFrameDump(0, Reason);
+}
+
+void UPerformanceProfiler::OnEndFrame()
+{
+	// 汇总本帧所有线程的计数器（即使看门狗关闭，计数器统计也要更新）
+	if (bIsPerformanceMonitoringEnabled)
+	{
+		FSoulCounters::CollectFrame(CurrentFrameCounters);
+		UpdateCounterStatistics(CurrentFrameCounters);
+	}
+
+	const bool bStreamingMetrics = MetricsWriter.IsValid();
+	if (!bIsPerformanceMonitoringEnabled || (!bIsBudgetWatchdogEnabled && !bStreamingMetrics) || FrameHistory.Num() == 0)
+	{
+		CurrentFrameScopes.Reset();
+		return;
+	}
+
+	// 封存当前帧到环形缓冲，复用槽位中已分配的数组
+	FProfilerFrameRecord& Record = FrameHistory[FrameHistoryHead];
+	Record.FrameNumber = GFrameCounter;
+	Record.FrameTimeMs = static_cast<float>(FApp::GetDeltaTime() * 1000.0);
+	Record.ScopeTotalMs = 0.0f;
+	Record.Scopes.Reset();
+	Record.CounterValues.Reset();
+	Record.CounterValues.Append(CurrentFrameCounters);
+
+	for (auto& Pair : CurrentFrameScopes)
+	{
+		FFrameScopeSample& Sample = Pair.Value;
+		if (Sample.CallCount == 0)
+		{
+			continue;
+		}
+
+		Sample.ScopeName = Pair.Key;
+		Record.ScopeTotalMs += Sample.TotalTime;
+		Record.Scopes.Add(Sample);
+
+		// 清零但保留键，下一帧不必重新分配
+		Sample.TotalTime = 0.0f;
+		Sample.MaxTime = 0.0f;
+		Sample.CallCount = 0;
+	}
+
+	FrameHistoryHead = (FrameHistoryHead + 1) % FrameHistory.Num();
+	FrameHistoryCount = FMath::Min(FrameHistoryCount + 1, FrameHistory.Num());
+
+	// 写入线程落盘，这里只做序列化
+	if (bStreamingMetrics)
+	{
+		MetricsWriter->SubmitFrame(Record);
+	}
+
+	if (!bIsBudgetWatchdogEnabled)
+	{
+		return;
+	}
+
+	// 先推进已有的待转储请求，本帧新产生的请求从下一帧开始计数
+	for (int32 i = PendingDumps.Num() - 1; i >= 0; --i)
+	{
+		FPendingBudgetDump& Pending = PendingDumps[i];
+		if (--Pending.FramesRemaining <= 0)
+		{
+			WriteFrameDump(Pending.ViolationFrame, Pending.Reason);
+			PendingDumps.RemoveAtSwap(i);
+		}
+	}
+
+	CheckFrameBudgets(Record);
+}
+
+void UPerformanceProfiler::CheckFrameBudgets(const FProfilerFrameRecord& Record)
+{
+	TArray<FPerformanceBudgetViolation, TInlineAllocator<4>> Violations;
+
+	for (const FFrameScopeSample& Sample : Record.Scopes)
+	{
+		const float* BudgetMs = ScopeBudgets.Find(Sample.ScopeName);
+		if (BudgetMs && Sample.TotalTime > *BudgetMs)
+		{
+			FPerformanceBudgetViolation& Violation = Violations.AddDefaulted_GetRef();
+			Violation.ScopeName = Sample.ScopeName;
+			Violation.MeasuredMs = Sample.TotalTime;
+			Violation.BudgetMs = *BudgetMs;
+			Violation.FrameNumber = static_cast<int32>(Record.FrameNumber);
+		}
+	}
+
+	if (FrameBudgetMs > 0.0f && Record.ScopeTotalMs > FrameBudgetMs)
+	{
+		FPerformanceBudgetViolation& Violation = Violations.AddDefaulted_GetRef();
+		Violation.ScopeName = TEXT("Frame");
+		Violation.MeasuredMs = Record.ScopeTotalMs;
+		Violation.BudgetMs = FrameBudgetMs;
+		Violation.FrameNumber = static_cast<int32>(Record.FrameNumber);
+	}
+
+	if (Violations.Num() == 0)
+	{
+		return;
+	}
+
+	for (const FPerformanceBudgetViolation& Violation : Violations)
+	{
+		OnBudgetExceeded.Broadcast(Violation);
+	}
+
+	// 持续超标时只按最小间隔转储一次，避免每帧写盘
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastDumpTime < MinDumpIntervalSeconds)
+	{
+		return;
+	}
+	LastDumpTime = Now;
+
+	const FPerformanceBudgetViolation& First = Violations[0];
+	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Budget exceeded at frame %llu - %s %.3fms > %.3fms"),
+		Record.FrameNumber, *First.ScopeName, First.MeasuredMs, First.BudgetMs);
+
+	FPendingBudgetDump Pending;
+	Pending.ViolationFrame = Record.FrameNumber;
+	Pending.FramesRemaining = NeighborFrameCount;
+	Pending.Reason = FString::Printf(TEXT("%s %.3fms > %.3fms"), *First.ScopeName, First.MeasuredMs, First.BudgetMs);
+
+	if (Pending.FramesRemaining <= 0)
+	{
+		WriteFrameDump(Pending.ViolationFrame, Pending.Reason);
+	}
+	else
+	{
+		PendingDumps.Add(Pending);
+	}
+}
+
+const FProfilerFrameRecord& UPerformanceProfiler::GetHistoryFrame(int32 OrderedIndex) const
+{
+	// OrderedIndex 0 是缓冲中最旧的一帧
+	const int32 Oldest = (FrameHistoryHead - FrameHistoryCount + FrameHistory.Num()) % FrameHistory.Num();
+	return FrameHistory[(Oldest + OrderedIndex) % FrameHistory.Num()];
+}
+
+FString UPerformanceProfiler::WriteFrameDump(uint64 CenterFrame, const FString& Reason) const
+{
+	if (FrameHistoryCount == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: No frame history to dump"));
+		return FString();
+	}
+
+	FString Csv;
+	Csv.Reserve(FrameHistoryCount * 128);
+	Csv += FString::Printf(TEXT("# Soul performance budget dump\n# Reason: %s\n# Generated at: %s\n"),
+		*Reason, *FDateTime::Now().ToString());
+	Csv += TEXT("Frame,FrameTimeMs,ScopeTotalMs,Scope,ScopeTotalTimeMs,ScopeMaxTimeMs,Calls,BudgetMs,Flag\n");
+
+	int32 FramesWritten = 0;
+	for (int32 i = 0; i < FrameHistoryCount; ++i)
+	{
+		const FProfilerFrameRecord& Record = GetHistoryFrame(i);
+		if (CenterFrame != 0)
+		{
+			const int64 Offset = static_cast<int64>(Record.FrameNumber) - static_cast<int64>(CenterFrame);
+			if (FMath::Abs(Offset) > NeighborFrameCount)
+			{
+				continue;
+			}
+		}
+
+		const TCHAR* FrameFlag = (Record.FrameNumber == CenterFrame) ? TEXT("VIOLATION") : TEXT("");
+
+		if (Record.Scopes.Num() == 0)
+		{
+			Csv += FString::Printf(TEXT("%llu,%.3f,%.3f,,,,,,%s\n"),
+				Record.FrameNumber, Record.FrameTimeMs, Record.ScopeTotalMs, FrameFlag);
+		}
+
+		for (const FFrameScopeSample& Sample : Record.Scopes)
+		{
+			const float* BudgetMs = ScopeBudgets.Find(Sample.ScopeName);
+			const bool bOverBudget = BudgetMs && Sample.TotalTime > *BudgetMs;
+
+			Csv += FString::Printf(TEXT("%llu,%.3f,%.3f,%s,%.4f,%.4f,%d,%.3f,%s\n"),
+				Record.FrameNumber, Record.FrameTimeMs, Record.ScopeTotalMs,
+				*Sample.ScopeName, Sample.TotalTime, Sample.MaxTime, Sample.CallCount,
+				BudgetMs ? *BudgetMs : 0.0f,
+				bOverBudget ? TEXT("OVER") : FrameFlag);
+		}
+
+		// 计数器行：Calls 列为本帧计数
+		for (int32 CounterId = 0; CounterId < Record.CounterValues.Num(); ++CounterId)
+		{
+			if (Record.CounterValues[CounterId] != 0)
+			{
+				Csv += FString::Printf(TEXT("%llu,%.3f,%.3f,counter:%s,,,%d,,%s\n"),
+					Record.FrameNumber, Record.FrameTimeMs, Record.ScopeTotalMs,
+					*FSoulCounters::GetName(CounterId), Record.CounterValues[CounterId], FrameFlag);
+			}
+		}
+
+		++FramesWritten;
+	}
+
+	const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("SoulBudget"),
+		FString::Printf(TEXT("BudgetDump_%s_%llu.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")), CenterFrame));
+
+	// 在后台线程写盘，超标帧附近不再叠加一次同步I/O
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Csv = MoveTemp(Csv), FilePath, FramesWritten]()
+	{
+		if (!FFileHelper::SaveStringToFile(Csv, *FilePath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("PerformanceProfiler: Failed to write budget dump to %s"), *FilePath);
+			return;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Wrote %d frames to %s"), FramesWritten, *FilePath);
+	});
+
+	return FilePath;
+}
+
+// ==================== 采样模式 ====================
+
+void UPerformanceProfiler::SetDefaultSampleRate(int32 SampleRate)
+{
+	DefaultSampleRate = FMath::Max(1, SampleRate);
+	UpdateProfilingActiveState();
+
+	UE_LOG(LogTemp, Log, TEXT("PerformanceProfiler: Default sample rate set to 1/%d"), DefaultSampleRate);
+}
+
+void UPerformanceProfiler::SetScopeSampleRate(const FString& ScopeName, int32 SampleRate)
+{
+	if (ScopeName.IsEmpty())
+	{
+		return;
+	}
+
+	if (SampleRate <= 0)
+	{
+		ScopeSampleRates.Remove(ScopeName);
+	}
+	else
+	{
+		ScopeSampleRates.Add(ScopeName, SampleRate);
+	}
+	UpdateProfilingActiveState();
+
+	UE_LOG(LogTemp, Log, TEXT("PerformanceProfiler: Sample rate for %s set to 1/%d"), *ScopeName, GetScopeSampleRate(ScopeName));
+}
+
+int32 UPerformanceProfiler::GetScopeSampleRate(const FString& ScopeName) const
+{
+	const int32* SampleRate = ScopeSampleRates.Find(ScopeName);
+	return SampleRate ? *SampleRate : DefaultSampleRate;
+}
+
+void UPerformanceProfiler::RecordSampledScopeTime(const TCHAR* ScopeName, float ElapsedTime, int32 SampleRate)
+{
+	const FString Name(ScopeName);
+	RecordFunctionTime(Name, ElapsedTime);
+
+	if (FPerformanceData* Data = PerformanceMap.Find(Name))
+	{
+		Data->SampleRate = SampleRate;
+	}
+}
+
+void UPerformanceProfiler::UpdateProfilingActiveState()
+{
+	bProfilingActive = SOUL_PERFORMANCE_PROFILING && ActiveProfiler && ActiveProfiler->bIsPerformanceMonitoringEnabled;
+
+	// 让所有调用点在下一次进入时刷新采样率
+	++SamplingGeneration;
+}
+
+void UPerformanceProfiler::MeasureScopeOverhead(int32 Iterations)
+{
+#if SOUL_PERFORMANCE_PROFILING
+	Iterations = FMath::Clamp(Iterations, 1000, 100000000);
+
+	static const TCHAR* ProbeScopeName = TEXT("Profiler.OverheadProbe");
+	volatile int32 Sink = 0;
+
+	auto RunBaseline = [&Sink](int32 Count)
+	{
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Sink = Sink + 1;
+		}
+		return (FPlatformTime::Seconds() - Start) * 1.0e9 / Count;
+	};
+
+	auto RunProbe = [&Sink](int32 Count)
+	{
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Count; ++i)
+		{
+			SOUL_PERFORMANCE_SCOPE(TEXT("Profiler.OverheadProbe"));
+			Sink = Sink + 1;
+		}
+		return (FPlatformTime::Seconds() - Start) * 1.0e9 / Count;
+	};
+
+	// 探针数据不进入帧历史，测量结束后恢复所有状态
+	const bool bPreviousMonitoring = bIsPerformanceMonitoringEnabled;
+	const bool bPreviousWatchdog = bIsBudgetWatchdogEnabled;
+	UPerformanceProfiler* PreviousActive = ActiveProfiler;
+	ActiveProfiler = this;
+	bIsBudgetWatchdogEnabled = false;
+
+	// 编译移除：宏展开为空，等同于基线
+	const double BaselineNs = RunBaseline(Iterations);
+
+	// 运行时关闭：只剩一次静态布尔检查
+	bIsPerformanceMonitoringEnabled = false;
+	UpdateProfilingActiveState();
+	const double DisabledNs = RunProbe(Iterations);
+
+	// 1/16 采样
+	bIsPerformanceMonitoringEnabled = true;
+	ScopeSampleRates.Add(ProbeScopeName, 16);
+	UpdateProfilingActiveState();
+	const double SampledNs = RunProbe(Iterations);
+
+	// 全量测量
+	ScopeSampleRates.Add(ProbeScopeName, 1);
+	UpdateProfilingActiveState();
+	const double FullNs = RunProbe(Iterations);
+
+	ScopeSampleRates.Remove(ProbeScopeName);
+	PerformanceMap.Remove(ProbeScopeName);
+	SampleWindows.Remove(ProbeScopeName);
+	bIsPerformanceMonitoringEnabled = bPreviousMonitoring;
+	bIsBudgetWatchdogEnabled = bPreviousWatchdog;
+	ActiveProfiler = PreviousActive;
+	UpdateProfilingActiveState();
+
+	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Scope overhead over %d iterations (ns per scope, baseline subtracted)"), Iterations);
+	UE_LOG(LogTemp, Warning, TEXT("- Compiled out:      0.0 (baseline loop %.1f ns)"), BaselineNs);
+	UE_LOG(LogTemp, Warning, TEXT("- Runtime disabled:  %.1f"), FMath::Max(0.0, DisabledNs - BaselineNs));
+	UE_LOG(LogTemp, Warning, TEXT("- Sampled 1/16:      %.1f"), FMath::Max(0.0, SampledNs - BaselineNs));
+	UE_LOG(LogTemp, Warning, TEXT("- Full:              %.1f"), FMath::Max(0.0, FullNs - BaselineNs));
+#else
+	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Profiling scopes are compiled out in this build (zero overhead)"));
+#endif
+}
+
+// ==================== 每帧计数器 ====================
+
+void UPerformanceProfiler::UpdateCounterStatistics(const TArray<int32>& FrameValues)
+{
+	if (CounterStats.Num() < FrameValues.Num())
+	{
+		const int32 FirstNew = CounterStats.Num();
+		CounterStats.SetNum(FrameValues.Num());
+		for (int32 CounterId = FirstNew; CounterId < CounterStats.Num(); ++CounterId)
+		{
+			CounterStats[CounterId].CounterName = FSoulCounters::GetName(CounterId);
+		}
+	}
+
+	for (int32 CounterId = 0; CounterId < FrameValues.Num(); ++CounterId)
+	{
+		FPerformanceCounterData& Stats = CounterStats[CounterId];
+		const int32 Value = FrameValues[CounterId];
+
+		Stats.LastFrameValue = Value;
+		Stats.TotalCount += Value;
+		Stats.MaxPerFrame = FMath::Max(Stats.MaxPerFrame, Value);
+		Stats.FrameCount++;
+		Stats.AveragePerFrame = static_cast<float>(static_cast<double>(Stats.TotalCount) / Stats.FrameCount);
+	}
+}
+
+TArray<FPerformanceCounterData> UPerformanceProfiler::GetCounterReport() const
+{
+	TArray<FPerformanceCounterData> Report;
+	for (const FPerformanceCounterData& Stats : CounterStats)
+	{
+		if (Stats.TotalCount > 0)
+		{
+			Report.Add(Stats);
+		}
+	}
+
+	Report.Sort([](const FPerformanceCounterData& A, const FPerformanceCounterData& B)
+	{
+		return A.AveragePerFrame > B.AveragePerFrame;
+	});
+
+	return Report;
+}
+
+// ==================== 基线对比 ====================
+
+void UPerformanceProfiler::ComputePercentiles(const FScopeSampleWindow& Window, float& OutP50, float& OutP99)
+{
+	OutP50 = 0.0f;
+	OutP99 = 0.0f;
+	if (Window.Samples.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<float> Sorted = Window.Samples;
+	Sorted.Sort();
+
+	const int32 LastIndex = Sorted.Num() - 1;
+	OutP50 = Sorted[FMath::Clamp(FMath::RoundToInt(LastIndex * 0.50f), 0, LastIndex)];
+	OutP99 = Sorted[FMath::Clamp(FMath::RoundToInt(LastIndex * 0.99f), 0, LastIndex)];
+}
+
+FString UPerformanceProfiler::GetBaselineFilePath(const FString& BaselineName)
+{
+	return FPaths::Combine(FPaths::ProfilingDir(), TEXT("SoulBaselines"), BaselineName + TEXT(".csv"));
+}
+
+bool UPerformanceProfiler::SavePerformanceBaseline(const FString& BaselineName)
+{
+	const TArray<FPerformanceData> Report = GetPerformanceReport();
+	if (Report.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: No performance data to save as baseline"));
+		return false;
+	}
+
+	FString Csv = TEXT("Scope,AvgMs,P50Ms,P99Ms,MaxMs,Calls,SampleRate\n");
+	for (const FPerformanceData& Data : Report)
+	{
+		Csv += FString::Printf(TEXT("%s,%.5f,%.5f,%.5f,%.5f,%d,%d\n"),
+			*Data.FunctionName, Data.AverageTime, Data.P50Time, Data.P99Time, Data.MaxTime, Data.CallCount, Data.SampleRate);
+	}
+
+	const FString FilePath = GetBaselineFilePath(BaselineName);
+	if (!FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("PerformanceProfiler: Failed to save baseline to %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Saved baseline '%s' (%d scopes) to %s"), *BaselineName, Report.Num(), *FilePath);
+	return true;
+}
+
+bool UPerformanceProfiler::ComparePerformanceToBaseline(const FString& BaselineName, float P50ThresholdPercent, float P99ThresholdPercent,
+	const TArray<FString>& ScopePrefixes, TArray<FPerformanceScopeDelta>& OutDeltas)
+{
+	OutDeltas.Reset();
+
+	const FString FilePath = GetBaselineFilePath(BaselineName);
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath) || Lines.Num() < 2)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PerformanceProfiler: Baseline '%s' not found at %s"), *BaselineName, *FilePath);
+		return false;
+	}
+
+	TMap<FString, FPerformanceData> Current;
+	for (const FPerformanceData& Data : GetPerformanceReport())
+	{
+		Current.Add(Data.FunctionName, Data);
+	}
+
+	auto MatchesPrefix = [&ScopePrefixes](const FString& ScopeName)
+	{
+		if (ScopePrefixes.Num() == 0)
+		{
+			return true;
+		}
+		for (const FString& Prefix : ScopePrefixes)
+		{
+			if (ScopeName.StartsWith(Prefix))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	auto DeltaPercent = [](float Baseline, float Now)
+	{
+		return Baseline > KINDA_SMALL_NUMBER ? (Now - Baseline) / Baseline * 100.0f : 0.0f;
+	};
+
+	int32 RegressionCount = 0;
+
+	// 第一行是表头
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		TArray<FString> Fields;
+		Lines[LineIndex].ParseIntoArray(Fields, TEXT(","), false);
+		if (Fields.Num() < 4 || !MatchesPrefix(Fields[0]))
+		{
+			continue;
+		}
+
+		FPerformanceScopeDelta& Delta = OutDeltas.AddDefaulted_GetRef();
+		Delta.ScopeName = Fields[0];
+		Delta.BaselineP50 = FCString::Atof(*Fields[2]);
+		Delta.BaselineP99 = FCString::Atof(*Fields[3]);
+
+		const FPerformanceData* Now = Current.Find(Delta.ScopeName);
+		if (!Now || Now->CallCount == 0)
+		{
+			Delta.bMissingInCurrentRun = true;
+			UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Scope %s is in baseline '%s' but has no samples in this run"),
+				*Delta.ScopeName, *BaselineName);
+			continue;
+		}
+
+		Delta.CurrentP50 = Now->P50Time;
+		Delta.CurrentP99 = Now->P99Time;
+		Delta.P50DeltaPercent = DeltaPercent(Delta.BaselineP50, Delta.CurrentP50);
+		Delta.P99DeltaPercent = DeltaPercent(Delta.BaselineP99, Delta.CurrentP99);
+
+		const bool bP50Regressed = Delta.P50DeltaPercent > P50ThresholdPercent
+			&& Delta.CurrentP50 - Delta.BaselineP50 > BASELINE_MIN_ABSOLUTE_DELTA_MS;
+		const bool bP99Regressed = Delta.P99DeltaPercent > P99ThresholdPercent
+			&& Delta.CurrentP99 - Delta.BaselineP99 > BASELINE_MIN_ABSOLUTE_DELTA_MS;
+		Delta.bRegressed = bP50Regressed || bP99Regressed;
+
+		if (Delta.bRegressed)
+		{
+			++RegressionCount;
+			UE_LOG(LogTemp, Error, TEXT("PerformanceProfiler: REGRESSION %s p50 %.4f -> %.4fms (%+.1f%%), p99 %.4f -> %.4fms (%+.1f%%)"),
+				*Delta.ScopeName, Delta.BaselineP50, Delta.CurrentP50, Delta.P50DeltaPercent,
+				Delta.BaselineP99, Delta.CurrentP99, Delta.P99DeltaPercent);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Log, TEXT("PerformanceProfiler: %s p50 %+.1f%%, p99 %+.1f%%"),
+				*Delta.ScopeName, Delta.P50DeltaPercent, Delta.P99DeltaPercent);
+		}
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Baseline '%s' comparison: %d scopes checked, %d regressed (p50 > %.1f%%, p99 > %.1f%%)"),
+		*BaselineName, OutDeltas.Num(), RegressionCount, P50ThresholdPercent, P99ThresholdPercent);
+
+	return RegressionCount == 0;
+}
+
+// ==================== 指标流式写入 ====================
+
+bool UPerformanceProfiler::StartMetricsStream(EProfilerMetricsFormat Format, const FString& FilePrefix)
+{
+	StopMetricsStream();
+
+	const FString Directory = FPaths::Combine(FPaths::ProfilingDir(), TEXT("SoulMetrics"));
+	TSharedPtr<FSoulMetricsWriter> Writer = MakeShared<FSoulMetricsWriter>(Format, Directory,
+		FilePrefix.IsEmpty() ? FString(TEXT("Soak")) : FilePrefix, MetricsMaxFileBytes, MetricsMaxFiles);
+
+	if (!Writer->Start())
+	{
+		UE_LOG(LogTemp, Error, TEXT("PerformanceProfiler: Failed to start metrics stream"));
+		return false;
+	}
+
+	MetricsWriter = Writer;
+	UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Streaming %s metrics to %s"),
+		Format == EProfilerMetricsFormat::Binary ? TEXT("binary") : TEXT("CSV"), *MetricsWriter->GetCurrentFilePath());
+	return true;
+}
+
+void UPerformanceProfiler::StopMetricsStream()
+{
+	if (!MetricsWriter.IsValid())
+	{
+		return;
+	}
+
+	// 阻塞到写入线程写完剩余数据，只在停止采集时发生
+	MetricsWriter->Shutdown();
+	MetricsWriter.Reset();
+}
+
+bool UPerformanceProfiler::IsMetricsStreaming() const
+{
+	return MetricsWriter.IsValid();
+}
+
+// FSoulScopeSampler / FSoulPerformanceScope
+
+void FSoulScopeSampler::RefreshSampleRate()
+{
+	const UPerformanceProfiler* Profiler = UPerformanceProfiler::GetActiveProfiler();
+	CachedSampleRate = Profiler ? FMath::Max(1, Profiler->GetScopeSampleRate(ScopeName)) : 1;
+	CachedGeneration = UPerformanceProfiler::GetSamplingGeneration();
+	CallCounter = 0;
+}
 
 FSoulPerformanceScope::FSoulPerformanceScope(const FString& InFunctionName)
-	: FunctionName(InFunctionName)
-	, StartTime(0.0)
+	: OwnedName(InFunctionName)
 {
-	// ��¼��ʼʱ�䣨����Ϊ��λ��
-	StartTime = FPlatformTime::Seconds();
+	// 分析器的数据表没有锁，只记录游戏线程上的作用域
+	if (UPerformanceProfiler::IsProfilingActive() && IsInGameThread())
+	{
+		ScopeName = *OwnedName;
+		StartTime = FPlatformTime::Seconds();
+	}
 }
 
-FSoulPerformanceScope::~FSoulPerformanceScope()
+void FSoulPerformanceScope::Finish()
 {
-	// ����ִ��ʱ�䣨ת��Ϊ���룩
-	double EndTime = FPlatformTime::Seconds();
-	float ElapsedTimeMs = static_cast<float>((EndTime - StartTime) * 1000.0);
-	
-	// ��ȡ���ܷ�����ʵ������¼ʱ��
-	if (GEngine && GEngine->GetCurrentPlayWorld())
+	const float ElapsedTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	if (UPerformanceProfiler* Profiler = UPerformanceProfiler::GetActiveProfiler())
+	{
+		Profiler->RecordSampledScopeTime(ScopeName, ElapsedTimeMs, SampleRate);
+	}
+}
+
+// FSoulCounters
+
+namespace SoulCounters
+{
+	/** 单个线程的计数块；只有所属线程累加，游戏线程汇总时原子交换清零 */
+	struct FThreadBlock
+	{
+		std::atomic<int32> Values[FSoulCounters::MAX_COUNTERS];
+
+		FThreadBlock()
+		{
+			for (std::atomic<int32>& Value : Values)
+			{
+				Value.store(0, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	/** 注册表：名称与所有线程的计数块（线程退出后计数块保留，数量受线程数限制） */
+	struct FRegistry
+	{
+		FCriticalSection Lock;
+		TArray<FString> Names;
+		TArray<FThreadBlock*> Blocks;
+		std::atomic<int32> NumCounters { 0 };
+	};
+
+	static FRegistry& GetRegistry()
+	{
+		static FRegistry Registry;
+		return Registry;
+	}
+
+	static FThreadBlock& GetThreadBlock()
+	{
+		static thread_local FThreadBlock* Block = nullptr;
+		if (!Block)
+		{
+			Block = new FThreadBlock();
+			FRegistry& Registry = GetRegistry();
+			FScopeLock Lock(&Registry.Lock);
+			Registry.Blocks.Add(Block);
+		}
+		return *Block;
+	}
+}
+
+int32 FSoulCounters::Register(const TCHAR* CounterName)
+{
+	SoulCounters::FRegistry& Registry = SoulCounters::GetRegistry();
+	FScopeLock Lock(&Registry.Lock);
+
+	const int32 ExistingId = Registry.Names.IndexOfByKey(FString(CounterName));
+	if (ExistingId != INDEX_NONE)
+	{
+		return ExistingId;
+	}
+
+	if (Registry.Names.Num() >= MAX_COUNTERS)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("PerformanceProfiler: Counter limit (%d) reached, %s will not be counted"), MAX_COUNTERS, CounterName);
+		return INDEX_NONE;
+	}
+
+	const int32 NewId = Registry.Names.Add(CounterName);
+	Registry.NumCounters.store(Registry.Names.Num(), std::memory_order_release);
+	return NewId;
+}
+
+void FSoulCounters::AddToThreadBlock(int32 CounterId, int32 Amount)
+{
+	SoulCounters::GetThreadBlock().Values[CounterId].fetch_add(Amount, std::memory_order_relaxed);
+}
+
+void FSoulCounters::CollectFrame(TArray<int32>& OutValues)
+{
+	SoulCounters::FRegistry& Registry = SoulCounters::GetRegistry();
+	const int32 NumCounters = Registry.NumCounters.load(std::memory_order_acquire);
+
+	OutValues.SetNumUninitialized(NumCounters);
+	for (int32& Value : OutValues)
 	{
-		UPerformanceProfiler* Profiler = UPerformanceProfiler::GetPerformanceProfiler(GEngine->GetCurrentPlayWorld());
-		if (Profiler)
+		Value = 0;
+	}
+
+	FScopeLock Lock(&Registry.Lock);
+	for (SoulCounters::FThreadBlock* Block : Registry.Blocks)
+	{
+		for (int32 CounterId = 0; CounterId < NumCounters; ++CounterId)
 		{
-			Profiler->RecordFunctionTime(FunctionName, ElapsedTimeMs);
+			OutValues[CounterId] += Block->Values[CounterId].exchange(0, std::memory_order_relaxed);
 		}
 	}
-}
\ No newline at end of file
+}
+
+int32 FSoulCounters::Num()
+{
+	return SoulCounters::GetRegistry().NumCounters.load(std::memory_order_acquire);
+}
+
+FString FSoulCounters::GetName(int32 CounterId)
+{
+	SoulCounters::FRegistry& Registry = SoulCounters::GetRegistry();
+	FScopeLock Lock(&Registry.Lock);
+	return Registry.Names.IsValidIndex(CounterId) ? Registry.Names[CounterId] : FString();
+}
+
+// ==================== 自动化测试 ====================
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SoulProfilerTests
+{
+	/** 回归门禁默认检查的作用域前缀：相机与目标检测（锁定相关） */
+	static TArray<FString> GetGatedScopePrefixes()
+	{
+		return { TEXT("Camera"), TEXT("TargetDetection") };
+	}
+
+	static void RecordSamples(UPerformanceProfiler* Profiler, const FString& ScopeName, float ElapsedTimeMs, int32 Count)
+	{
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Profiler->RecordFunctionTime(ScopeName, ElapsedTimeMs);
+		}
+	}
+}
+
+/**
+ * 对比逻辑自检：同一作用域以合成数据保存基线，再分别以不变和变慢的数据对比
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSoulProfilerBaselineCompareTest, "Soul.Profiler.BaselineCompare",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSoulProfilerBaselineCompareTest::RunTest(const FString& Parameters)
+{
+	const FString BaselineName = TEXT("AutomationBaselineCompare");
+	const TArray<FString> Prefixes = SoulProfilerTests::GetGatedScopePrefixes();
+
+	UPerformanceProfiler* Profiler = NewObject<UPerformanceProfiler>(GetTransientPackage());
+	Profiler->SetPerformanceMonitoringEnabled(true);
+
+	SoulProfilerTests::RecordSamples(Profiler, TEXT("Camera.Test"), 1.0f, 200);
+	SoulProfilerTests::RecordSamples(Profiler, TEXT("Other.Test"), 1.0f, 200);
+	TestTrue(TEXT("Baseline saved"), Profiler->SavePerformanceBaseline(BaselineName));
+
+	// 数据不变：没有回归
+	TArray<FPerformanceScopeDelta> Deltas;
+	TestTrue(TEXT("Unchanged run passes"), Profiler->ComparePerformanceToBaseline(BaselineName, 10.0f, 20.0f, Prefixes, Deltas));
+	TestEqual(TEXT("Only gated scopes are compared"), Deltas.Num(), 1);
+
+	// 相机作用域变慢 50%：判定为回归（对比函数会输出一条 REGRESSION 错误日志，属于预期）
+	AddExpectedError(TEXT("REGRESSION Camera.Test"), EAutomationExpectedErrorFlags::Contains, 1);
+	Profiler->ResetPerformanceData();
+	SoulProfilerTests::RecordSamples(Profiler, TEXT("Camera.Test"), 1.5f, 200);
+	SoulProfilerTests::RecordSamples(Profiler, TEXT("Other.Test"), 3.0f, 200);
+	TestFalse(TEXT("Regressed run fails"), Profiler->ComparePerformanceToBaseline(BaselineName, 10.0f, 20.0f, Prefixes, Deltas));
+	TestTrue(TEXT("Camera scope flagged"), Deltas.Num() == 1 && Deltas[0].bRegressed);
+
+	IFileManager::Get().Delete(*UPerformanceProfiler::GetBaselineFilePath(BaselineName));
+	return true;
+}
+
+/**
+ * 回归门禁：在游戏会话中（跑完锁定场景后）把当前数据与基线对比，相机/目标检测作用域回归时测试失败
+ * 基线名取命令行 -SoulBaseline=<Name>，阈值取 -SoulBaselineP50= / -SoulBaselineP99=（默认 10% / 20%）
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSoulProfilerRegressionGateTest, "Soul.Profiler.RegressionGate",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FSoulProfilerRegressionGateTest::RunTest(const FString& Parameters)
+{
+	FString BaselineName = TEXT("Default");
+	float P50Threshold = 10.0f;
+	float P99Threshold = 20.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("SoulBaseline="), BaselineName);
+	FParse::Value(FCommandLine::Get(), TEXT("SoulBaselineP50="), P50Threshold);
+	FParse::Value(FCommandLine::Get(), TEXT("SoulBaselineP99="), P99Threshold);
+
+	UPerformanceProfiler* Profiler = UPerformanceProfiler::GetActiveProfiler();
+	if (!Profiler)
+	{
+		AddError(TEXT("No active PerformanceProfiler; run the gate inside a game session"));
+		return false;
+	}
+
+	if (!IFileManager::Get().FileExists(*UPerformanceProfiler::GetBaselineFilePath(BaselineName)))
+	{
+		AddError(FString::Printf(TEXT("Baseline '%s' not found; save one with Soul.Profiler.SaveBaseline %s"), *BaselineName, *BaselineName));
+		return false;
+	}
+
+	TArray<FPerformanceScopeDelta> Deltas;
+	Profiler->ComparePerformanceToBaseline(BaselineName, P50Threshold, P99Threshold, SoulProfilerTests::GetGatedScopePrefixes(), Deltas);
+
+	for (const FPerformanceScopeDelta& Delta : Deltas)
+	{
+		if (Delta.bRegressed)
+		{
+			AddError(FString::Printf(TEXT("%s regressed: p50 %.4f -> %.4fms (%+.1f%%), p99 %.4f -> %.4fms (%+.1f%%)"),
+				*Delta.ScopeName, Delta.BaselineP50, Delta.CurrentP50, Delta.P50DeltaPercent,
+				Delta.BaselineP99, Delta.CurrentP99, Delta.P99DeltaPercent));
+		}
+		else if (Delta.bMissingInCurrentRun)
+		{
+			AddWarning(FString::Printf(TEXT("%s has no samples in this run"), *Delta.ScopeName));
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -1,9 +1,21 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CoreGlobals.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Delegates/IDelegateInstance.h"
+#include <atomic>
 #include "PerformanceProfiler.generated.h"
 
+/**
+ * 性能分析编译开关
+ * Shipping 构建默认关闭：SOUL_PERFORMANCE_SCOPE 展开为空，不生成任何代码
+ * 可在 Build.cs 的 PublicDefinitions 中覆盖（如 "SOUL_PERFORMANCE_PROFILING=1"）
+ */
+#ifndef SOUL_PERFORMANCE_PROFILING
+	#define SOUL_PERFORMANCE_PROFILING (!UE_BUILD_SHIPPING)
+#endif
+
 /**
  * �������ݽṹ��
  * �洢��������ͳ����Ϣ
@@ -29,6 +41,18 @@ struct SOUL_API FPerformanceData
 	UPROPERTY(BlueprintReadOnly, Category = "Performance")
 	int32 CallCount = 0;
 
+	/** 采样率（1/N），CallCount 只统计被采样的调用 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	int32 SampleRate = 1;
+
+	/** 最近样本窗口的中位数耗时（毫秒），由 GetPerformanceReport 计算 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float P50Time = 0.0f;
+
+	/** 最近样本窗口的 99 分位耗时（毫秒），由 GetPerformanceReport 计算 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float P99Time = 0.0f;
+
 	/** ��ִ��ʱ�䣨���룩 */
 	float TotalTime = 0.0f;
 
@@ -43,6 +67,7 @@ struct SOUL_API FPerformanceData
 		CallCount = 0;
 		TotalTime = 0.0f;
 		MinTime = FLT_MAX;
+		SampleRate = 1;
 	}
 
 	FPerformanceData(const FString& InFunctionName)
@@ -53,9 +78,180 @@ struct SOUL_API FPerformanceData
 		CallCount = 0;
 		TotalTime = 0.0f;
 		MinTime = FLT_MAX;
+		SampleRate = 1;
 	}
 };
 
+/**
+ * 基线对比结果
+ * 单个作用域相对基线的 p50/p99 变化
+ */
+USTRUCT(BlueprintType)
+struct SOUL_API FPerformanceScopeDelta
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	FString ScopeName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float BaselineP50 = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float CurrentP50 = 0.0f;
+
+	/** p50 变化百分比（正数表示变慢） */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float P50DeltaPercent = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float BaselineP99 = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float CurrentP99 = 0.0f;
+
+	/** p99 变化百分比（正数表示变慢） */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float P99DeltaPercent = 0.0f;
+
+	/** 本次运行没有该作用域的数据 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	bool bMissingInCurrentRun = false;
+
+	/** 超出阈值 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	bool bRegressed = false;
+};
+
+/**
+ * 性能预算配置
+ * 单个作用域每帧允许的最大耗时
+ */
+USTRUCT(BlueprintType)
+struct SOUL_API FPerformanceBudget
+{
+	GENERATED_BODY()
+
+	/** 作用域名称（如 CameraPipeline.Tick） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+	FString ScopeName;
+
+	/** 每帧预算（毫秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (ClampMin = "0.0"))
+	float BudgetMs = 0.0f;
+
+	FPerformanceBudget()
+	{
+		ScopeName = TEXT("");
+		BudgetMs = 0.0f;
+	}
+
+	FPerformanceBudget(const FString& InScopeName, float InBudgetMs)
+	{
+		ScopeName = InScopeName;
+		BudgetMs = InBudgetMs;
+	}
+};
+
+/**
+ * 预算超标事件
+ * 看门狗检测到超标时广播
+ */
+USTRUCT(BlueprintType)
+struct SOUL_API FPerformanceBudgetViolation
+{
+	GENERATED_BODY()
+
+	/** 超标的作用域名称（整帧预算为 "Frame"） */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	FString ScopeName;
+
+	/** 本帧实测耗时（毫秒） */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float MeasuredMs = 0.0f;
+
+	/** 配置的预算（毫秒） */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float BudgetMs = 0.0f;
+
+	/** 发生超标的帧号 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	int32 FrameNumber = 0;
+};
+
+/** 单帧内某个作用域的汇总 */
+struct SOUL_API FFrameScopeSample
+{
+	FString ScopeName;
+	float TotalTime = 0.0f;
+	float MaxTime = 0.0f;
+	int32 CallCount = 0;
+};
+
+/** 滚动缓冲中的一帧记录 */
+struct SOUL_API FProfilerFrameRecord
+{
+	uint64 FrameNumber = 0;
+
+	/** 引擎帧时间（毫秒） */
+	float FrameTimeMs = 0.0f;
+
+	/** 本帧所有作用域耗时之和（毫秒） */
+	float ScopeTotalMs = 0.0f;
+
+	TArray<FFrameScopeSample> Scopes;
+
+	/** 本帧各计数器的值，下标为计数器ID（见 FSoulCounters） */
+	TArray<int32> CounterValues;
+};
+
+/**
+ * 计数器统计
+ * 每帧计数的汇总（帧内总和的平均值与峰值）
+ */
+USTRUCT(BlueprintType)
+struct SOUL_API FPerformanceCounterData
+{
+	GENERATED_BODY()
+
+	/** 计数器名称 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	FString CounterName;
+
+	/** 上一帧的计数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	int32 LastFrameValue = 0;
+
+	/** 每帧平均计数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	float AveragePerFrame = 0.0f;
+
+	/** 单帧最大计数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	int32 MaxPerFrame = 0;
+
+	/** 累计计数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	int64 TotalCount = 0;
+
+	/** 参与统计的帧数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	int32 FrameCount = 0;
+};
+
+/** 指标流文件格式 */
+UENUM(BlueprintType)
+enum class EProfilerMetricsFormat : uint8
+{
+	Csv		UMETA(DisplayName = "CSV"),
+	Binary	UMETA(DisplayName = "Binary")
+};
+
+class FSoulMetricsWriter;
+
+// 预算超标事件委托
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPerformanceBudgetExceeded, const FPerformanceBudgetViolation&, Violation);
+
 /**
  * ���ܷ�������ϵͳ
  * �����ռ��ͷ�������ִ������
@@ -127,11 +323,203 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Performance Profiler", meta = (WorldContext = "WorldContextObject"))
 	static UPerformanceProfiler* GetPerformanceProfiler(const UObject* WorldContextObject);
 
+	// ==================== 帧预算看门狗 ====================
+
+	/** 预算超标时广播（每次超标都会广播，转储受最小间隔限制） */
+	UPROPERTY(BlueprintAssignable, Category = "Performance Profiler|Budget")
+	FOnPerformanceBudgetExceeded OnBudgetExceeded;
+
+	/**
+	 * 设置作用域的每帧预算
+	 * @param ScopeName 作用域名称
+	 * @param BudgetMs 预算（毫秒），<= 0 时移除该预算
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Budget")
+	void SetScopeBudget(const FString& ScopeName, float BudgetMs);
+
+	/**
+	 * 设置整帧预算（所有作用域耗时之和）
+	 * 嵌套作用域会被重复计入，因此只应给顶层作用域（组件Tick）打点
+	 * @param BudgetMs 预算（毫秒），<= 0 时关闭
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Budget")
+	void SetFrameBudget(float BudgetMs);
+
+	/** 获取当前所有作用域预算 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Budget")
+	TArray<FPerformanceBudget> GetScopeBudgets() const;
+
+	/** 启用或关闭预算看门狗 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Budget")
+	void SetBudgetWatchdogEnabled(bool bEnabled);
+
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Budget")
+	bool IsBudgetWatchdogEnabled() const { return bIsBudgetWatchdogEnabled; }
+
+	/**
+	 * 设置滚动捕获参数
+	 * @param HistoryFrames 环形缓冲保留的帧数
+	 * @param NeighborFrames 超标帧前后各转储的帧数
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Budget")
+	void SetFrameCaptureSettings(int32 HistoryFrames, int32 NeighborFrames);
+
+	/**
+	 * 立即把环形缓冲中的全部帧转储为CSV
+	 * @return 目标文件路径（在后台线程写入），没有数据时返回空字符串
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Budget")
+	FString DumpFrameHistory(const FString& Reason);
+
+	// ==================== 采样模式 ====================
+
+	/**
+	 * 设置默认采样率：每 N 次调用测量一次
+	 * @param SampleRate 1 表示每次都测量
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Sampling")
+	void SetDefaultSampleRate(int32 SampleRate);
+
+	/**
+	 * 设置单个作用域的采样率，覆盖默认值
+	 * @param SampleRate <= 0 时移除覆盖
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Sampling")
+	void SetScopeSampleRate(const FString& ScopeName, int32 SampleRate);
+
+	/** 获取作用域当前生效的采样率 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Sampling")
+	int32 GetScopeSampleRate(const FString& ScopeName) const;
+
+	/**
+	 * 测量单个作用域在各模式下的开销并输出到日志
+	 * 关闭 / 1/16 采样 / 全量 三种模式；编译移除模式开销为零
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Sampling")
+	void MeasureScopeOverhead(int32 Iterations = 1000000);
+
+	// ==================== 每帧计数器 ====================
+
+	/**
+	 * 获取计数器报告
+	 * @return 按每帧平均计数降序排列
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Counters")
+	TArray<FPerformanceCounterData> GetCounterReport() const;
+
+	/** 上一帧的计数器值（下标为计数器ID） */
+	const TArray<int32>& GetLastFrameCounterValues() const { return CurrentFrameCounters; }
+
+	// ==================== 基线对比 ====================
+
+	/**
+	 * 把当前报告保存为基线（Saved/Profiling/SoulBaselines/<BaselineName>.csv）
+	 * @return 成功返回true
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Baseline")
+	bool SavePerformanceBaseline(const FString& BaselineName);
+
+	/**
+	 * 与基线对比，p50 或 p99 变慢超过阈值的作用域标记为回归
+	 * @param BaselineName 基线名称
+	 * @param P50ThresholdPercent p50 允许的变慢百分比
+	 * @param P99ThresholdPercent p99 允许的变慢百分比
+	 * @param ScopePrefixes 只检查这些前缀的作用域，为空时检查全部
+	 * @param OutDeltas 每个作用域的对比结果
+	 * @return 没有回归返回true；基线不存在返回false
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Baseline")
+	bool ComparePerformanceToBaseline(const FString& BaselineName, float P50ThresholdPercent, float P99ThresholdPercent,
+		const TArray<FString>& ScopePrefixes, TArray<FPerformanceScopeDelta>& OutDeltas);
+
+	/** 基线文件路径 */
+	static FString GetBaselineFilePath(const FString& BaselineName);
+
+	// ==================== 指标流式写入 ====================
+
+	/**
+	 * 开始把每帧作用域汇总流式写入 Saved/Profiling/SoulMetrics
+	 * 序列化在游戏线程，文件I/O在独立写入线程，文件按大小轮转
+	 * @param Format CSV 或紧凑二进制（可用 Soul.Profiler.ConvertMetrics 转为CSV）
+	 * @param FilePrefix 文件名前缀
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Metrics")
+	bool StartMetricsStream(EProfilerMetricsFormat Format, const FString& FilePrefix);
+
+	/** 停止流式写入并写出剩余数据 */
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Metrics")
+	void StopMetricsStream();
+
+	UFUNCTION(BlueprintCallable, Category = "Performance Profiler|Metrics")
+	bool IsMetricsStreaming() const;
+
+	/** 记录一次被采样的作用域耗时（由 FSoulPerformanceScope 调用） */
+	void RecordSampledScopeTime(const TCHAR* ScopeName, float ElapsedTime, int32 SampleRate);
+
+	/** 当前是否有分析器在收集数据（作用域快速路径检查） */
+	static FORCEINLINE bool IsProfilingActive() { return bProfilingActive; }
+
+	/** 采样配置代数，配置变化时递增，调用点据此刷新缓存 */
+	static FORCEINLINE int32 GetSamplingGeneration() { return SamplingGeneration; }
+
+	/** 当前活动的分析器实例，避免每个作用域结束时都查找 World */
+	static FORCEINLINE UPerformanceProfiler* GetActiveProfiler() { return ActiveProfiler; }
+
 private:
 	/** ��������ӳ��� */
 	UPROPERTY()
 	TMap<FString, FPerformanceData> PerformanceMap;
 
+	// ==================== 每帧计数器 ====================
+
+	/** 本帧汇总后的计数（复用内存） */
+	TArray<int32> CurrentFrameCounters;
+
+	/** 计数器统计，下标为计数器ID */
+	TArray<FPerformanceCounterData> CounterStats;
+
+	/** 用本帧计数更新统计 */
+	void UpdateCounterStatistics(const TArray<int32>& FrameValues);
+
+	// ==================== 分位数样本窗口 ====================
+
+	/** 每个作用域保留最近的样本，用于计算 p50/p99 */
+	struct FScopeSampleWindow
+	{
+		TArray<float> Samples;
+		int32 NextIndex = 0;
+	};
+
+	/** 样本窗口大小 */
+	static constexpr int32 PERCENTILE_WINDOW_SIZE = 1024;
+
+	/** 对比时忽略的绝对变化（毫秒），避免微秒级作用域的噪声被判为回归 */
+	static constexpr float BASELINE_MIN_ABSOLUTE_DELTA_MS = 0.01f;
+
+	TMap<FString, FScopeSampleWindow> SampleWindows;
+
+	/** 计算样本窗口的分位数 */
+	static void ComputePercentiles(const FScopeSampleWindow& Window, float& OutP50, float& OutP99);
+
+	// ==================== 采样模式 ====================
+
+	/** 默认采样率 */
+	int32 DefaultSampleRate = 1;
+
+	/** 作用域采样率覆盖 */
+	TMap<FString, int32> ScopeSampleRates;
+
+	static UPerformanceProfiler* ActiveProfiler;
+
+	/** 所有已初始化的实例（游戏线程），激活实例注销时从中选出接替者 */
+	static TArray<UPerformanceProfiler*> LiveProfilers;
+
+	static bool bProfilingActive;
+	static int32 SamplingGeneration;
+
+	/** 刷新静态快速路径状态 */
+	void UpdateProfilingActiveState();
+
 	/** �Ƿ��������ܼ�� */
 	UPROPERTY()
 	bool bIsPerformanceMonitoringEnabled = true;
@@ -141,37 +529,226 @@ private:
 
 	/** ��ʽ��ʱ��Ϊ�ɶ��ַ��� */
 	FString FormatTime(float TimeInMs) const;
+
+	// ==================== 帧预算看门狗 ====================
+
+	/** 等待后续帧到齐再写出的转储请求 */
+	struct FPendingBudgetDump
+	{
+		uint64 ViolationFrame = 0;
+		int32 FramesRemaining = 0;
+		FString Reason;
+	};
+
+	/** 作用域预算表（毫秒） */
+	TMap<FString, float> ScopeBudgets;
+
+	/** 整帧预算（毫秒），0 表示关闭 */
+	float FrameBudgetMs = 0.0f;
+
+	bool bIsBudgetWatchdogEnabled = true;
+
+	/** 环形缓冲保留的帧数 */
+	int32 FrameHistorySize = 120;
+
+	/** 超标帧前后各转储的帧数 */
+	int32 NeighborFrameCount = 5;
+
+	/** 两次转储之间的最小间隔（秒），防止持续超标时刷盘 */
+	float MinDumpIntervalSeconds = 5.0f;
+
+	/** 当前帧正在累积的作用域数据 */
+	TMap<FString, FFrameScopeSample> CurrentFrameScopes;
+
+	/** 帧记录环形缓冲（复用内存，不在每帧重新分配） */
+	TArray<FProfilerFrameRecord> FrameHistory;
+	int32 FrameHistoryHead = 0;
+	int32 FrameHistoryCount = 0;
+
+	TArray<FPendingBudgetDump> PendingDumps;
+	double LastDumpTime = -1.0e9;
+
+	FDelegateHandle EndFrameHandle;
+
+	// ==================== 指标流式写入 ====================
+
+	/** 流式写入器（未在写入时为空） */
+	TSharedPtr<FSoulMetricsWriter> MetricsWriter;
+
+	/** 单个指标文件的最大字节数，超过后轮转 */
+	int64 MetricsMaxFileBytes = 64 * 1024 * 1024;
+
+	/** 保留的指标文件数，超过后删除最旧的 */
+	int32 MetricsMaxFiles = 8;
+
+	/** 帧结束回调：封存当前帧、检查预算、处理待转储请求 */
+	void OnEndFrame();
+
+	/** 检查一帧是否超出预算 */
+	void CheckFrameBudgets(const FProfilerFrameRecord& Record);
+
+	/** 转储以 CenterFrame 为中心的帧窗口，CenterFrame 为 0 时转储全部 */
+	FString WriteFrameDump(uint64 CenterFrame, const FString& Reason) const;
+
+	/** 按时间顺序访问环形缓冲 */
+	const FProfilerFrameRecord& GetHistoryFrame(int32 OrderedIndex) const;
 };
 
 #ifndef FSOUL_PERFORMANCE_SCOPE_DEFINED
 #define FSOUL_PERFORMANCE_SCOPE_DEFINED
 /**
- * ����������ṹ��
- * �����Զ����㺯��ִ��ʱ��
+ * 调用点采样状态
+ * 每个 SOUL_PERFORMANCE_SCOPE 调用点一个静态实例，缓存该作用域的 1/N 采样率
+ * 采样状态与分析器的数据表都没有锁，工作线程上的作用域直接跳过（计数器可在任意线程使用）
+ */
+struct SOUL_API FSoulScopeSampler
+{
+	constexpr explicit FSoulScopeSampler(const TCHAR* InScopeName)
+		: ScopeName(InScopeName)
+	{
+	}
+
+	/** 本次调用是否需要测量 */
+	FORCEINLINE bool ShouldSample()
+	{
+		if (!UPerformanceProfiler::IsProfilingActive() || !IsInGameThread())
+		{
+			return false;
+		}
+
+		if (CachedGeneration != UPerformanceProfiler::GetSamplingGeneration())
+		{
+			RefreshSampleRate();
+		}
+
+		return CachedSampleRate <= 1 || (CallCounter++ % static_cast<uint32>(CachedSampleRate)) == 0;
+	}
+
+	const TCHAR* ScopeName;
+	uint32 CallCounter = 0;
+	int32 CachedSampleRate = 1;
+	int32 CachedGeneration = -1;
+
+private:
+	void RefreshSampleRate();
+};
+
+/**
+ * 性能作用域
+ * 未被采样或分析器未激活时不读时钟、不构造字符串
  */
 struct SOUL_API FSoulPerformanceScope
 {
 public:
+	FORCEINLINE explicit FSoulPerformanceScope(FSoulScopeSampler& Sampler)
+	{
+		if (Sampler.ShouldSample())
+		{
+			ScopeName = Sampler.ScopeName;
+			SampleRate = Sampler.CachedSampleRate;
+			StartTime = FPlatformTime::Seconds();
+		}
+	}
+
+	/** 不经过采样的作用域（兼容旧调用方式） */
 	FSoulPerformanceScope(const FString& InFunctionName);
-	~FSoulPerformanceScope();
+
+	FORCEINLINE ~FSoulPerformanceScope()
+	{
+		if (ScopeName)
+		{
+			Finish();
+		}
+	}
 
 private:
-	FString FunctionName;
-	double StartTime;
+	void Finish();
+
+	const TCHAR* ScopeName = nullptr;
+	FString OwnedName;
+	double StartTime = 0.0;
+	int32 SampleRate = 1;
 };
 #endif
 
-// ���ܼ��궨�壨��������ʱ������
+/**
+ * 每帧命名计数器
+ * 每个线程累加到自己的计数块（只有本线程写入，原子操作无竞争），
+ * 帧结束时由游戏线程汇总所有线程的计数块并清零
+ */
+class SOUL_API FSoulCounters
+{
+public:
+	/** 计数器数量上限 */
+	static constexpr int32 MAX_COUNTERS = 64;
+
+	/**
+	 * 注册计数器（线程安全，同名返回同一ID）
+	 * @return 计数器ID，超出上限返回 INDEX_NONE
+	 */
+	static int32 Register(const TCHAR* CounterName);
+
+	/** 累加计数（任意线程） */
+	static FORCEINLINE void Add(int32 CounterId, int32 Amount)
+	{
+		if (CounterId != INDEX_NONE && UPerformanceProfiler::IsProfilingActive())
+		{
+			AddToThreadBlock(CounterId, Amount);
+		}
+	}
+
+	/** 汇总所有线程本帧的计数并清零（游戏线程） */
+	static void CollectFrame(TArray<int32>& OutValues);
+
+	/** 已注册的计数器数量 */
+	static int32 Num();
+
+	/** 计数器名称 */
+	static FString GetName(int32 CounterId);
+
+private:
+	static void AddToThreadBlock(int32 CounterId, int32 Amount);
+};
+
+// 性能监控宏定义（FunctionName 必须是 TEXT() 字面量）
 #ifndef SOUL_PERFORMANCE_SCOPE
+#if SOUL_PERFORMANCE_PROFILING
 #define SOUL_PERFORMANCE_SCOPE(FunctionName) \
-	FSoulPerformanceScope PerformanceScope(FunctionName)
+	static FSoulScopeSampler PREPROCESSOR_JOIN(SoulScopeSampler_, __LINE__)(FunctionName); \
+	FSoulPerformanceScope PerformanceScope(PREPROCESSOR_JOIN(SoulScopeSampler_, __LINE__))
+#else
+#define SOUL_PERFORMANCE_SCOPE(FunctionName)
+#endif
 #endif
 
 #ifndef SOUL_PERFORMANCE_SCOPE_CONDITIONAL
+#if SOUL_PERFORMANCE_PROFILING
 #define SOUL_PERFORMANCE_SCOPE_CONDITIONAL(FunctionName, Condition) \
+	static FSoulScopeSampler PREPROCESSOR_JOIN(SoulScopeSampler_, __LINE__)(FunctionName); \
 	TOptional<FSoulPerformanceScope> PerformanceScope; \
 	if (Condition) \
 	{ \
-		PerformanceScope.Emplace(FunctionName); \
+		PerformanceScope.Emplace(PREPROCESSOR_JOIN(SoulScopeSampler_, __LINE__)); \
 	}
-#endif
\ No newline at end of file
+#else
+#define SOUL_PERFORMANCE_SCOPE_CONDITIONAL(FunctionName, Condition)
+#endif
+#endif
+
+// 计数器宏定义（CounterName 必须是 TEXT() 字面量）
+#ifndef SOUL_COUNTER_ADD
+#if SOUL_PERFORMANCE_PROFILING
+#define SOUL_COUNTER_ADD(CounterName, Amount) \
+	do \
+	{ \
+		static const int32 PREPROCESSOR_JOIN(SoulCounterId_, __LINE__) = FSoulCounters::Register(CounterName); \
+		FSoulCounters::Add(PREPROCESSOR_JOIN(SoulCounterId_, __LINE__), Amount); \
+	} while (0)
+#else
+#define SOUL_COUNTER_ADD(CounterName, Amount) do {} while (0)
+#endif
+#endif
+
+#ifndef SOUL_COUNTER_INC
+#define SOUL_COUNTER_INC(CounterName) SOUL_COUNTER_ADD(CounterName, 1)
+#endif
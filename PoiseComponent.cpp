@@ -5,12 +5,130 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "PerformanceProfiler.h"
+#include "SoulCombatResourceSubsystem.h"
+
+// ==================== 基准测试控制台命令 ====================
+
+namespace
+{
+	struct FPoiseBenchmarkState
+	{
+		TArray<TWeakObjectPtr<AActor>> Actors;
+		TArray<TWeakObjectPtr<UPoiseComponent>> Components;
+		double EndTime = 0.0;
+		int64 Frames = 0;
+		int64 TickingSamples = 0;
+		int32 PeakTicking = 0;
+	};
+}
+
+static FAutoConsoleCommand CmdPoiseBenchmark(
+	TEXT("Soul.Poise.Benchmark"),
+	TEXT("Spawn poise-bearing characters, damage a fraction of them and report poise ticks per frame against the always-tick baseline: Soul.Poise.Benchmark [Count=500] [DamagedPercent=10] [Seconds=5]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || World->bIsTearingDown)
+		{
+			return;
+		}
+
+		const int32 Count = FMath::Clamp(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 500, 1, 5000);
+		const int32 DamagedPercent = FMath::Clamp(Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 10, 0, 100);
+		const float Seconds = FMath::Clamp(Args.Num() > 2 ? FCString::Atof(*Args[2]) : 5.0f, 0.5f, 60.0f);
+		const int32 DamagedCount = Count * DamagedPercent / 100;
+
+		TSharedRef<FPoiseBenchmarkState> State = MakeShared<FPoiseBenchmarkState>();
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const FVector Location(10000.0f + (i % GridSize) * 200.0f, (i / GridSize) * 200.0f, 1000.0f);
+			ACharacter* Character = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+			if (!Character)
+			{
+				continue;
+			}
+
+			UPoiseComponent* Poise = NewObject<UPoiseComponent>(Character);
+			Character->AddInstanceComponent(Poise);
+			Poise->RegisterComponent();
+
+			if (i < DamagedCount)
+			{
+				Poise->TakePoiseDamage(Poise->GetMaxPoise() * 0.3f);
+			}
+
+			State->Actors.Add(Character);
+			State->Components.Add(Poise);
+		}
+
+		State->EndTime = FPlatformTime::Seconds() + Seconds;
+
+		UE_LOG(LogTemp, Warning, TEXT("PoiseBenchmark: Spawned %d characters (%d damaged), sampling for %.1fs"),
+			State->Components.Num(), DamagedCount, Seconds);
+
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([State](float DeltaTime)
+		{
+			int32 Ticking = 0;
+			for (const TWeakObjectPtr<UPoiseComponent>& Poise : State->Components)
+			{
+				if (Poise.IsValid() && Poise->IsComponentTickEnabled())
+				{
+					++Ticking;
+				}
+			}
+
+			++State->Frames;
+			State->TickingSamples += Ticking;
+			State->PeakTicking = FMath::Max(State->PeakTicking, Ticking);
+
+			if (FPlatformTime::Seconds() < State->EndTime)
+			{
+				return true;
+			}
+
+			// 旧模型下每个组件每帧都会Tick
+			const int32 Baseline = State->Components.Num();
+			const double AverageTicking = State->Frames > 0 ? static_cast<double>(State->TickingSamples) / State->Frames : 0.0;
+			const double Saved = Baseline > 0 ? (1.0 - AverageTicking / Baseline) * 100.0 : 0.0;
+
+			UE_LOG(LogTemp, Warning, TEXT("PoiseBenchmark: %lld frames, poise ticks/frame avg %.1f peak %d vs always-tick %d (%.1f%% saved). See scope PoiseComponent.Tick for per-tick cost."),
+				State->Frames, AverageTicking, State->PeakTicking, Baseline, Saved);
+
+			if (State->Actors.Num() > 0 && State->Actors[0].IsValid())
+			{
+				if (const USoulCombatResourceSubsystem* Manager = State->Actors[0]->GetWorld()->GetSubsystem<USoulCombatResourceSubsystem>())
+				{
+					UE_LOG(LogTemp, Warning, TEXT("PoiseBenchmark: %d poise handles batch-updated by the combat resource manager (scope CombatResources.Update)"),
+						Manager->GetNumPoiseHandles());
+				}
+			}
+
+			for (const TWeakObjectPtr<AActor>& Actor : State->Actors)
+			{
+				if (Actor.IsValid())
+				{
+					Actor->Destroy();
+				}
+			}
+			return false;
+		}));
+	})
+);
 
 // Sets default values for this component's properties
 UPoiseComponent::UPoiseComponent()
 {
 	// Set this component to be ticked every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryComponentTick.bCanEverTick = true;
+	// 只在恢复进行中开启Tick，由 ScheduleRecovery 控制
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 
 	// ��ʼ����������
 	PoiseSettings = FPoiseSettings();
@@ -20,6 +138,8 @@ UPoiseComponent::UPoiseComponent()
 	CurrentPoiseState = EPoiseState::Normal;
 	LastDamageTime = 0.0f;
 	PoiseImmuneEndTime = 0.0f;
+	RecoveryAnchorTime = 0.0f;
+	ResourceHandle = INDEX_NONE;
 	OwnerCharacter = nullptr;
 	bIsStaggering = false;
 	bManuallySetImmune = false;
@@ -45,12 +165,47 @@ void UPoiseComponent::BeginPlay()
 	CurrentPoiseState = EPoiseState::Normal;
 	LastDamageTime = 0.0f;
 	PoiseImmuneEndTime = 0.0f;
+	RecoveryAnchorTime = GetWorld()->GetTimeSeconds();
 	bIsStaggering = false;
 	bManuallySetImmune = false;
 
+	// 开启时交给战斗资源管理器批量恢复，否则（或没有管理器时）使用恢复定时器
+	USoulCombatResourceSubsystem* Manager = PoiseSettings.bUseResourceManager
+		? GetWorld()->GetSubsystem<USoulCombatResourceSubsystem>() : nullptr;
+	if (Manager)
+	{
+		// 把组件上的数值交给槽位，之后托管期间只通过句柄读写
+		FCombatResourceState InitialState;
+		InitialState.Current = CurrentPoise;
+		InitialState.Max = PoiseSettings.MaxPoise;
+		InitialState.RecoveryRate = PoiseSettings.PoiseRecoveryRate;
+		InitialState.RecoveryStartTime = CanRecoverPoise() ? GetRecoveryStartTime() : MAX_flt;
+
+		ResourceManager = Manager;
+		ResourceHandle = Manager->RegisterPoise(this, InitialState);
+		ScheduleRecovery();
+	}
+
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: BeginPlay completed for %s"), 
 		OwnerCharacter ? *OwnerCharacter->GetName() : TEXT("Unknown"));
-	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Initial Poise: %.1f/%.1f"), CurrentPoise, PoiseSettings.MaxPoise);
+	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Initial Poise: %.1f/%.1f"), GetPoiseValue(), PoiseSettings.MaxPoise);
+}
+
+void UPoiseComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearAllTimersForObject(this);
+	}
+
+	if (IsManagedByResourceManager())
+	{
+		ResourceManager->UnregisterPoise(ResourceHandle);
+	}
+	ResourceHandle = INDEX_NONE;
+	ResourceManager.Reset();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -58,29 +213,28 @@ void UPoiseComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActor
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	SOUL_PERFORMANCE_SCOPE(TEXT("PoiseComponent.Tick"));
+	SOUL_COUNTER_INC(TEXT("Poise.Ticks"));
+
 	if (!IsValidForPoiseOperations())
 	{
 		return;
 	}
 
-	// �������Իָ�
-	UpdatePoiseRecovery(DeltaTime);
-
-	// �����������״̬
-	if (IsPoiseImmune() && !bManuallySetImmune)
-	{
-		float CurrentTime = GetWorld()->GetTimeSeconds();
-		if (CurrentTime >= PoiseImmuneEndTime)
-		{
-			EndPoiseImmune();
-		}
-	}
+	// 只在恢复进行中才会Tick：恢复量由闭式公式计算，这里只广播进度
+	// 硬直结束和免疫结束都由定时器精确触发
+	BroadcastPoiseChanged();
 }
 
 // ==================== ���Ľӿں���ʵ�� ====================
 
 bool UPoiseComponent::TakePoiseDamage(float PoiseDamage, AActor* DamageSource)
 {
+	if (PoiseSettings.bBatchPoiseDamage && IsManagedByResourceManager())
+	{
+		return QueuePoiseDamage(PoiseDamage, DamageSource);
+	}
+
 	if (!IsValidForPoiseOperations() || PoiseDamage <= 0.0f)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Invalid poise damage attempt - Damage: %.1f"), PoiseDamage);
@@ -104,20 +258,22 @@ bool UPoiseComponent::TakePoiseDamage(float PoiseDamage, AActor* DamageSource)
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Taking poise damage %.1f from %s"), 
 		PoiseDamage, DamageSource ? *DamageSource->GetName() : TEXT("Unknown"));
 
+	SyncPoise();
+
 	// ��¼�˺�ʱ��
 	LastDamageTime = GetWorld()->GetTimeSeconds();
 
 	// ��������ֵ
-	float PreviousPoise = CurrentPoise;
-	CurrentPoise = FMath::Max(0.0f, CurrentPoise - PoiseDamage);
+	float PreviousPoise = GetPoiseValue();
+	SetPoiseValue(FMath::Max(0.0f, PreviousPoise - PoiseDamage));
 
 	// ����״̬
-	if (CurrentPoise <= 0.0f)
+	if (GetPoiseValue() <= 0.0f)
 	{
 		// �����ƻ�
 		BreakPoise(DamageSource);
 	}
-	else if (CurrentPoise < PoiseSettings.MaxPoise)
+	else if (GetPoiseValue() < PoiseSettings.MaxPoise)
 	{
 		// ��������
 		SetPoiseState(EPoiseState::Damaged);
@@ -126,11 +282,83 @@ bool UPoiseComponent::TakePoiseDamage(float PoiseDamage, AActor* DamageSource)
 	// �㲥���Ա仯�¼�
 	BroadcastPoiseChanged();
 
-	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Poise changed from %.1f to %.1f"), PreviousPoise, CurrentPoise);
+	// 恢复延迟从本次受击重新计时
+	ScheduleRecovery();
+
+	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Poise changed from %.1f to %.1f"), PreviousPoise, GetPoiseValue());
 
 	return true;
 }
 
+bool UPoiseComponent::QueuePoiseDamage(float PoiseDamage, AActor* DamageSource)
+{
+	if (!IsManagedByResourceManager())
+	{
+		return TakePoiseDamage(PoiseDamage, DamageSource);
+	}
+
+	// 入队时就挡掉免疫和已破韧的受击，结算时还会再检查一次
+	if (!IsValidForPoiseOperations() || PoiseDamage <= 0.0f || IsPoiseImmune() || IsPoiseBroken())
+	{
+		return false;
+	}
+
+	ResourceManager->QueuePoiseHit(this, PoiseDamage, DamageSource);
+	return true;
+}
+
+void UPoiseComponent::ResolveQueuedPoiseHits(const FQueuedPoiseHit* Hits, int32 NumHits)
+{
+	if (!IsValidForPoiseOperations() || NumHits <= 0 || IsPoiseImmune() || IsPoiseBroken())
+	{
+		return;
+	}
+
+	SyncPoise();
+
+	const float PreviousPoise = GetPoiseValue();
+	float RemainingPoise = PreviousPoise;
+	float TotalDamage = 0.0f;
+	int32 AppliedHits = 0;
+	AActor* BreakingSource = nullptr;
+
+	for (int32 i = 0; i < NumHits; ++i)
+	{
+		RemainingPoise -= Hits[i].Damage;
+		TotalDamage += Hits[i].Damage;
+		++AppliedHits;
+
+		// 破韧后的受击与逐次结算时一样被挡掉
+		if (RemainingPoise <= 0.0f)
+		{
+			BreakingSource = Hits[i].DamageSource.Get();
+			break;
+		}
+	}
+
+	LastDamageTime = GetWorld()->GetTimeSeconds();
+
+	if (RemainingPoise <= 0.0f)
+	{
+		// BreakPoise 内完成状态切换和广播
+		BreakPoise(BreakingSource);
+	}
+	else
+	{
+		SetPoiseValue(RemainingPoise);
+		if (GetPoiseValue() < PoiseSettings.MaxPoise)
+		{
+			SetPoiseState(EPoiseState::Damaged);
+		}
+
+		BroadcastPoiseChanged();
+		ScheduleRecovery();
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("PoiseComponent: Resolved %d/%d queued hits (%.1f damage), poise %.1f -> %.1f"),
+		AppliedHits, NumHits, TotalDamage, PreviousPoise, GetPoiseValue());
+}
+
 void UPoiseComponent::BreakPoise(AActor* DamageSource)
 {
 	if (!IsValidForPoiseOperations())
@@ -142,7 +370,8 @@ void UPoiseComponent::BreakPoise(AActor* DamageSource)
 		OwnerCharacter ? *OwnerCharacter->GetName() : TEXT("Unknown"));
 
 	// ��������Ϊ0
-	CurrentPoise = 0.0f;
+	SyncPoise();
+	SetPoiseValue(0.0f);
 
 	// �����ƻ�״̬
 	SetPoiseState(EPoiseState::Broken);
@@ -152,6 +381,7 @@ void UPoiseComponent::BreakPoise(AActor* DamageSource)
 
 	// ��ʼӲֱ
 	StartStagger(StaggerDuration, DamageSource);
+	ScheduleRecovery();
 
 	// �㲥�����ƻ��¼�
 	OnPoiseBreak.Broadcast(GetOwner(), StaggerDuration, DamageSource);
@@ -175,30 +405,34 @@ void UPoiseComponent::RecoverPoise(float RecoveryAmount)
 		return;
 	}
 
+	SyncPoise();
+
 	// ���û��ָ���ָ�����ʹ��Ĭ������
 	if (RecoveryAmount <= 0.0f)
 	{
 		RecoveryAmount = PoiseSettings.PoiseRecoveryRate * GetWorld()->GetDeltaSeconds();
 	}
 
-	float PreviousPoise = CurrentPoise;
-	CurrentPoise = FMath::Min(PoiseSettings.MaxPoise, CurrentPoise + RecoveryAmount);
+	float PreviousPoise = GetPoiseValue();
+	SetPoiseValue(FMath::Min(PoiseSettings.MaxPoise, PreviousPoise + RecoveryAmount));
 
 	// ����״̬
-	if (CurrentPoise >= PoiseSettings.MaxPoise)
+	if (GetPoiseValue() >= PoiseSettings.MaxPoise)
 	{
 		SetPoiseState(EPoiseState::Normal);
 	}
-	else if (CurrentPoise > 0.0f && CurrentPoiseState == EPoiseState::Broken)
+	else if (GetPoiseValue() > 0.0f && CurrentPoiseState == EPoiseState::Broken)
 	{
 		SetPoiseState(EPoiseState::Recovering);
 	}
 
 	// �㲥���Ա仯�¼�
-	if (FMath::Abs(CurrentPoise - PreviousPoise) > 0.01f)
+	if (FMath::Abs(GetPoiseValue() - PreviousPoise) > 0.01f)
 	{
 		BroadcastPoiseChanged();
 	}
+
+	ScheduleRecovery();
 }
 
 void UPoiseComponent::ResetPoise()
@@ -210,7 +444,8 @@ void UPoiseComponent::ResetPoise()
 
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Resetting poise to maximum"));
 
-	CurrentPoise = PoiseSettings.MaxPoise;
+	SyncPoise();
+	SetPoiseValue(PoiseSettings.MaxPoise);
 	SetPoiseState(EPoiseState::Normal);
 
 	// ���Ӳֱ״̬
@@ -219,6 +454,8 @@ void UPoiseComponent::ResetPoise()
 		EndStagger();
 	}
 
+	ScheduleRecovery();
+
 	// �㲥���Ա仯�¼�
 	BroadcastPoiseChanged();
 }
@@ -237,7 +474,10 @@ void UPoiseComponent::SetPoiseImmune(bool bImmune, float Duration)
 
 	if (bImmune)
 	{
+		// 免疫期间不恢复，先结算已恢复的部分
+		SyncPoise();
 		SetPoiseState(EPoiseState::Immune);
+		ScheduleRecovery();
 
 		if (Duration > 0.0f)
 		{
@@ -282,7 +522,11 @@ bool UPoiseComponent::IsPoiseImmune() const
 
 float UPoiseComponent::GetCurrentPoise() const
 {
-	return CurrentPoise;
+	if (const UWorld* World = GetWorld())
+	{
+		return EvaluatePoise(World->GetTimeSeconds());
+	}
+	return GetPoiseValue();
 }
 
 float UPoiseComponent::GetPoisePercentage() const
@@ -291,7 +535,7 @@ float UPoiseComponent::GetPoisePercentage() const
 	{
 		return 0.0f;
 	}
-	return (CurrentPoise / PoiseSettings.MaxPoise) * 100.0f;
+	return (GetCurrentPoise() / PoiseSettings.MaxPoise) * 100.0f;
 }
 
 EPoiseState UPoiseComponent::GetPoiseState() const
@@ -315,19 +559,24 @@ void UPoiseComponent::UpdatePoiseSettings(const FPoiseSettings& NewSettings)
 {
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Updating poise settings"));
 
+	// 先按旧的恢复速率结算
+	SyncPoise();
+
 	FPoiseSettings OldSettings = PoiseSettings;
 	PoiseSettings = NewSettings;
 
 	// ����������ֵ�����仯��������ǰ����ֵ
 	if (OldSettings.MaxPoise != NewSettings.MaxPoise)
 	{
-		float PoiseRatio = (OldSettings.MaxPoise > 0.0f) ? (CurrentPoise / OldSettings.MaxPoise) : 1.0f;
-		CurrentPoise = NewSettings.MaxPoise * PoiseRatio;
-		CurrentPoise = FMath::Clamp(CurrentPoise, 0.0f, NewSettings.MaxPoise);
+		float PoiseRatio = (OldSettings.MaxPoise > 0.0f) ? (GetPoiseValue() / OldSettings.MaxPoise) : 1.0f;
+		SetPoiseValue(NewSettings.MaxPoise * PoiseRatio);
+		SetPoiseValue(FMath::Clamp(GetPoiseValue(), 0.0f, NewSettings.MaxPoise));
 
 		// �㲥���Ա仯�¼�
 		BroadcastPoiseChanged();
 	}
+
+	ScheduleRecovery();
 }
 
 void UPoiseComponent::SetMaxPoise(float NewMaxPoise)
@@ -338,50 +587,115 @@ void UPoiseComponent::SetMaxPoise(float NewMaxPoise)
 		return;
 	}
 
+	SyncPoise();
+
 	float OldMaxPoise = PoiseSettings.MaxPoise;
 	PoiseSettings.MaxPoise = NewMaxPoise;
 
 	// ������������ǰ����ֵ
 	if (OldMaxPoise > 0.0f)
 	{
-		float PoiseRatio = CurrentPoise / OldMaxPoise;
-		CurrentPoise = NewMaxPoise * PoiseRatio;
+		float PoiseRatio = GetPoiseValue() / OldMaxPoise;
+		SetPoiseValue(NewMaxPoise * PoiseRatio);
 	}
 	else
 	{
-		CurrentPoise = NewMaxPoise;
+		SetPoiseValue(NewMaxPoise);
 	}
 
-	CurrentPoise = FMath::Clamp(CurrentPoise, 0.0f, NewMaxPoise);
+	SetPoiseValue(FMath::Clamp(GetPoiseValue(), 0.0f, NewMaxPoise));
 
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Max poise changed from %.1f to %.1f, Current poise: %.1f"), 
-		OldMaxPoise, NewMaxPoise, CurrentPoise);
+		OldMaxPoise, NewMaxPoise, GetPoiseValue());
 
 	// �㲥���Ա仯�¼�
 	BroadcastPoiseChanged();
+
+	ScheduleRecovery();
 }
 
 // ==================== ˽�и�������ʵ�� ====================
 
-void UPoiseComponent::UpdatePoiseRecovery(float DeltaTime)
+bool UPoiseComponent::CanRecoverPoise() const
 {
 	// ֻ����������ָ�״̬�²����Զ��ָ�����
-	if (CurrentPoiseState != EPoiseState::Normal && 
-		CurrentPoiseState != EPoiseState::Damaged && 
-		CurrentPoiseState != EPoiseState::Recovering)
+	return !bIsStaggering &&
+		(CurrentPoiseState == EPoiseState::Normal ||
+		 CurrentPoiseState == EPoiseState::Damaged ||
+		 CurrentPoiseState == EPoiseState::Recovering);
+}
+
+float UPoiseComponent::GetRecoveryStartTime() const
+{
+	return FMath::Max(LastDamageTime + PoiseSettings.PoiseRecoveryDelay, RecoveryAnchorTime);
+}
+
+float UPoiseComponent::EvaluatePoise(float Time) const
+{
+	// 托管时由管理器逐帧积分，直接取槽位中的当前值
+	if (IsManagedByResourceManager())
+	{
+		return GetPoiseValue();
+	}
+
+	if (!CanRecoverPoise() || PoiseSettings.PoiseRecoveryRate <= 0.0f)
+	{
+		return CurrentPoise;
+	}
+
+	const float Elapsed = FMath::Max(0.0f, Time - GetRecoveryStartTime());
+	return FMath::Min(PoiseSettings.MaxPoise, CurrentPoise + PoiseSettings.PoiseRecoveryRate * Elapsed);
+}
+
+void UPoiseComponent::SyncPoise()
+{
+	UWorld* World = GetWorld();
+	if (!World)
 	{
 		return;
 	}
 
-	// ����Ƿ���Ҫ�ȴ��ָ��ӳ�
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	if (CurrentTime - LastDamageTime < PoiseSettings.PoiseRecoveryDelay)
+	const float CurrentTime = World->GetTimeSeconds();
+
+	// 托管时韧性值只存放在槽位中，由管理器积分，这里只重设时间戳
+	if (!IsManagedByResourceManager())
+	{
+		CurrentPoise = EvaluatePoise(CurrentTime);
+	}
+	RecoveryAnchorTime = CurrentTime;
+}
+
+void UPoiseComponent::ScheduleRecovery()
+{
+	UWorld* World = GetWorld();
+	if (!World)
 	{
 		return;
 	}
 
+	FTimerManager& TimerManager = World->GetTimerManager();
+	TimerManager.ClearTimer(RecoveryStartTimerHandle);
+	TimerManager.ClearTimer(RecoveryCompleteTimerHandle);
+	SetComponentTickEnabled(false);
+
+	const bool bManaged = IsManagedByResourceManager();
+	if (bManaged)
+	{
+		// 数值已直接写在槽位中，这里只更新由设置和状态决定的恢复参数
+		ResourceManager->GetPoiseSlots().SetRecoveryParams(ResourceHandle, PoiseSettings.MaxPoise,
+			PoiseSettings.PoiseRecoveryRate, CanRecoverPoise() ? GetRecoveryStartTime() : MAX_flt);
+	}
+
+	if (!CanRecoverPoise() || PoiseSettings.PoiseRecoveryRate <= 0.0f)
+	{
+		return;
+	}
+
+	const float CurrentTime = World->GetTimeSeconds();
+	const float Poise = EvaluatePoise(CurrentTime);
+
 	// �����������������Ҫ�ָ�
-	if (CurrentPoise >= PoiseSettings.MaxPoise)
+	if (Poise >= PoiseSettings.MaxPoise)
 	{
 		if (CurrentPoiseState != EPoiseState::Normal)
 		{
@@ -390,9 +704,78 @@ void UPoiseComponent::UpdatePoiseRecovery(float DeltaTime)
 		return;
 	}
 
-	// ִ�����Իָ�
-	float RecoveryAmount = PoiseSettings.PoiseRecoveryRate * DeltaTime;
-	RecoverPoise(RecoveryAmount);
+	// 托管时恢复开始/恢复满由管理器的批量更新产生
+	if (bManaged)
+	{
+		return;
+	}
+
+	// ����Ƿ���Ҫ�ȴ��ָ��ӳ�
+	const float TimeUntilStart = GetRecoveryStartTime() - CurrentTime;
+	if (TimeUntilStart > 0.0f)
+	{
+		TimerManager.SetTimer(RecoveryStartTimerHandle, this, &UPoiseComponent::OnRecoveryStarted, TimeUntilStart, false);
+	}
+	else
+	{
+		SetComponentTickEnabled(PoiseSettings.bBroadcastRecoveryProgress);
+	}
+
+	const float TimeUntilFull = FMath::Max(0.0f, TimeUntilStart) + (PoiseSettings.MaxPoise - Poise) / PoiseSettings.PoiseRecoveryRate;
+	TimerManager.SetTimer(RecoveryCompleteTimerHandle, this, &UPoiseComponent::OnPoiseFullyRecovered,
+		FMath::Max(TimeUntilFull, KINDA_SMALL_NUMBER), false);
+}
+
+void UPoiseComponent::OnRecoveryStarted()
+{
+	SetComponentTickEnabled(PoiseSettings.bBroadcastRecoveryProgress);
+}
+
+void UPoiseComponent::OnPoiseFullyRecovered()
+{
+	SyncPoise();
+	SetPoiseValue(PoiseSettings.MaxPoise);
+	SetComponentTickEnabled(false);
+
+	SetPoiseState(EPoiseState::Normal);
+	BroadcastPoiseChanged();
+}
+
+bool UPoiseComponent::IsManagedByResourceManager() const
+{
+	return ResourceHandle != INDEX_NONE && ResourceManager.IsValid();
+}
+
+float UPoiseComponent::GetPoiseValue() const
+{
+	return IsManagedByResourceManager() ? ResourceManager->GetPoiseSlots().GetCurrent(ResourceHandle) : CurrentPoise;
+}
+
+void UPoiseComponent::SetPoiseValue(float NewValue)
+{
+	if (IsManagedByResourceManager())
+	{
+		ResourceManager->GetPoiseSlots().SetCurrent(ResourceHandle, NewValue);
+	}
+	else
+	{
+		CurrentPoise = NewValue;
+	}
+}
+
+void UPoiseComponent::HandleManagedPoiseEvents(uint8 Events)
+{
+	if (Events & FCombatResourceArrays::EVENT_FULLY_RECOVERED)
+	{
+		OnPoiseFullyRecovered();
+		return;
+	}
+
+	// 恢复进度广播与组件Tick模式保持一致
+	if ((Events & FCombatResourceArrays::EVENT_CHANGED) && PoiseSettings.bBroadcastRecoveryProgress)
+	{
+		BroadcastPoiseChanged();
+	}
 }
 
 void UPoiseComponent::StartStagger(float StaggerDuration, AActor* DamageSource)
@@ -437,6 +820,7 @@ void UPoiseComponent::EndStagger()
 
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Ending stagger"));
 
+	SyncPoise();
 	bIsStaggering = false;
 
 	// ���Ӳֱ��ʱ��
@@ -463,6 +847,8 @@ void UPoiseComponent::EndStagger()
 		SetPoiseState(EPoiseState::Recovering);
 	}
 
+	ScheduleRecovery();
+
 	// �㲥Ӳֱ�����¼�
 	OnStaggerEnded.Broadcast(GetOwner());
 
@@ -500,6 +886,7 @@ void UPoiseComponent::EndPoiseImmune()
 
 	UE_LOG(LogTemp, Warning, TEXT("PoiseComponent: Ending poise immunity"));
 
+	SyncPoise();
 	bManuallySetImmune = false;
 	PoiseImmuneEndTime = 0.0f;
 
@@ -507,11 +894,11 @@ void UPoiseComponent::EndPoiseImmune()
 	GetWorld()->GetTimerManager().ClearTimer(ImmuneTimerHandle);
 
 	// ���ݵ�ǰ����ֵ���ú��ʵ�״̬
-	if (CurrentPoise >= PoiseSettings.MaxPoise)
+	if (GetPoiseValue() >= PoiseSettings.MaxPoise)
 	{
 		SetPoiseState(EPoiseState::Normal);
 	}
-	else if (CurrentPoise > 0.0f)
+	else if (GetPoiseValue() > 0.0f)
 	{
 		SetPoiseState(EPoiseState::Recovering);
 	}
@@ -519,6 +906,8 @@ void UPoiseComponent::EndPoiseImmune()
 	{
 		SetPoiseState(EPoiseState::Broken);
 	}
+
+	ScheduleRecovery();
 }
 
 float UPoiseComponent::CalculateStaggerDuration(float PoiseDamage) const
@@ -541,7 +930,7 @@ void UPoiseComponent::BroadcastPoiseChanged()
 {
 	if (IsValidForPoiseOperations())
 	{
-		OnPoiseChanged.Broadcast(GetOwner(), CurrentPoise, PoiseSettings.MaxPoise);
+		OnPoiseChanged.Broadcast(GetOwner(), GetCurrentPoise(), PoiseSettings.MaxPoise);
 	}
 }
 
@@ -9,6 +9,9 @@
 #include "TimerManager.h"
 #include "PoiseComponent.generated.h"
 
+class USoulCombatResourceSubsystem;
+struct FQueuedPoiseHit;
+
 // ����״̬ö��
 UENUM(BlueprintType)
 enum class EPoiseState : uint8
@@ -46,6 +49,18 @@ struct FPoiseSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Poise Settings", meta = (ClampMin = "0.0", ClampMax = "5.0"))
 	float PoiseImmuneTimeAfterBreak = 0.5f;
 
+	// 是否交给战斗资源管理器批量恢复（默认关闭，沿用组件自身的恢复逻辑）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Poise Settings")
+	bool bUseResourceManager = false;
+
+	// TakePoiseDamage 是否走批量受击队列（同一帧内的多段/范围伤害合并结算，返回值表示是否入队；需开启 bUseResourceManager）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Poise Settings")
+	bool bBatchPoiseDamage = false;
+
+	// 恢复期间是否每帧广播 OnPoiseChanged（关闭后只在离散事件时广播，恢复过程完全不Tick）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Poise Settings")
+	bool bBroadcastRecoveryProgress = true;
+
 	// ���캯��
 	FPoiseSettings()
 		: MaxPoise(100.0f)
@@ -53,6 +68,9 @@ struct FPoiseSettings
 		, PoiseRecoveryDelay(3.0f)
 		, BaseStaggerDuration(1.5f)
 		, PoiseImmuneTimeAfterBreak(0.5f)
+		, bUseResourceManager(false)
+		, bBatchPoiseDamage(false)
+		, bBroadcastRecoveryProgress(true)
 	{
 	}
 };
@@ -77,6 +95,8 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -112,6 +132,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Poise System")
 	bool TakePoiseDamage(float PoiseDamage, AActor* DamageSource = nullptr);
 
+	/**
+	 * 韧性受击入队，本帧末与同一目标的其他受击合并结算：一次状态变化、一次广播
+	 * 没有战斗资源管理器时直接结算
+	 * @param PoiseDamage 韧性伤害值
+	 * @param DamageSource 伤害来源（可选）
+	 * @return 是否入队（免疫或已破韧时返回false）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Poise System")
+	bool QueuePoiseDamage(float PoiseDamage, AActor* DamageSource = nullptr);
+
 	/**
 	 * ǿ���ƻ�����
 	 * @param DamageSource �˺���Դ����ѡ��
@@ -198,6 +228,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Poise System")
 	void SetMaxPoise(float NewMaxPoise);
 
+	/**
+	 * 战斗资源管理器批量更新后回调（恢复进度/恢复满）
+	 * @param Events FCombatResourceArrays::EVENT_* 组合
+	 */
+	void HandleManagedPoiseEvents(uint8 Events);
+
+	/**
+	 * 战斗资源管理器结算本帧排队的受击（已按入队顺序排好）
+	 */
+	void ResolveQueuedPoiseHits(const FQueuedPoiseHit* Hits, int32 NumHits);
+
 protected:
 	// ==================== Protected��Ա���� ====================
 
@@ -227,6 +268,19 @@ protected:
 	// ���߶�ʱ�����
 	FTimerHandle ImmuneTimerHandle;
 
+	// CurrentPoise 对应的时间戳，恢复量从 max(此时刻, 受击时刻 + 恢复延迟) 起算
+	float RecoveryAnchorTime;
+
+	// 恢复开始 / 恢复满的定时器
+	FTimerHandle RecoveryStartTimerHandle;
+	FTimerHandle RecoveryCompleteTimerHandle;
+
+	// 战斗资源管理器中的句柄，INDEX_NONE 表示未托管（使用恢复定时器）
+	int32 ResourceHandle;
+
+	// 托管时韧性值只存放在管理器的槽位中，由管理器批量恢复，CurrentPoise 不再使用
+	TWeakObjectPtr<USoulCombatResourceSubsystem> ResourceManager;
+
 	// �Ƿ�����Ӳֱ��
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Poise State")
 	bool bIsStaggering;
@@ -238,9 +292,52 @@ protected:
 
 private:
 	/**
-	 * �������Իָ��߼�
+	 * 当前状态是否允许自动恢复（正常/受损/恢复中，且不在硬直中）
+	 */
+	bool CanRecoverPoise() const;
+
+	/**
+	 * 自动恢复的起始时刻
+	 */
+	float GetRecoveryStartTime() const;
+
+	/**
+	 * 闭式计算指定时刻的韧性值：min(Max, CurrentPoise + Rate * (t - 起始时刻))
+	 */
+	float EvaluatePoise(float Time) const;
+
+	/**
+	 * 把当前时刻的闭式结果写回 CurrentPoise 并重设时间戳（修改韧性或状态前调用）
+	 * 托管时只重设时间戳
+	 */
+	void SyncPoise();
+
+	/**
+	 * 重新预约恢复开始/恢复满的定时器，并只在恢复进行中开启Tick
+	 * 托管时改为把上限、恢复速率和恢复起点写入槽位
+	 */
+	void ScheduleRecovery();
+
+	/**
+	 * 定时器回调：恢复延迟结束
+	 */
+	void OnRecoveryStarted();
+
+	/**
+	 * 定时器回调：韧性恢复满
+	 */
+	void OnPoiseFullyRecovered();
+
+	/**
+	 * 是否由战斗资源管理器托管
+	 */
+	bool IsManagedByResourceManager() const;
+
+	/**
+	 * 韧性值读写：托管时直接读写槽位，否则读写 CurrentPoise（需先 SyncPoise）
 	 */
-	void UpdatePoiseRecovery(float DeltaTime);
+	float GetPoiseValue() const;
+	void SetPoiseValue(float NewValue);
 
 	/**
 	 * ��ʼӲֱ
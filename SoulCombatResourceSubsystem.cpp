@@ -0,0 +1,360 @@
+#include "SoulCombatResourceSubsystem.h"
+#include "StaminaComponent.h"
+#include "PoiseComponent.h"
+#include "PerformanceProfiler.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+
+// 每个并行任务处理的槽位数，太小时调度开销会超过计算本身
+static constexpr int32 COMBAT_RESOURCE_CHUNK_SIZE = 128;
+
+// ==================== FCombatResourceArrays ====================
+
+int32 FCombatResourceArrays::Allocate()
+{
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(false);
+	}
+	else
+	{
+		Slot = Current.Add(0.0f);
+		Max.Add(0.0f);
+		RecoveryRate.Add(0.0f);
+		RecoveryStartTime.Add(MAX_flt);
+		Flags.Add(0);
+		Events.Add(0);
+	}
+
+	Flags[Slot] = FLAG_ACTIVE;
+	Events[Slot] = 0;
+	++NumActive;
+	return Slot;
+}
+
+void FCombatResourceArrays::Free(int32 Slot)
+{
+	if (!IsValidSlot(Slot))
+	{
+		return;
+	}
+
+	Flags[Slot] = 0;
+	Events[Slot] = 0;
+	FreeSlots.Add(Slot);
+	--NumActive;
+}
+
+void FCombatResourceArrays::Write(int32 Slot, const FCombatResourceState& State)
+{
+	if (!IsValidSlot(Slot))
+	{
+		return;
+	}
+
+	Current[Slot] = State.Current;
+	Max[Slot] = State.Max;
+	RecoveryRate[Slot] = State.RecoveryRate;
+	RecoveryStartTime[Slot] = State.RecoveryStartTime;
+	Flags[Slot] = State.bRecovering ? (FLAG_ACTIVE | FLAG_RECOVERING) : FLAG_ACTIVE;
+}
+
+void FCombatResourceArrays::SetCurrent(int32 Slot, float Value)
+{
+	if (IsValidSlot(Slot))
+	{
+		Current[Slot] = Value;
+	}
+}
+
+void FCombatResourceArrays::SetRecovering(int32 Slot, bool bRecovering)
+{
+	if (!IsValidSlot(Slot))
+	{
+		return;
+	}
+
+	if (bRecovering)
+	{
+		Flags[Slot] |= FLAG_RECOVERING;
+	}
+	else
+	{
+		Flags[Slot] &= ~FLAG_RECOVERING;
+	}
+}
+
+void FCombatResourceArrays::SetRecoveryParams(int32 Slot, float InMax, float InRecoveryRate, float InRecoveryStartTime)
+{
+	if (!IsValidSlot(Slot))
+	{
+		return;
+	}
+
+	Max[Slot] = InMax;
+	RecoveryRate[Slot] = InRecoveryRate;
+	RecoveryStartTime[Slot] = InRecoveryStartTime;
+}
+
+void FCombatResourceArrays::Update(float CurrentTime, float DeltaTime)
+{
+	const int32 NumSlots = Current.Num();
+	if (NumSlots == 0)
+	{
+		return;
+	}
+
+	float* RESTRICT CurrentData = Current.GetData();
+	const float* RESTRICT MaxData = Max.GetData();
+	const float* RESTRICT RateData = RecoveryRate.GetData();
+	const float* RESTRICT StartData = RecoveryStartTime.GetData();
+	uint8* RESTRICT FlagData = Flags.GetData();
+	uint8* RESTRICT EventData = Events.GetData();
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumSlots, COMBAT_RESOURCE_CHUNK_SIZE);
+	ParallelFor(NumChunks, [=](int32 ChunkIndex)
+	{
+		const int32 Begin = ChunkIndex * COMBAT_RESOURCE_CHUNK_SIZE;
+		const int32 End = FMath::Min(Begin + COMBAT_RESOURCE_CHUNK_SIZE, NumSlots);
+
+		for (int32 i = Begin; i < End; ++i)
+		{
+			EventData[i] = 0;
+
+			if ((FlagData[i] & FLAG_ACTIVE) == 0 || CurrentData[i] >= MaxData[i] ||
+				RateData[i] <= 0.0f || CurrentTime < StartData[i])
+			{
+				continue;
+			}
+
+			uint8 SlotEvents = EVENT_CHANGED;
+			if ((FlagData[i] & FLAG_RECOVERING) == 0)
+			{
+				FlagData[i] |= FLAG_RECOVERING;
+				SlotEvents |= EVENT_RECOVERY_STARTED;
+			}
+
+			CurrentData[i] = FMath::Min(MaxData[i], CurrentData[i] + RateData[i] * DeltaTime);
+			if (CurrentData[i] >= MaxData[i])
+			{
+				FlagData[i] &= ~FLAG_RECOVERING;
+				SlotEvents |= EVENT_FULLY_RECOVERED;
+			}
+
+			EventData[i] = SlotEvents;
+		}
+	}, NumChunks < 2);
+}
+
+// ==================== USoulCombatResourceSubsystem ====================
+
+bool USoulCombatResourceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	// 只在游戏世界中接管组件，编辑器预览世界仍由组件自己Tick
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void USoulCombatResourceSubsystem::Deinitialize()
+{
+	StaminaOwners.Empty();
+	PoiseOwners.Empty();
+	PendingPoiseHits.Empty();
+	Stamina = FCombatResourceArrays();
+	Poise = FCombatResourceArrays();
+
+	Super::Deinitialize();
+}
+
+TStatId USoulCombatResourceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USoulCombatResourceSubsystem, STATGROUP_Tickables);
+}
+
+void USoulCombatResourceSubsystem::Tick(float DeltaTime)
+{
+	SOUL_PERFORMANCE_SCOPE(TEXT("CombatResources.Update"));
+
+	// 先结算受击，本帧的恢复起点随之更新
+	ResolvePoiseHits();
+
+	if (Stamina.NumActive == 0 && Poise.NumActive == 0)
+	{
+		return;
+	}
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	Stamina.Update(CurrentTime, DeltaTime);
+	Poise.Update(CurrentTime, DeltaTime);
+
+	SOUL_COUNTER_ADD(TEXT("CombatResources.Slots"), Stamina.NumActive + Poise.NumActive);
+
+	DispatchStaminaEvents();
+	DispatchPoiseEvents();
+}
+
+void USoulCombatResourceSubsystem::DispatchStaminaEvents()
+{
+	// 委托回调可能注销其他组件，按索引遍历并逐个检查
+	for (int32 i = 0; i < Stamina.Events.Num(); ++i)
+	{
+		const uint8 SlotEvents = Stamina.Events[i];
+		if (SlotEvents == 0)
+		{
+			continue;
+		}
+
+		Stamina.Events[i] = 0;
+		if (UStaminaComponent* Component = StaminaOwners[i].Get())
+		{
+			Component->HandleManagedStaminaEvents(SlotEvents);
+		}
+	}
+}
+
+void USoulCombatResourceSubsystem::DispatchPoiseEvents()
+{
+	for (int32 i = 0; i < Poise.Events.Num(); ++i)
+	{
+		const uint8 SlotEvents = Poise.Events[i];
+		if (SlotEvents == 0)
+		{
+			continue;
+		}
+
+		Poise.Events[i] = 0;
+		if (UPoiseComponent* Component = PoiseOwners[i].Get())
+		{
+			Component->HandleManagedPoiseEvents(SlotEvents);
+		}
+	}
+}
+
+// ==================== 精力 ====================
+
+int32 USoulCombatResourceSubsystem::RegisterStamina(UStaminaComponent* Component, const FCombatResourceState& InitialState)
+{
+	if (!Component)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Handle = Stamina.Allocate();
+	if (StaminaOwners.Num() <= Handle)
+	{
+		StaminaOwners.SetNum(Handle + 1);
+	}
+	StaminaOwners[Handle] = Component;
+	Stamina.Write(Handle, InitialState);
+	return Handle;
+}
+
+void USoulCombatResourceSubsystem::UnregisterStamina(int32 Handle)
+{
+	if (Stamina.IsValidSlot(Handle))
+	{
+		Stamina.Free(Handle);
+		StaminaOwners[Handle].Reset();
+	}
+}
+
+
+// ==================== 韧性 ====================
+
+int32 USoulCombatResourceSubsystem::RegisterPoise(UPoiseComponent* Component, const FCombatResourceState& InitialState)
+{
+	if (!Component)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Handle = Poise.Allocate();
+	if (PoiseOwners.Num() <= Handle)
+	{
+		PoiseOwners.SetNum(Handle + 1);
+	}
+	PoiseOwners[Handle] = Component;
+	Poise.Write(Handle, InitialState);
+	return Handle;
+}
+
+void USoulCombatResourceSubsystem::UnregisterPoise(int32 Handle)
+{
+	if (Poise.IsValidSlot(Handle))
+	{
+		Poise.Free(Handle);
+		PoiseOwners[Handle].Reset();
+	}
+}
+
+
+void USoulCombatResourceSubsystem::QueuePoiseHit(UPoiseComponent* Target, float Damage, AActor* DamageSource)
+{
+	if (!Target || Damage <= 0.0f)
+	{
+		return;
+	}
+
+	FQueuedPoiseHit& Hit = PendingPoiseHits.AddDefaulted_GetRef();
+	Hit.Target = Target;
+	Hit.DamageSource = DamageSource;
+	Hit.Damage = Damage;
+	Hit.Sequence = NextPoiseHitSequence++;
+
+	SOUL_COUNTER_INC(TEXT("CombatResources.PoiseHitsQueued"));
+}
+
+void USoulCombatResourceSubsystem::ResolvePoiseHits()
+{
+	if (PendingPoiseHits.Num() == 0)
+	{
+		return;
+	}
+
+	SOUL_PERFORMANCE_SCOPE(TEXT("CombatResources.ResolvePoiseHits"));
+
+	// 结算回调里产生的新受击留到下一帧
+	TArray<FQueuedPoiseHit> Hits = MoveTemp(PendingPoiseHits);
+	PendingPoiseHits.Reset();
+
+	// 目标顺序取本帧首次受击的顺序，不依赖指针地址，保证结果可复现
+	TMap<UPoiseComponent*, int32> TargetOrders;
+	TargetOrders.Reserve(Hits.Num());
+	for (FQueuedPoiseHit& Hit : Hits)
+	{
+		UPoiseComponent* Target = Hit.Target.Get();
+		const int32* Existing = TargetOrders.Find(Target);
+		Hit.TargetOrder = Existing ? *Existing : TargetOrders.Add(Target, TargetOrders.Num());
+	}
+
+	Hits.Sort([](const FQueuedPoiseHit& A, const FQueuedPoiseHit& B)
+	{
+		return A.TargetOrder != B.TargetOrder ? A.TargetOrder < B.TargetOrder : A.Sequence < B.Sequence;
+	});
+
+	int32 RunStart = 0;
+	while (RunStart < Hits.Num())
+	{
+		int32 RunEnd = RunStart + 1;
+		while (RunEnd < Hits.Num() && Hits[RunEnd].TargetOrder == Hits[RunStart].TargetOrder)
+		{
+			++RunEnd;
+		}
+
+		if (UPoiseComponent* Target = Hits[RunStart].Target.Get())
+		{
+			Target->ResolveQueuedPoiseHits(&Hits[RunStart], RunEnd - RunStart);
+		}
+
+		RunStart = RunEnd;
+	}
+
+	SOUL_COUNTER_ADD(TEXT("CombatResources.PoiseTargetsResolved"), TargetOrders.Num());
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SoulCombatResourceSubsystem.generated.h"
+
+class UStaminaComponent;
+class UPoiseComponent;
+
+/**
+ * 注册时交给管理器的槽位初始状态（之后组件通过句柄直接读写槽位）
+ */
+struct FCombatResourceState
+{
+	float Current = 0.0f;
+	float Max = 0.0f;
+	float RecoveryRate = 0.0f;
+
+	/** 自动恢复的起始世界时间，不允许恢复时为 MAX_flt */
+	float RecoveryStartTime = MAX_flt;
+
+	bool bRecovering = false;
+};
+
+/**
+ * 排队等待本帧结算的一次韧性受击
+ */
+struct FQueuedPoiseHit
+{
+	TWeakObjectPtr<UPoiseComponent> Target;
+	TWeakObjectPtr<AActor> DamageSource;
+	float Damage = 0.0f;
+
+	/** 入队顺序，同一目标的受击按此顺序结算 */
+	uint32 Sequence = 0;
+
+	/** 目标在本帧首次受击的顺序，目标之间按此顺序结算 */
+	int32 TargetOrder = 0;
+};
+
+/**
+ * 连续数组存储的一类战斗资源（精力或韧性）
+ * 每帧的恢复积分只读写这几个数组，可以安全地分块并行
+ */
+struct FCombatResourceArrays
+{
+	// 槽位标记
+	static constexpr uint8 FLAG_ACTIVE = 1 << 0;
+	static constexpr uint8 FLAG_RECOVERING = 1 << 1;
+
+	// 本帧产生的事件，批量更新后在游戏线程分发给组件
+	static constexpr uint8 EVENT_RECOVERY_STARTED = 1 << 0;
+	static constexpr uint8 EVENT_CHANGED = 1 << 1;
+	static constexpr uint8 EVENT_FULLY_RECOVERED = 1 << 2;
+
+	TArray<float> Current;
+	TArray<float> Max;
+	TArray<float> RecoveryRate;
+	TArray<float> RecoveryStartTime;
+	TArray<uint8> Flags;
+	TArray<uint8> Events;
+
+	/** 空闲槽位，注销后复用，保持数组紧凑 */
+	TArray<int32> FreeSlots;
+
+	int32 NumActive = 0;
+
+	int32 Allocate();
+	void Free(int32 Slot);
+	void Write(int32 Slot, const FCombatResourceState& State);
+
+	bool IsValidSlot(int32 Slot) const
+	{
+		return Flags.IsValidIndex(Slot) && (Flags[Slot] & FLAG_ACTIVE) != 0;
+	}
+
+	// 托管组件按句柄读写自己的槽位（游戏线程，批量更新之外）
+	float GetCurrent(int32 Slot) const
+	{
+		return IsValidSlot(Slot) ? Current[Slot] : 0.0f;
+	}
+
+	bool IsRecovering(int32 Slot) const
+	{
+		return IsValidSlot(Slot) && (Flags[Slot] & FLAG_RECOVERING) != 0;
+	}
+
+	void SetCurrent(int32 Slot, float Value);
+	void SetRecovering(int32 Slot, bool bRecovering);
+
+	/** 上限、恢复速率与恢复起点由组件的设置和状态决定，变化时写入 */
+	void SetRecoveryParams(int32 Slot, float InMax, float InRecoveryRate, float InRecoveryStartTime);
+
+	/** 并行推进所有槽位的恢复，并填写 Events */
+	void Update(float CurrentTime, float DeltaTime);
+};
+
+/**
+ * 战斗资源管理器
+ * 所有注册角色的精力与韧性数值存放在连续数组中，每帧用一次 ParallelFor 批量恢复
+ * 精力/韧性组件只是句柄：接口不变，数值读写转发到这里，状态机与委托仍在组件上
+ * 组件自己的Tick在注册后关闭
+ */
+UCLASS()
+class SOUL_API USoulCombatResourceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ==================== 精力 ====================
+
+	/** 注册精力组件，返回句柄 */
+	int32 RegisterStamina(UStaminaComponent* Component, const FCombatResourceState& InitialState);
+	void UnregisterStamina(int32 Handle);
+
+	/** 托管期间精力组件通过句柄直接读写这里的槽位 */
+	FCombatResourceArrays& GetStaminaSlots() { return Stamina; }
+	const FCombatResourceArrays& GetStaminaSlots() const { return Stamina; }
+
+	// ==================== 韧性 ====================
+
+	/** 注册韧性组件，返回句柄 */
+	int32 RegisterPoise(UPoiseComponent* Component, const FCombatResourceState& InitialState);
+	void UnregisterPoise(int32 Handle);
+
+	/** 托管期间韧性组件通过句柄直接读写这里的槽位 */
+	FCombatResourceArrays& GetPoiseSlots() { return Poise; }
+	const FCombatResourceArrays& GetPoiseSlots() const { return Poise; }
+
+	/**
+	 * 韧性受击入队，本帧末按目标合并后一次结算
+	 * 结算顺序确定：目标按本帧首次受击的顺序，同一目标内按入队顺序
+	 */
+	void QueuePoiseHit(UPoiseComponent* Target, float Damage, AActor* DamageSource);
+
+	// ==================== 统计 ====================
+
+	UFUNCTION(BlueprintPure, Category = "Combat Resources")
+	int32 GetNumStaminaHandles() const { return Stamina.NumActive; }
+
+	UFUNCTION(BlueprintPure, Category = "Combat Resources")
+	int32 GetNumPoiseHandles() const { return Poise.NumActive; }
+
+private:
+	/** 游戏线程：把本帧事件分发给组件 */
+	void DispatchStaminaEvents();
+	void DispatchPoiseEvents();
+
+	/** 游戏线程：按目标结算排队的韧性受击 */
+	void ResolvePoiseHits();
+
+	FCombatResourceArrays Stamina;
+	TArray<TWeakObjectPtr<UStaminaComponent>> StaminaOwners;
+
+	FCombatResourceArrays Poise;
+	TArray<TWeakObjectPtr<UPoiseComponent>> PoiseOwners;
+
+	TArray<FQueuedPoiseHit> PendingPoiseHits;
+	uint32 NextPoiseHitSequence = 0;
+};
@@ -0,0 +1,222 @@
+#include "SoulInputBufferSubsystem.h"
+#include "MyCharacter.h"
+#include "PerformanceProfiler.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommand CmdInputBufferStats(
+	TEXT("Soul.InputBuffer.Stats"),
+	TEXT("Print buffered-to-executed latency per input command; pass 'reset' to clear: Soul.InputBuffer.Stats [reset]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USoulInputBufferSubsystem* InputBuffer = World ? World->GetSubsystem<USoulInputBufferSubsystem>() : nullptr;
+		if (!InputBuffer)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InputBuffer: No input buffer in this world"));
+			return;
+		}
+
+		InputBuffer->LogStats();
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+		{
+			InputBuffer->ResetStats();
+		}
+	})
+);
+
+static const TCHAR* GetInputCommandName(ESoulInputCommand Command)
+{
+	switch (Command)
+	{
+	case ESoulInputCommand::Dodge:				return TEXT("Dodge");
+	case ESoulInputCommand::ToggleLockOn:		return TEXT("ToggleLockOn");
+	case ESoulInputCommand::SwitchTargetLeft:	return TEXT("SwitchTargetLeft");
+	case ESoulInputCommand::SwitchTargetRight:	return TEXT("SwitchTargetRight");
+	default:									return TEXT("Unknown");
+	}
+}
+
+bool USoulInputBufferSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void USoulInputBufferSubsystem::Deinitialize()
+{
+	PendingCommands.Empty();
+
+	Super::Deinitialize();
+}
+
+bool USoulInputBufferSubsystem::IsTickable() const
+{
+	// 没有待提交指令时不参与Tick
+	return PendingCommands.Num() > 0;
+}
+
+TStatId USoulInputBufferSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USoulInputBufferSubsystem, STATGROUP_Tickables);
+}
+
+bool USoulInputBufferSubsystem::SubmitCommand(AMyCharacter* Owner, ESoulInputCommand Command, float Window, const FVector& Direction)
+{
+	if (!Owner)
+	{
+		return false;
+	}
+
+	FBufferedInputCommand Entry;
+	Entry.Owner = Owner;
+	Entry.Command = Command;
+	Entry.Direction = Direction;
+	Entry.BufferedTime = GetWorld()->GetTimeSeconds();
+	Entry.BufferedFrame = GFrameCounter;
+	Entry.ExpireTime = Entry.BufferedTime + Window;
+
+	// 同类旧指令作废，以最新一次按下为准
+	PendingCommands.RemoveAll([Owner, Command](const FBufferedInputCommand& Pending)
+	{
+		return Pending.Command == Command && Pending.Owner.Get() == Owner;
+	});
+
+	if (Owner->TryCommitBufferedInput(Command, Direction))
+	{
+		++Stats[(int32)Command].NumImmediate;
+		SOUL_COUNTER_INC(TEXT("InputBuffer.Immediate"));
+		return true;
+	}
+
+	if (Window > 0.0f)
+	{
+		PendingCommands.Add(Entry);
+		SOUL_COUNTER_INC(TEXT("InputBuffer.Buffered"));
+	}
+	return false;
+}
+
+void USoulInputBufferSubsystem::Tick(float DeltaTime)
+{
+	SOUL_PERFORMANCE_SCOPE(TEXT("InputBuffer.Tick"));
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	// 提交回调可能再次提交或清空指令，按索引遍历并逐个检查
+	for (int32 i = 0; i < PendingCommands.Num();)
+	{
+		const FBufferedInputCommand Entry = PendingCommands[i];
+		AMyCharacter* Owner = Entry.Owner.Get();
+
+		if (!Owner || CurrentTime > Entry.ExpireTime)
+		{
+			if (Owner)
+			{
+				++Stats[(int32)Entry.Command].NumExpired;
+				SOUL_COUNTER_INC(TEXT("InputBuffer.Expired"));
+			}
+			PendingCommands.RemoveAt(i);
+			continue;
+		}
+
+		if (Owner->TryCommitBufferedInput(Entry.Command, Entry.Direction))
+		{
+			RecordCommit(Entry, CurrentTime);
+
+			const int32 Index = PendingCommands.IndexOfByPredicate([&Entry](const FBufferedInputCommand& Pending)
+			{
+				return Pending.Command == Entry.Command && Pending.Owner == Entry.Owner && Pending.BufferedFrame == Entry.BufferedFrame;
+			});
+			if (Index != INDEX_NONE)
+			{
+				PendingCommands.RemoveAt(Index);
+				if (Index < i)
+				{
+					--i;
+				}
+			}
+			continue;
+		}
+
+		++i;
+	}
+}
+
+void USoulInputBufferSubsystem::RecordCommit(const FBufferedInputCommand& Entry, float CurrentTime)
+{
+	const float Latency = CurrentTime - Entry.BufferedTime;
+
+	FInputBufferCommandStats& CommandStats = Stats[(int32)Entry.Command];
+	++CommandStats.NumBufferedCommits;
+	CommandStats.TotalLatency += Latency;
+	CommandStats.MaxLatency = FMath::Max(CommandStats.MaxLatency, Latency);
+	CommandStats.TotalLatencyFrames += (int32)(GFrameCounter - Entry.BufferedFrame);
+
+	SOUL_COUNTER_INC(TEXT("InputBuffer.Committed"));
+
+	UE_LOG(LogTemp, Verbose, TEXT("InputBuffer: %s committed after %.1f ms (%llu frames)"),
+		GetInputCommandName(Entry.Command), Latency * 1000.0f, GFrameCounter - Entry.BufferedFrame);
+}
+
+void USoulInputBufferSubsystem::ClearCommands(AMyCharacter* Owner)
+{
+	PendingCommands.RemoveAll([Owner](const FBufferedInputCommand& Pending)
+	{
+		return Pending.Owner.Get() == Owner;
+	});
+}
+
+void USoulInputBufferSubsystem::ClearCommand(AMyCharacter* Owner, ESoulInputCommand Command)
+{
+	PendingCommands.RemoveAll([Owner, Command](const FBufferedInputCommand& Pending)
+	{
+		return Pending.Command == Command && Pending.Owner.Get() == Owner;
+	});
+}
+
+bool USoulInputBufferSubsystem::HasPendingCommand(const AMyCharacter* Owner, ESoulInputCommand Command) const
+{
+	return PendingCommands.ContainsByPredicate([Owner, Command](const FBufferedInputCommand& Pending)
+	{
+		return Pending.Command == Command && Pending.Owner.Get() == Owner;
+	});
+}
+
+FInputBufferCommandStats USoulInputBufferSubsystem::GetCommandStats(ESoulInputCommand Command) const
+{
+	const int32 Index = (int32)Command;
+	return Index >= 0 && Index < (int32)ESoulInputCommand::Count ? Stats[Index] : FInputBufferCommandStats();
+}
+
+void USoulInputBufferSubsystem::ResetStats()
+{
+	for (FInputBufferCommandStats& CommandStats : Stats)
+	{
+		CommandStats = FInputBufferCommandStats();
+	}
+}
+
+void USoulInputBufferSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("=== Input Buffer Stats ==="));
+	for (int32 i = 0; i < (int32)ESoulInputCommand::Count; ++i)
+	{
+		const FInputBufferCommandStats& CommandStats = Stats[i];
+		const float AverageFrames = CommandStats.NumBufferedCommits > 0
+			? (float)CommandStats.TotalLatencyFrames / CommandStats.NumBufferedCommits : 0.0f;
+
+		UE_LOG(LogTemp, Log, TEXT("%-18s immediate %4d | buffered %4d (avg %.1f ms / %.1f frames, max %.1f ms) | expired %4d"),
+			GetInputCommandName((ESoulInputCommand)i),
+			CommandStats.NumImmediate,
+			CommandStats.NumBufferedCommits,
+			CommandStats.GetAverageLatency() * 1000.0f,
+			AverageFrames,
+			CommandStats.MaxLatency * 1000.0f,
+			CommandStats.NumExpired);
+	}
+}
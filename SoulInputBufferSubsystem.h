@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SoulInputBufferSubsystem.generated.h"
+
+class AMyCharacter;
+
+// 可缓冲的输入指令
+UENUM(BlueprintType)
+enum class ESoulInputCommand : uint8
+{
+	Dodge				UMETA(DisplayName = "Dodge"),
+	ToggleLockOn		UMETA(DisplayName = "Toggle Lock On"),
+	SwitchTargetLeft	UMETA(DisplayName = "Switch Target Left"),
+	SwitchTargetRight	UMETA(DisplayName = "Switch Target Right"),
+	Count				UMETA(Hidden)
+};
+
+/**
+ * 等待提交的一条输入指令
+ */
+struct FBufferedInputCommand
+{
+	TWeakObjectPtr<AMyCharacter> Owner;
+	ESoulInputCommand Command = ESoulInputCommand::Dodge;
+
+	/** 按下时的移动输入方向（闪避使用） */
+	FVector Direction = FVector::ZeroVector;
+
+	/** 按下时的世界时间与帧号 */
+	float BufferedTime = 0.0f;
+	uint64 BufferedFrame = 0;
+
+	/** 超过该世界时间仍未提交则丢弃 */
+	float ExpireTime = 0.0f;
+};
+
+/**
+ * 单类指令的缓冲统计（从按下到提交的延迟）
+ */
+USTRUCT(BlueprintType)
+struct FInputBufferCommandStats
+{
+	GENERATED_BODY()
+
+	/** 按下当帧即提交的次数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Input Buffer")
+	int32 NumImmediate = 0;
+
+	/** 经过缓冲后提交的次数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Input Buffer")
+	int32 NumBufferedCommits = 0;
+
+	/** 窗口内始终不合法而丢弃的次数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Input Buffer")
+	int32 NumExpired = 0;
+
+	/** 缓冲提交的累计/最大延迟（秒） */
+	UPROPERTY(BlueprintReadOnly, Category = "Input Buffer")
+	float TotalLatency = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Input Buffer")
+	float MaxLatency = 0.0f;
+
+	/** 缓冲提交的累计帧数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Input Buffer")
+	int32 TotalLatencyFrames = 0;
+
+	float GetAverageLatency() const
+	{
+		return NumBufferedCommits > 0 ? TotalLatency / NumBufferedCommits : 0.0f;
+	}
+};
+
+/**
+ * 输入缓冲
+ * 按下时指令不合法（闪避硬直、精力不足、切换目标冷却等）不再直接丢弃，
+ * 而是在窗口时间内保留，每帧重试，第一帧变为合法时立即提交
+ * 同一角色的同类指令只保留最新一条；不同指令按按下顺序提交
+ * 合法性由 AMyCharacter::TryCommitBufferedInput 判断并执行
+ */
+UCLASS()
+class SOUL_API USoulInputBufferSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * 提交一条输入：当帧合法则立即执行，否则缓冲 Window 秒
+	 * Window <= 0 时不缓冲，行为与直接调用一致
+	 * @return 是否已在当帧执行
+	 */
+	bool SubmitCommand(AMyCharacter* Owner, ESoulInputCommand Command, float Window, const FVector& Direction = FVector::ZeroVector);
+
+	/** 丢弃某个角色的所有待提交指令（由处决开始时调用；角色销毁后其指令在下次 Tick 自动清理） */
+	void ClearCommands(AMyCharacter* Owner);
+
+	/** 丢弃某个角色某一类待提交指令（解除锁定时丢弃切换目标等） */
+	void ClearCommand(AMyCharacter* Owner, ESoulInputCommand Command);
+
+	/** 某个角色是否有该类指令在等待 */
+	bool HasPendingCommand(const AMyCharacter* Owner, ESoulInputCommand Command) const;
+
+	// ==================== 统计 ====================
+
+	UFUNCTION(BlueprintPure, Category = "Input Buffer")
+	FInputBufferCommandStats GetCommandStats(ESoulInputCommand Command) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Input Buffer")
+	void ResetStats();
+
+	UFUNCTION(BlueprintPure, Category = "Input Buffer")
+	int32 GetNumPendingCommands() const { return PendingCommands.Num(); }
+
+	/** 输出统计到日志 */
+	void LogStats() const;
+
+private:
+	/** 提交成功后记录延迟 */
+	void RecordCommit(const FBufferedInputCommand& Entry, float CurrentTime);
+
+	TArray<FBufferedInputCommand> PendingCommands;
+
+	FInputBufferCommandStats Stats[(int32)ESoulInputCommand::Count];
+};
@@ -0,0 +1,518 @@
+#include "SoulMetricsWriter.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+
+namespace SoulMetrics
+{
+	static const ANSICHAR BinaryMagic[8] = { 'S', 'O', 'U', 'L', 'M', 'E', 'T', '1' };
+	static constexpr uint32 BinaryVersion = 2;
+	static constexpr uint8 NameRecordTag = 'N';
+	static constexpr uint8 FrameRecordTag = 'F';
+	static const ANSICHAR* CsvHeader = "Frame,FrameTimeMs,Scope,TotalMs,MaxMs,Calls\n";
+
+	template<typename T>
+	FORCEINLINE void AppendPod(TArray<uint8>& Buffer, const T& Value)
+	{
+		Buffer.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	FORCEINLINE void AppendAnsi(TArray<uint8>& Buffer, const ANSICHAR* Text)
+	{
+		Buffer.Append(reinterpret_cast<const uint8*>(Text), FCStringAnsi::Strlen(Text));
+	}
+
+	void AppendNameRecord(TArray<uint8>& Buffer, uint16 Id, const FString& Name)
+	{
+		FTCHARToUTF8 Utf8(*Name);
+		const uint16 Length = static_cast<uint16>(FMath::Min(Utf8.Length(), 0xFFFF));
+		AppendPod(Buffer, NameRecordTag);
+		AppendPod(Buffer, Id);
+		AppendPod(Buffer, Length);
+		Buffer.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+	}
+
+	template<typename T>
+	bool ReadPod(const TArray<uint8>& Data, int64& Offset, T& OutValue)
+	{
+		if (Offset + static_cast<int64>(sizeof(T)) > Data.Num())
+		{
+			return false;
+		}
+		FMemory::Memcpy(&OutValue, Data.GetData() + Offset, sizeof(T));
+		Offset += sizeof(T);
+		return true;
+	}
+}
+
+FSoulMetricsWriter::FSoulMetricsWriter(EProfilerMetricsFormat InFormat, const FString& InDirectory, const FString& InFilePrefix,
+	int64 InMaxFileBytes, int32 InMaxFiles)
+	: Format(InFormat)
+	, Directory(InDirectory)
+	, FilePrefix(InFilePrefix)
+	, MaxFileBytes(FMath::Max<int64>(InMaxFileBytes, 64 * 1024))
+	, MaxFiles(FMath::Max(InMaxFiles, 1))
+{
+	ScratchBuffer.Reserve(4 * 1024);
+	NameScratchBuffer.Reserve(1024);
+	FrontBuffer.Reserve(256 * 1024);
+	BackBuffer.Reserve(256 * 1024);
+}
+
+FSoulMetricsWriter::~FSoulMetricsWriter()
+{
+	Shutdown();
+}
+
+bool FSoulMetricsWriter::Start()
+{
+	if (Thread)
+	{
+		return true;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.CreateDirectoryTree(*Directory))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SoulMetricsWriter: Failed to create directory %s"), *Directory);
+		return false;
+	}
+
+	if (!RotateFile())
+	{
+		return false;
+	}
+
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	bStopRequested = false;
+	Thread = FRunnableThread::Create(this, TEXT("SoulMetricsWriter"), 0, TPri_BelowNormal);
+	if (!Thread)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SoulMetricsWriter: Failed to create writer thread"));
+		FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+		WorkEvent = nullptr;
+		delete FileHandle;
+		FileHandle = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+void FSoulMetricsWriter::Shutdown()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (WorkEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+		WorkEvent = nullptr;
+	}
+
+	if (FileHandle)
+	{
+		FileHandle->Flush();
+		delete FileHandle;
+		FileHandle = nullptr;
+
+		UE_LOG(LogTemp, Log, TEXT("SoulMetricsWriter: Closed %s (%lld bytes written, %d frames dropped)"),
+			*CurrentFilePath, static_cast<long long>(BytesWritten), DroppedFrames.GetValue());
+	}
+}
+
+void FSoulMetricsWriter::SubmitFrame(const FProfilerFrameRecord& Record)
+{
+	ScratchBuffer.Reset();
+
+	if (Format == EProfilerMetricsFormat::Binary)
+	{
+		SerializeFrameBinary(Record);
+	}
+	else
+	{
+		SerializeFrameCsv(Record);
+	}
+
+	{
+		FScopeLock Lock(&BufferLock);
+
+		// 名称记录总是写出：ID已分配，丢弃后后续帧会引用未定义的名称
+		FrontBuffer.Append(NameScratchBuffer);
+		NameScratchBuffer.Reset();
+
+		if (FrontBuffer.Num() + ScratchBuffer.Num() > MAX_BUFFERED_BYTES)
+		{
+			DroppedFrames.Increment();
+			return;
+		}
+		FrontBuffer.Append(ScratchBuffer);
+	}
+
+	if (WorkEvent)
+	{
+		WorkEvent->Trigger();
+	}
+}
+
+FString FSoulMetricsWriter::GetCurrentFilePath() const
+{
+	FScopeLock Lock(&BufferLock);
+	return CurrentFilePath;
+}
+
+uint16 FSoulMetricsWriter::GetNameId(const FString& ScopeName)
+{
+	if (const uint16* ExistingId = NameIds.Find(ScopeName))
+	{
+		return *ExistingId;
+	}
+
+	const uint16 NewId = static_cast<uint16>(NameIds.Num());
+	NameIds.Add(ScopeName, NewId);
+
+	// 名称记录单独暂存，提交时排在本帧数据之前，保证解析时先看到定义
+	SoulMetrics::AppendNameRecord(NameScratchBuffer, NewId, ScopeName);
+
+	FScopeLock Lock(&BufferLock);
+	KnownNames.Add(ScopeName);
+	return NewId;
+}
+
+void FSoulMetricsWriter::RefreshCounterNames(int32 NumCounters)
+{
+	for (int32 CounterId = CounterNames.Num(); CounterId < NumCounters; ++CounterId)
+	{
+		CounterNames.Add(TEXT("counter:") + FSoulCounters::GetName(CounterId));
+		CounterNameIds.Add(Format == EProfilerMetricsFormat::Binary ? GetNameId(CounterNames.Last()) : 0);
+	}
+}
+
+void FSoulMetricsWriter::SerializeFrameCsv(const FProfilerFrameRecord& Record)
+{
+	FString Lines;
+	Lines.Reserve(Record.Scopes.Num() * 64 + 64);
+
+	if (Record.Scopes.Num() == 0)
+	{
+		Lines += FString::Printf(TEXT("%llu,%.3f,,,,\n"), Record.FrameNumber, Record.FrameTimeMs);
+	}
+
+	for (const FFrameScopeSample& Sample : Record.Scopes)
+	{
+		Lines += FString::Printf(TEXT("%llu,%.3f,%s,%.4f,%.4f,%d\n"),
+			Record.FrameNumber, Record.FrameTimeMs, *Sample.ScopeName, Sample.TotalTime, Sample.MaxTime, Sample.CallCount);
+	}
+
+	// 计数器行：Calls 列为本帧计数
+	RefreshCounterNames(Record.CounterValues.Num());
+	for (int32 CounterId = 0; CounterId < Record.CounterValues.Num(); ++CounterId)
+	{
+		if (Record.CounterValues[CounterId] != 0)
+		{
+			Lines += FString::Printf(TEXT("%llu,%.3f,%s,,,%d\n"),
+				Record.FrameNumber, Record.FrameTimeMs, *CounterNames[CounterId], Record.CounterValues[CounterId]);
+		}
+	}
+
+	FTCHARToUTF8 Utf8(*Lines);
+	ScratchBuffer.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+void FSoulMetricsWriter::SerializeFrameBinary(const FProfilerFrameRecord& Record)
+{
+	// 先分配名称ID，新名称的 'N' 记录会排在帧记录之前
+	TArray<uint16, TInlineAllocator<32>> Ids;
+	for (const FFrameScopeSample& Sample : Record.Scopes)
+	{
+		Ids.Add(GetNameId(Sample.ScopeName));
+	}
+	RefreshCounterNames(Record.CounterValues.Num());
+
+	const uint16 ScopeCount = static_cast<uint16>(FMath::Min(Record.Scopes.Num(), 0xFFFF));
+	SoulMetrics::AppendPod(ScratchBuffer, SoulMetrics::FrameRecordTag);
+	SoulMetrics::AppendPod(ScratchBuffer, Record.FrameNumber);
+	SoulMetrics::AppendPod(ScratchBuffer, Record.FrameTimeMs);
+	SoulMetrics::AppendPod(ScratchBuffer, ScopeCount);
+
+	for (int32 i = 0; i < ScopeCount; ++i)
+	{
+		const FFrameScopeSample& Sample = Record.Scopes[i];
+		SoulMetrics::AppendPod(ScratchBuffer, Ids[i]);
+		SoulMetrics::AppendPod(ScratchBuffer, Sample.TotalTime);
+		SoulMetrics::AppendPod(ScratchBuffer, Sample.MaxTime);
+		SoulMetrics::AppendPod(ScratchBuffer, static_cast<uint32>(Sample.CallCount));
+	}
+
+	uint16 NonZeroCounters = 0;
+	for (const int32 Value : Record.CounterValues)
+	{
+		NonZeroCounters += (Value != 0) ? 1 : 0;
+	}
+
+	SoulMetrics::AppendPod(ScratchBuffer, NonZeroCounters);
+	for (int32 CounterId = 0; CounterId < Record.CounterValues.Num(); ++CounterId)
+	{
+		if (Record.CounterValues[CounterId] != 0)
+		{
+			SoulMetrics::AppendPod(ScratchBuffer, CounterNameIds[CounterId]);
+			SoulMetrics::AppendPod(ScratchBuffer, Record.CounterValues[CounterId]);
+		}
+	}
+}
+
+uint32 FSoulMetricsWriter::Run()
+{
+	while (!bStopRequested)
+	{
+		WorkEvent->Wait(100);
+		WriteBackBuffer();
+	}
+
+	// 退出前写出剩余数据
+	WriteBackBuffer();
+	return 0;
+}
+
+void FSoulMetricsWriter::Stop()
+{
+	bStopRequested = true;
+	if (WorkEvent)
+	{
+		WorkEvent->Trigger();
+	}
+}
+
+void FSoulMetricsWriter::WriteBackBuffer()
+{
+	{
+		FScopeLock Lock(&BufferLock);
+		if (FrontBuffer.Num() == 0)
+		{
+			return;
+		}
+		Swap(FrontBuffer, BackBuffer);
+	}
+
+	if (FileHandle && CurrentFileBytes + BackBuffer.Num() > MaxFileBytes)
+	{
+		RotateFile();
+	}
+
+	if (FileHandle && FileHandle->Write(BackBuffer.GetData(), BackBuffer.Num()))
+	{
+		CurrentFileBytes += BackBuffer.Num();
+		BytesWritten += BackBuffer.Num();
+	}
+
+	// 保留容量，交换回前缓冲后不再重新分配
+	BackBuffer.Reset();
+}
+
+bool FSoulMetricsWriter::RotateFile()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (FileHandle)
+	{
+		FileHandle->Flush();
+		delete FileHandle;
+		FileHandle = nullptr;
+	}
+
+	const TCHAR* Extension = (Format == EProfilerMetricsFormat::Binary) ? TEXT("soulmet") : TEXT("csv");
+	const FString NewFilePath = FPaths::Combine(Directory, FString::Printf(TEXT("%s_%s_%03d.%s"),
+		*FilePrefix, *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")), FileIndex++, Extension));
+
+	FileHandle = PlatformFile.OpenWrite(*NewFilePath);
+	if (!FileHandle)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SoulMetricsWriter: Failed to open %s"), *NewFilePath);
+		return false;
+	}
+
+	{
+		FScopeLock Lock(&BufferLock);
+		CurrentFilePath = NewFilePath;
+	}
+	CurrentFileBytes = 0;
+	WrittenFiles.Add(NewFilePath);
+
+	while (WrittenFiles.Num() > MaxFiles)
+	{
+		PlatformFile.DeleteFile(*WrittenFiles[0]);
+		WrittenFiles.RemoveAt(0);
+	}
+
+	WriteFileHeader();
+	return true;
+}
+
+void FSoulMetricsWriter::WriteFileHeader()
+{
+	TArray<uint8> Header;
+
+	if (Format == EProfilerMetricsFormat::Binary)
+	{
+		Header.Append(reinterpret_cast<const uint8*>(SoulMetrics::BinaryMagic), sizeof(SoulMetrics::BinaryMagic));
+		SoulMetrics::AppendPod(Header, SoulMetrics::BinaryVersion);
+
+		// 重写全部已知名称，使每个轮转文件都能单独解析
+		FScopeLock Lock(&BufferLock);
+		for (int32 i = 0; i < KnownNames.Num(); ++i)
+		{
+			SoulMetrics::AppendNameRecord(Header, static_cast<uint16>(i), KnownNames[i]);
+		}
+	}
+	else
+	{
+		SoulMetrics::AppendAnsi(Header, SoulMetrics::CsvHeader);
+	}
+
+	if (FileHandle && FileHandle->Write(Header.GetData(), Header.Num()))
+	{
+		CurrentFileBytes += Header.Num();
+		BytesWritten += Header.Num();
+	}
+}
+
+bool FSoulMetricsWriter::ConvertBinaryToCsv(const FString& InPath, const FString& OutPath)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *InPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SoulMetricsWriter: Failed to read %s"), *InPath);
+		return false;
+	}
+
+	int64 Offset = 0;
+	ANSICHAR Magic[8];
+	uint32 Version = 0;
+	if (Data.Num() < static_cast<int32>(sizeof(Magic) + sizeof(Version))
+		|| FMemory::Memcmp(Data.GetData(), SoulMetrics::BinaryMagic, sizeof(Magic)) != 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SoulMetricsWriter: %s is not a metrics file"), *InPath);
+		return false;
+	}
+	Offset += sizeof(Magic);
+	SoulMetrics::ReadPod(Data, Offset, Version);
+
+	if (Version < 1 || Version > SoulMetrics::BinaryVersion)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SoulMetricsWriter: Unsupported metrics version %u in %s"), Version, *InPath);
+		return false;
+	}
+
+	TMap<uint16, FString> Names;
+	FString Csv = UTF8_TO_TCHAR(SoulMetrics::CsvHeader);
+	int32 FrameCount = 0;
+
+	while (Offset < Data.Num())
+	{
+		uint8 Tag = 0;
+		SoulMetrics::ReadPod(Data, Offset, Tag);
+
+		if (Tag == SoulMetrics::NameRecordTag)
+		{
+			uint16 Id = 0;
+			uint16 Length = 0;
+			if (!SoulMetrics::ReadPod(Data, Offset, Id) || !SoulMetrics::ReadPod(Data, Offset, Length)
+				|| Offset + Length > Data.Num())
+			{
+				break;
+			}
+
+			FUTF8ToTCHAR Name(reinterpret_cast<const ANSICHAR*>(Data.GetData() + Offset), Length);
+			Names.Add(Id, FString(Name.Length(), Name.Get()));
+			Offset += Length;
+		}
+		else if (Tag == SoulMetrics::FrameRecordTag)
+		{
+			uint64 FrameNumber = 0;
+			float FrameTimeMs = 0.0f;
+			uint16 ScopeCount = 0;
+			if (!SoulMetrics::ReadPod(Data, Offset, FrameNumber) || !SoulMetrics::ReadPod(Data, Offset, FrameTimeMs)
+				|| !SoulMetrics::ReadPod(Data, Offset, ScopeCount))
+			{
+				break;
+			}
+
+			if (ScopeCount == 0)
+			{
+				Csv += FString::Printf(TEXT("%llu,%.3f,,,,\n"), FrameNumber, FrameTimeMs);
+			}
+
+			bool bTruncated = false;
+			for (uint16 i = 0; i < ScopeCount && !bTruncated; ++i)
+			{
+				uint16 Id = 0;
+				float TotalMs = 0.0f;
+				float MaxMs = 0.0f;
+				uint32 Calls = 0;
+				if (!SoulMetrics::ReadPod(Data, Offset, Id) || !SoulMetrics::ReadPod(Data, Offset, TotalMs)
+					|| !SoulMetrics::ReadPod(Data, Offset, MaxMs) || !SoulMetrics::ReadPod(Data, Offset, Calls))
+				{
+					bTruncated = true;
+					break;
+				}
+
+				const FString* Name = Names.Find(Id);
+				Csv += FString::Printf(TEXT("%llu,%.3f,%s,%.4f,%.4f,%u\n"),
+					FrameNumber, FrameTimeMs, Name ? **Name : TEXT("?"), TotalMs, MaxMs, Calls);
+			}
+
+			// 版本 2 起帧记录带计数器段
+			uint16 CounterCount = 0;
+			if (!bTruncated && Version >= 2 && !SoulMetrics::ReadPod(Data, Offset, CounterCount))
+			{
+				bTruncated = true;
+			}
+
+			for (uint16 i = 0; i < CounterCount && !bTruncated; ++i)
+			{
+				uint16 Id = 0;
+				int32 Value = 0;
+				if (!SoulMetrics::ReadPod(Data, Offset, Id) || !SoulMetrics::ReadPod(Data, Offset, Value))
+				{
+					bTruncated = true;
+					break;
+				}
+
+				const FString* Name = Names.Find(Id);
+				Csv += FString::Printf(TEXT("%llu,%.3f,%s,,,%d\n"), FrameNumber, FrameTimeMs, Name ? **Name : TEXT("?"), Value);
+			}
+
+			if (bTruncated)
+			{
+				break;
+			}
+
+			++FrameCount;
+		}
+		else
+		{
+			// 文件尾部可能因进程退出而截断
+			UE_LOG(LogTemp, Warning, TEXT("SoulMetricsWriter: Unknown record tag %u at offset %lld, stopping"),
+				Tag, static_cast<long long>(Offset - 1));
+			break;
+		}
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SoulMetricsWriter: Failed to write %s"), *OutPath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("SoulMetricsWriter: Converted %d frames from %s to %s"), FrameCount, *InPath, *OutPath);
+	return true;
+}
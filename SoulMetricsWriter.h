@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "PerformanceProfiler.h"
+
+class FRunnableThread;
+class FEvent;
+class IFileHandle;
+
+/**
+ * 性能指标流式写入器
+ * 游戏线程把每帧的作用域汇总序列化到前缓冲，写入线程交换前后缓冲后落盘
+ * 游戏线程从不等待文件I/O；写入线程跟不上时丢弃帧并计数
+ *
+ * 二进制格式（小端）：
+ *   文件头  : "SOULMET1" + uint32 版本号
+ *   'N' 记录: uint16 名称ID, uint16 字节数, UTF-8 名称
+ *   'F' 记录: uint64 帧号, float 帧时间(ms), uint16 作用域数,
+ *             每个作用域 { uint16 名称ID, float 总耗时(ms), float 最大耗时(ms), uint32 调用次数 },
+ *             uint16 计数器数, 每个非零计数器 { uint16 名称ID, int32 本帧计数 }
+ * 计数器名称带 "counter:" 前缀，与作用域共用名称表
+ * 每个轮转后的文件都会重写文件头和全部名称记录，可以单独解析
+ */
+class SOUL_API FSoulMetricsWriter : public FRunnable
+{
+public:
+	FSoulMetricsWriter(EProfilerMetricsFormat InFormat, const FString& InDirectory, const FString& InFilePrefix,
+		int64 InMaxFileBytes = 64 * 1024 * 1024, int32 InMaxFiles = 8);
+	virtual ~FSoulMetricsWriter();
+
+	/** 创建写入线程 */
+	bool Start();
+
+	/** 写出剩余数据并结束写入线程（阻塞，只在停止采集时调用） */
+	void Shutdown();
+
+	/** 提交一帧数据（游戏线程） */
+	void SubmitFrame(const FProfilerFrameRecord& Record);
+
+	EProfilerMetricsFormat GetFormat() const { return Format; }
+	int32 GetDroppedFrameCount() const { return DroppedFrames.GetValue(); }
+	int64 GetBytesWritten() const { return BytesWritten; }
+	FString GetCurrentFilePath() const;
+
+	/**
+	 * 离线转换：二进制指标文件转为CSV
+	 * @return 成功返回true
+	 */
+	static bool ConvertBinaryToCsv(const FString& InPath, const FString& OutPath);
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	/** 写入线程：把后缓冲写入当前文件，必要时轮转 */
+	void WriteBackBuffer();
+
+	/** 写入线程：关闭当前文件并打开新文件，超出数量上限时删除最旧的文件 */
+	bool RotateFile();
+
+	/** 写入线程：写文件头（CSV表头或二进制魔数 + 名称表） */
+	void WriteFileHeader();
+
+	/** 游戏线程：获取或分配作用域名称ID，新名称会写入一条 'N' 记录 */
+	uint16 GetNameId(const FString& ScopeName);
+
+	void SerializeFrameCsv(const FProfilerFrameRecord& Record);
+	void SerializeFrameBinary(const FProfilerFrameRecord& Record);
+
+	EProfilerMetricsFormat Format;
+	FString Directory;
+	FString FilePrefix;
+	int64 MaxFileBytes;
+	int32 MaxFiles;
+
+	/** 前缓冲超过此大小时丢帧，防止写入线程停滞时内存无限增长 */
+	static constexpr int32 MAX_BUFFERED_BYTES = 8 * 1024 * 1024;
+
+	/** 游戏线程的序列化暂存区（仅游戏线程访问） */
+	TArray<uint8> ScratchBuffer;
+
+	/** 本帧新名称的 'N' 记录暂存区，即使帧被丢弃也会写出（仅游戏线程访问） */
+	TArray<uint8> NameScratchBuffer;
+
+	/** 游戏线程名称表（仅游戏线程访问） */
+	TMap<FString, uint16> NameIds;
+
+	/** 计数器ID -> 带前缀的名称 / 名称ID（仅游戏线程访问，计数器新增时补齐） */
+	TArray<FString> CounterNames;
+	TArray<uint16> CounterNameIds;
+
+	/** 补齐新注册的计数器名称 */
+	void RefreshCounterNames(int32 NumCounters);
+
+	/** 前缓冲：游戏线程追加，受 BufferLock 保护 */
+	TArray<uint8> FrontBuffer;
+
+	/** 后缓冲：仅写入线程访问 */
+	TArray<uint8> BackBuffer;
+
+	/** 已注册的名称（写入线程轮转时用来重写名称表），受 BufferLock 保护 */
+	TArray<FString> KnownNames;
+
+	mutable FCriticalSection BufferLock;
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WorkEvent = nullptr;
+	FThreadSafeBool bStopRequested;
+	FThreadSafeCounter DroppedFrames;
+
+	// 以下仅写入线程访问（BytesWritten 只做统计显示）
+	IFileHandle* FileHandle = nullptr;
+	FString CurrentFilePath;
+	int64 CurrentFileBytes = 0;
+	int32 FileIndex = 0;
+	TArray<FString> WrittenFiles;
+	volatile int64 BytesWritten = 0;
+};
@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "StaminaComponent.h"
+#include "SoulCombatResourceSubsystem.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 
@@ -21,6 +22,9 @@ UStaminaComponent::UStaminaComponent()
 	StaminaRecoveryStartTime = 0.0f;
 	bIsRecoveringStamina = false;
 	ExhaustedCounter = 0;
+	LazyAnchorTime = 0.0f;
+	LazyRecoveryRate = 0.0f;
+	ResourceHandle = INDEX_NONE;
 
 	UE_LOG(LogTemp, Warning, TEXT("StaminaComponent: Component created with MaxStamina=%.1f"), StaminaSettings.MaxStamina);
 }
@@ -39,13 +43,30 @@ void UStaminaComponent::BeginPlay()
 	{
 		LastStaminaUseTime = World->GetTimeSeconds();
 		StaminaRecoveryStartTime = LastStaminaUseTime;
+		LazyAnchorTime = LastStaminaUseTime;
 	}
 
+	// 托管或惰性模式下关闭Tick
+	ApplyEvaluationMode();
+
 	// ������ʼ�¼�
 	TriggerStaminaChangedEvent();
 
 	UE_LOG(LogTemp, Warning, TEXT("StaminaComponent: BeginPlay completed. Current stamina: %.1f/%.1f"), 
-		CurrentStamina, StaminaSettings.MaxStamina);
+		GetStaminaValue(), StaminaSettings.MaxStamina);
+}
+
+void UStaminaComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(LazyRecoveryStartTimerHandle);
+		World->GetTimerManager().ClearTimer(LazyFullRecoveryTimerHandle);
+	}
+
+	UnregisterFromResourceManager();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // ÿ֡����
@@ -54,7 +75,7 @@ void UStaminaComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	// ���¾����ָ��߼�
-	if (bStaminaRecoveryEnabled && CurrentStamina < StaminaSettings.MaxStamina)
+	if (!StaminaSettings.bUseLazyEvaluation && bStaminaRecoveryEnabled && GetStaminaValue() < StaminaSettings.MaxStamina)
 	{
 		UpdateStaminaRecovery(DeltaTime);
 	}
@@ -71,24 +92,26 @@ bool UStaminaComponent::ConsumeStamina(float Amount)
 		return false;
 	}
 
+	SyncLazyStamina();
+
 	// ����Ƿ����㹻����
-	if (CurrentStamina < Amount)
+	if (GetStaminaValue() < Amount)
 	{
 		UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Insufficient stamina. Required: %.1f, Available: %.1f"), 
-			Amount, CurrentStamina);
+			Amount, GetStaminaValue());
 		return false;
 	}
 
 	// ���ľ���
-	float OldStamina = CurrentStamina;
-	CurrentStamina -= Amount;
+	float OldStamina = GetStaminaValue();
+	SetStaminaValue(OldStamina - Amount);
 	ClampStaminaValue();
 
 	// ����ʱ���¼
 	if (UWorld* World = GetWorld())
 	{
 		LastStaminaUseTime = World->GetTimeSeconds();
-		bIsRecoveringStamina = false; // ֹͣ�ָ�״̬
+		SetRecoveringStamina(false); // ֹͣ�ָ�״̬
 	}
 
 	// ��龫���ľ�
@@ -97,8 +120,11 @@ bool UStaminaComponent::ConsumeStamina(float Amount)
 	// �����¼�
 	TriggerStaminaChangedEvent();
 
+	// 惰性模式：按恢复延迟预约开始恢复
+	ScheduleLazyStaminaEvents();
+
 	UE_LOG(LogTemp, Verbose, TEXT("StaminaComponent: Consumed %.1f stamina. %.1f -> %.1f"), 
-		Amount, OldStamina, CurrentStamina);
+		Amount, OldStamina, GetStaminaValue());
 
 	return true;
 }
@@ -123,7 +149,7 @@ bool UStaminaComponent::ConsumeStaminaForAction(EStaminaAction Action)
 	else
 	{
 		UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Action failed due to insufficient stamina. Type: %d, Cost: %.1f, Available: %.1f"), 
-			(int32)Action, ActionCost, CurrentStamina);
+			(int32)Action, ActionCost, GetStaminaValue());
 	}
 
 	return bSuccess;
@@ -132,7 +158,7 @@ bool UStaminaComponent::ConsumeStaminaForAction(EStaminaAction Action)
 bool UStaminaComponent::CanPerformAction(EStaminaAction Action) const
 {
 	float ActionCost = GetActionStaminaCost(Action);
-	bool bCanPerform = (CurrentStamina >= ActionCost) && (ActionCost > 0.0f);
+	bool bCanPerform = (GetCurrentStamina() >= ActionCost) && (ActionCost > 0.0f);
 	
 	return bCanPerform;
 }
@@ -144,15 +170,17 @@ void UStaminaComponent::RecoverStamina(float Amount)
 		return;
 	}
 
-	float OldStamina = CurrentStamina;
-	CurrentStamina += Amount;
+	SyncLazyStamina();
+
+	float OldStamina = GetStaminaValue();
+	SetStaminaValue(OldStamina + Amount);
 	ClampStaminaValue();
 
 	// �����ȫ�ָ�
 	CheckStaminaFullRecovery();
 
 	// ����״̬
-	if (CurrentStamina > 0.0f && CurrentStaminaState == EStaminaState::Depleted)
+	if (GetStaminaValue() > 0.0f && CurrentStaminaState == EStaminaState::Depleted)
 	{
 		UpdateStaminaState(EStaminaState::Recovering);
 	}
@@ -160,29 +188,40 @@ void UStaminaComponent::RecoverStamina(float Amount)
 	// �����¼�
 	TriggerStaminaChangedEvent();
 
+	ScheduleLazyStaminaEvents();
+
 	UE_LOG(LogTemp, Verbose, TEXT("StaminaComponent: Recovered %.1f stamina. %.1f -> %.1f"), 
-		Amount, OldStamina, CurrentStamina);
+		Amount, OldStamina, GetStaminaValue());
 }
 
 void UStaminaComponent::ResetStamina()
 {
-	float OldStamina = CurrentStamina;
-	CurrentStamina = StaminaSettings.MaxStamina;
+	float OldStamina = GetStaminaValue();
+	SetStaminaValue(StaminaSettings.MaxStamina);
 	
 	// ����״̬
 	UpdateStaminaState(EStaminaState::Normal);
 	ExhaustedCounter = 0;
-	bIsRecoveringStamina = false;
+	SetRecoveringStamina(false);
+
+	// 已满，惰性模式清掉待触发的定时器
+	if (UWorld* World = GetWorld())
+	{
+		LazyAnchorTime = World->GetTimeSeconds();
+	}
+	ScheduleLazyStaminaEvents();
 
 	// �����¼�
 	TriggerStaminaChangedEvent();
 	OnStaminaFullyRecovered.Broadcast();
 
-	UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Stamina reset. %.1f -> %.1f"), OldStamina, CurrentStamina);
+	UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Stamina reset. %.1f -> %.1f"), OldStamina, GetStaminaValue());
 }
 
 void UStaminaComponent::SetStaminaRecoveryEnabled(bool bEnabled)
 {
+	SyncLazyStamina();
+
 	bool bOldValue = bStaminaRecoveryEnabled;
 	bStaminaRecoveryEnabled = bEnabled;
 
@@ -195,6 +234,8 @@ void UStaminaComponent::SetStaminaRecoveryEnabled(bool bEnabled)
 		}
 	}
 
+	ScheduleLazyStaminaEvents();
+
 	UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Stamina recovery %s"), 
 		bEnabled ? TEXT("enabled") : TEXT("disabled"));
 }
@@ -208,18 +249,39 @@ float UStaminaComponent::GetStaminaPercentage() const
 		return 0.0f;
 	}
 
-	return FMath::Clamp(CurrentStamina / StaminaSettings.MaxStamina, 0.0f, 1.0f);
+	return FMath::Clamp(GetCurrentStamina() / StaminaSettings.MaxStamina, 0.0f, 1.0f);
 }
 
 bool UStaminaComponent::IsStaminaFull() const
 {
-	return FMath::IsNearlyEqual(CurrentStamina, StaminaSettings.MaxStamina, 0.01f);
+	return FMath::IsNearlyEqual(GetCurrentStamina(), StaminaSettings.MaxStamina, 0.01f);
+}
+
+float UStaminaComponent::GetCurrentStamina() const
+{
+	if (IsManagedByResourceManager())
+	{
+		return GetStaminaValue();
+	}
+
+	if (StaminaSettings.bUseLazyEvaluation)
+	{
+		if (const UWorld* World = GetWorld())
+		{
+			return EvaluateLazyStamina(World->GetTimeSeconds());
+		}
+	}
+
+	return CurrentStamina;
 }
 
 // ==================== ���ýӿ�ʵ�� ====================
 
 void UStaminaComponent::SetStaminaSettings(const FStaminaSettings& NewSettings)
 {
+	// 先按旧设置结算惰性精力
+	SyncLazyStamina();
+
 	// ���浱ǰ�����ٷֱ�
 	float CurrentPercentage = GetStaminaPercentage();
 
@@ -227,14 +289,20 @@ void UStaminaComponent::SetStaminaSettings(const FStaminaSettings& NewSettings)
 	StaminaSettings = NewSettings;
 
 	// �����µ����ֵ������ǰ����
-	CurrentStamina = StaminaSettings.MaxStamina * CurrentPercentage;
+	SetStaminaValue(StaminaSettings.MaxStamina * CurrentPercentage);
 	ClampStaminaValue();
 
+	// 模式可能变化：切换Tick并重新预约事件
+	if (HasBegunPlay())
+	{
+		ApplyEvaluationMode();
+	}
+
 	// �����¼�
 	TriggerStaminaChangedEvent();
 
 	UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Settings updated. New MaxStamina: %.1f, Current: %.1f"), 
-		StaminaSettings.MaxStamina, CurrentStamina);
+		StaminaSettings.MaxStamina, GetStaminaValue());
 }
 
 void UStaminaComponent::SetMaxStamina(float NewMaxStamina)
@@ -245,6 +313,8 @@ void UStaminaComponent::SetMaxStamina(float NewMaxStamina)
 		return;
 	}
 
+	SyncLazyStamina();
+
 	// ���浱ǰ�����ٷֱ�
 	float CurrentPercentage = GetStaminaPercentage();
 
@@ -252,21 +322,23 @@ void UStaminaComponent::SetMaxStamina(float NewMaxStamina)
 	StaminaSettings.MaxStamina = NewMaxStamina;
 
 	// �����µ����ֵ������ǰ����
-	CurrentStamina = StaminaSettings.MaxStamina * CurrentPercentage;
+	SetStaminaValue(StaminaSettings.MaxStamina * CurrentPercentage);
 	ClampStaminaValue();
 
 	// �����¼�
 	TriggerStaminaChangedEvent();
 
+	ScheduleLazyStaminaEvents();
+
 	UE_LOG(LogTemp, Log, TEXT("StaminaComponent: Max stamina updated to %.1f, Current: %.1f"), 
-		NewMaxStamina, CurrentStamina);
+		NewMaxStamina, GetStaminaValue());
 }
 
 // ==================== ˽�и�������ʵ�� ====================
 
 void UStaminaComponent::UpdateStaminaRecovery(float DeltaTime)
 {
-	if (!bStaminaRecoveryEnabled || CurrentStamina >= StaminaSettings.MaxStamina)
+	if (!bStaminaRecoveryEnabled || GetStaminaValue() >= StaminaSettings.MaxStamina)
 	{
 		return;
 	}
@@ -287,9 +359,9 @@ void UStaminaComponent::UpdateStaminaRecovery(float DeltaTime)
 	}
 
 	// ��ʼ�ָ��������û��ʼ��
-	if (!bIsRecoveringStamina)
+	if (!IsRecoveringStamina())
 	{
-		bIsRecoveringStamina = true;
+		SetRecoveringStamina(true);
 		StaminaRecoveryStartTime = CurrentTime;
 		
 		// ����״̬Ϊ�ָ���
@@ -351,12 +423,12 @@ void UStaminaComponent::UpdateStaminaState(EStaminaState NewState)
 
 void UStaminaComponent::TriggerStaminaChangedEvent()
 {
-	OnStaminaChanged.Broadcast(CurrentStamina, StaminaSettings.MaxStamina);
+	OnStaminaChanged.Broadcast(GetStaminaValue(), StaminaSettings.MaxStamina);
 }
 
 void UStaminaComponent::CheckStaminaDepletion()
 {
-	if (CurrentStamina <= 0.0f && CurrentStaminaState != EStaminaState::Depleted)
+	if (GetStaminaValue() <= 0.0f && CurrentStaminaState != EStaminaState::Depleted)
 	{
 		UpdateStaminaState(EStaminaState::Depleted);
 		ExhaustedCounter++;
@@ -378,7 +450,7 @@ void UStaminaComponent::CheckStaminaFullRecovery()
 	if (IsStaminaFull() && CurrentStaminaState != EStaminaState::Normal)
 	{
 		UpdateStaminaState(EStaminaState::Normal);
-		bIsRecoveringStamina = false;
+		SetRecoveringStamina(false);
 		
 		// ���ù���ƣ�ͼ���������ȫ�ָ���
 		if (ExhaustedCounter > 0)
@@ -407,5 +479,280 @@ float UStaminaComponent::GetCurrentRecoveryRate() const
 
 void UStaminaComponent::ClampStaminaValue()
 {
-	CurrentStamina = FMath::Clamp(CurrentStamina, 0.0f, StaminaSettings.MaxStamina);
-}
\ No newline at end of file
+	SetStaminaValue(FMath::Clamp(GetStaminaValue(), 0.0f, StaminaSettings.MaxStamina));
+}
+
+// ==================== 惰性求值 ====================
+
+float UStaminaComponent::EvaluateLazyStamina(float Time) const
+{
+	if (!bStaminaRecoveryEnabled || !bIsRecoveringStamina || LazyRecoveryRate <= 0.0f)
+	{
+		return CurrentStamina;
+	}
+
+	// value(t) = min(Max, value0 + rate * (t - t0))
+	const float Elapsed = FMath::Max(0.0f, Time - LazyAnchorTime);
+	return FMath::Min(StaminaSettings.MaxStamina, CurrentStamina + LazyRecoveryRate * Elapsed);
+}
+
+void UStaminaComponent::SyncLazyStamina()
+{
+	if (!StaminaSettings.bUseLazyEvaluation)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	const float Now = World->GetTimeSeconds();
+	CurrentStamina = EvaluateLazyStamina(Now);
+	LazyAnchorTime = Now;
+}
+
+void UStaminaComponent::ScheduleLazyStaminaEvents()
+{
+	if (IsManagedByResourceManager())
+	{
+		// 数值与恢复标记已直接写在槽位中，这里只更新由设置和状态决定的恢复参数
+		ResourceManager->GetStaminaSlots().SetRecoveryParams(ResourceHandle,
+			StaminaSettings.MaxStamina, GetCurrentRecoveryRate(), GetManagedRecoveryStartTime());
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World || !StaminaSettings.bUseLazyEvaluation)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	TimerManager.ClearTimer(LazyRecoveryStartTimerHandle);
+	TimerManager.ClearTimer(LazyFullRecoveryTimerHandle);
+
+	if (!bStaminaRecoveryEnabled || CurrentStamina >= StaminaSettings.MaxStamina)
+	{
+		return;
+	}
+
+	const float Now = World->GetTimeSeconds();
+
+	if (!bIsRecoveringStamina)
+	{
+		const float TimeUntilRecovery = LastStaminaUseTime + StaminaSettings.StaminaRecoveryDelay - Now;
+		if (TimeUntilRecovery > 0.0f)
+		{
+			TimerManager.SetTimer(LazyRecoveryStartTimerHandle, this, &UStaminaComponent::OnLazyRecoveryStart, TimeUntilRecovery, false);
+		}
+		else
+		{
+			// 延迟早已结束（例如刚重新启用恢复），立即开始
+			OnLazyRecoveryStart();
+		}
+		return;
+	}
+
+	LazyRecoveryRate = GetCurrentRecoveryRate();
+	if (LazyRecoveryRate <= 0.0f)
+	{
+		return;
+	}
+
+	const float TimeUntilFull = (StaminaSettings.MaxStamina - EvaluateLazyStamina(Now)) / LazyRecoveryRate;
+	TimerManager.SetTimer(LazyFullRecoveryTimerHandle, this, &UStaminaComponent::OnLazyFullRecovery, FMath::Max(TimeUntilFull, KINDA_SMALL_NUMBER), false);
+}
+
+void UStaminaComponent::OnLazyRecoveryStart()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// 锚定在预测的恢复起点，定时器晚到的那部分由闭式公式补上
+	const float Now = World->GetTimeSeconds();
+	const float PredictedStart = FMath::Max(LazyAnchorTime, LastStaminaUseTime + StaminaSettings.StaminaRecoveryDelay);
+	LazyAnchorTime = FMath::Min(PredictedStart, Now);
+	StaminaRecoveryStartTime = LazyAnchorTime;
+	bIsRecoveringStamina = true;
+
+	if (CurrentStaminaState != EStaminaState::Recovering && CurrentStaminaState != EStaminaState::Normal)
+	{
+		UpdateStaminaState(EStaminaState::Recovering);
+	}
+
+	ScheduleLazyStaminaEvents();
+	TriggerStaminaChangedEvent();
+}
+
+void UStaminaComponent::OnLazyFullRecovery()
+{
+	SyncLazyStamina();
+	CurrentStamina = StaminaSettings.MaxStamina;
+
+	CheckStaminaFullRecovery();
+	bIsRecoveringStamina = false;
+
+	TriggerStaminaChangedEvent();
+}
+
+void UStaminaComponent::ApplyEvaluationMode()
+{
+	const bool bLazy = StaminaSettings.bUseLazyEvaluation;
+
+	// 非惰性模式可选交给战斗资源管理器批量更新，未开启或没有管理器时使用组件Tick
+	if (bLazy || !StaminaSettings.bUseResourceManager)
+	{
+		UnregisterFromResourceManager();
+	}
+	else
+	{
+		RegisterWithResourceManager();
+	}
+	SetComponentTickEnabled(!bLazy && !IsManagedByResourceManager());
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	if (bLazy)
+	{
+		LazyAnchorTime = World->GetTimeSeconds();
+	}
+	else
+	{
+		World->GetTimerManager().ClearTimer(LazyRecoveryStartTimerHandle);
+		World->GetTimerManager().ClearTimer(LazyFullRecoveryTimerHandle);
+	}
+
+	// 惰性模式预约定时器，托管模式更新槽位的恢复参数
+	ScheduleLazyStaminaEvents();
+}
+
+// ==================== 战斗资源管理器 ====================
+
+void UStaminaComponent::RegisterWithResourceManager()
+{
+	if (IsManagedByResourceManager())
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	USoulCombatResourceSubsystem* Manager = World ? World->GetSubsystem<USoulCombatResourceSubsystem>() : nullptr;
+	if (!Manager)
+	{
+		return;
+	}
+
+	// 把组件上的数值交给槽位，之后托管期间只通过句柄读写
+	FCombatResourceState InitialState;
+	InitialState.Current = CurrentStamina;
+	InitialState.Max = StaminaSettings.MaxStamina;
+	InitialState.RecoveryRate = GetCurrentRecoveryRate();
+	InitialState.RecoveryStartTime = GetManagedRecoveryStartTime();
+	InitialState.bRecovering = bIsRecoveringStamina;
+
+	ResourceManager = Manager;
+	ResourceHandle = Manager->RegisterStamina(this, InitialState);
+}
+
+void UStaminaComponent::UnregisterFromResourceManager()
+{
+	if (IsManagedByResourceManager())
+	{
+		// 取回槽位中的数值，切换到其他模式后继续使用
+		const FCombatResourceArrays& Slots = ResourceManager->GetStaminaSlots();
+		CurrentStamina = Slots.GetCurrent(ResourceHandle);
+		bIsRecoveringStamina = Slots.IsRecovering(ResourceHandle);
+		ResourceManager->UnregisterStamina(ResourceHandle);
+	}
+
+	ResourceHandle = INDEX_NONE;
+	ResourceManager.Reset();
+}
+
+bool UStaminaComponent::IsManagedByResourceManager() const
+{
+	return ResourceHandle != INDEX_NONE && ResourceManager.IsValid();
+}
+
+float UStaminaComponent::GetManagedRecoveryStartTime() const
+{
+	return bStaminaRecoveryEnabled ? LastStaminaUseTime + StaminaSettings.StaminaRecoveryDelay : MAX_flt;
+}
+
+float UStaminaComponent::GetStaminaValue() const
+{
+	return IsManagedByResourceManager() ? ResourceManager->GetStaminaSlots().GetCurrent(ResourceHandle) : CurrentStamina;
+}
+
+void UStaminaComponent::SetStaminaValue(float NewValue)
+{
+	if (IsManagedByResourceManager())
+	{
+		ResourceManager->GetStaminaSlots().SetCurrent(ResourceHandle, NewValue);
+	}
+	else
+	{
+		CurrentStamina = NewValue;
+	}
+}
+
+bool UStaminaComponent::IsRecoveringStamina() const
+{
+	return IsManagedByResourceManager() ? ResourceManager->GetStaminaSlots().IsRecovering(ResourceHandle) : bIsRecoveringStamina;
+}
+
+void UStaminaComponent::SetRecoveringStamina(bool bRecovering)
+{
+	if (IsManagedByResourceManager())
+	{
+		ResourceManager->GetStaminaSlots().SetRecovering(ResourceHandle, bRecovering);
+	}
+	else
+	{
+		bIsRecoveringStamina = bRecovering;
+	}
+}
+
+void UStaminaComponent::HandleManagedStaminaEvents(uint8 Events)
+{
+	// 恢复标记已由批量更新写入槽位
+	if (Events & FCombatResourceArrays::EVENT_RECOVERY_STARTED)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			StaminaRecoveryStartTime = World->GetTimeSeconds();
+		}
+
+		// 从耗尽/疲劳状态进入恢复状态（正常状态下恢复不改变状态）
+		if (CurrentStaminaState != EStaminaState::Recovering && CurrentStaminaState != EStaminaState::Normal)
+		{
+			UpdateStaminaState(EStaminaState::Recovering);
+		}
+	}
+
+	if (Events & FCombatResourceArrays::EVENT_FULLY_RECOVERED)
+	{
+		CheckStaminaFullRecovery();
+	}
+
+	if (Events & FCombatResourceArrays::EVENT_CHANGED)
+	{
+		TriggerStaminaChangedEvent();
+	}
+
+	// 状态变化会影响恢复速率（过度疲劳惩罚），更新槽位的恢复参数
+	if (Events & (FCombatResourceArrays::EVENT_RECOVERY_STARTED | FCombatResourceArrays::EVENT_FULLY_RECOVERED))
+	{
+		ScheduleLazyStaminaEvents();
+	}
+}
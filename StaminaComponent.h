@@ -7,6 +7,8 @@
 #include "Engine/Engine.h"
 #include "StaminaComponent.generated.h"
 
+class USoulCombatResourceSubsystem;
+
 // ����״̬ö��
 UENUM(BlueprintType)
 enum class EStaminaState : uint8
@@ -51,6 +53,15 @@ struct FStaminaSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stamina Settings", meta = (ClampMin = "0.1", ClampMax = "1.0"))
 	float ExhaustedRecoveryPenalty = 0.5f;
 
+	// 惰性求值模式：关闭组件Tick，精力按 (数值, 时间戳, 速率) 在读取时闭式计算
+	// 开始恢复/完全恢复由定时器在预测时刻触发；OnStaminaChanged 只在离散事件时广播，UI应直接读取 GetCurrentStamina
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stamina Settings")
+	bool bUseLazyEvaluation = false;
+
+	// 非惰性模式下交给战斗资源管理器批量更新并关闭组件Tick（默认关闭，沿用组件Tick）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stamina Settings")
+	bool bUseResourceManager = false;
+
 	// ��ͨ������������
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Action Costs", meta = (ClampMin = "1.0", ClampMax = "100.0"))
 	float AttackStaminaCost = 20.0f;
@@ -116,6 +127,9 @@ protected:
 	// ��Ϸ��ʼʱ����
 	virtual void BeginPlay() override;
 
+	// 结束时清理惰性模式定时器
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// ÿ֡����
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -173,7 +187,7 @@ public:
 	 * @return ��ǰ����ֵ
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stamina")
-	float GetCurrentStamina() const { return CurrentStamina; }
+	float GetCurrentStamina() const;
 
 	/**
 	 * ��ȡ�����ٷֱȣ�0.0 - 1.0��
@@ -233,6 +247,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Stamina")
 	void SetMaxStamina(float NewMaxStamina);
 
+	/**
+	 * 战斗资源管理器批量更新后回调（恢复开始/数值变化/恢复满）
+	 * @param Events FCombatResourceArrays::EVENT_* 组合
+	 */
+	void HandleManagedStaminaEvents(uint8 Events);
+
 	// ==================== �¼�ί�� ====================
 
 	// �����仯�¼�
@@ -285,6 +305,28 @@ protected:
 	// ����ƣ�ͼ�����
 	int32 ExhaustedCounter;
 
+	// ==================== 惰性求值状态 ====================
+
+	// 惰性模式下 CurrentStamina 对应的时间戳（恢复中时为恢复起点）
+	float LazyAnchorTime;
+
+	// 惰性模式下的恢复速率（开始恢复时确定）
+	float LazyRecoveryRate;
+
+	// 预测的开始恢复时刻
+	FTimerHandle LazyRecoveryStartTimerHandle;
+
+	// 预测的完全恢复时刻
+	FTimerHandle LazyFullRecoveryTimerHandle;
+
+	// ==================== 战斗资源管理器 ====================
+
+	// 管理器中的句柄，INDEX_NONE 表示未托管（组件自己Tick或惰性模式）
+	int32 ResourceHandle;
+
+	// 托管时精力值与恢复标记只存放在管理器的槽位中，CurrentStamina / bIsRecoveringStamina 不再使用
+	TWeakObjectPtr<USoulCombatResourceSubsystem> ResourceManager;
+
 private:
 	// ==================== ˽�и������� ====================
 
@@ -294,6 +336,71 @@ private:
 	 */
 	void UpdateStaminaRecovery(float DeltaTime);
 
+	/**
+	 * 惰性模式：按闭式公式计算指定时刻的精力值
+	 * @param Time 世界时间
+	 * @return 该时刻的精力值
+	 */
+	float EvaluateLazyStamina(float Time) const;
+
+	/**
+	 * 惰性模式：把当前时刻的闭式结果写回 CurrentStamina 并重设时间戳（修改精力前调用）
+	 */
+	void SyncLazyStamina();
+
+	/**
+	 * 惰性模式：按当前状态重新安排开始恢复/完全恢复定时器
+	 * 托管模式：把上限、恢复速率和恢复起点写入槽位
+	 */
+	void ScheduleLazyStaminaEvents();
+
+	/**
+	 * 惰性模式定时器回调：恢复延迟结束，开始恢复
+	 */
+	void OnLazyRecoveryStart();
+
+	/**
+	 * 惰性模式定时器回调：精力恢复满
+	 */
+	void OnLazyFullRecovery();
+
+	/**
+	 * 切换托管/Tick/惰性模式（BeginPlay或设置变化时调用）
+	 */
+	void ApplyEvaluationMode();
+
+	/**
+	 * 注册到战斗资源管理器（世界中没有管理器时保持组件Tick）
+	 */
+	void RegisterWithResourceManager();
+
+	/**
+	 * 从战斗资源管理器注销
+	 */
+	void UnregisterFromResourceManager();
+
+	/**
+	 * 是否由战斗资源管理器托管
+	 */
+	bool IsManagedByResourceManager() const;
+
+	/**
+	 * 托管模式下槽位的恢复起点（恢复被禁用时为 MAX_flt）
+	 */
+	float GetManagedRecoveryStartTime() const;
+
+	/**
+	 * 精力值读写：托管时直接读写槽位，否则读写 CurrentStamina（惰性模式下为锚点值）
+	 */
+	float GetStaminaValue() const;
+	void SetStaminaValue(float NewValue);
+
+	/**
+	 * 是否正在恢复：托管时由槽位的恢复标记决定
+	 */
+	bool IsRecoveringStamina() const;
+	void SetRecoveringStamina(bool bRecovering);
+
 	/**
 	 * ��ȡָ�������ľ�������
 	 * @param Action ��������
@@ -10,6 +10,7 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Pawn.h"
 #include "EngineUtils.h"
+#include "PerformanceProfiler.h"
 
 UTargetDetectionComponent::UTargetDetectionComponent()
 {
@@ -38,6 +39,8 @@ void UTargetDetectionComponent::TickComponent(float DeltaTime, ELevelTick TickTy
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	SOUL_PERFORMANCE_SCOPE(TEXT("TargetDetection.Tick"));
+
 	if (!LockOnDetectionSphere || !GetOwnerCharacter())
 	{
 		return;
@@ -107,8 +110,10 @@ EEnemySizeCategory UTargetDetectionComponent::GetTargetSizeCategory(AActor* Targ
 	EEnemySizeCategory* CachedSize = EnemySizeCache.Find(Target);
 	if (CachedSize)
 	{
+		SOUL_COUNTER_INC(TEXT("TargetDetection.SizeCacheHits"));
 		return *CachedSize;
 	}
+	SOUL_COUNTER_INC(TEXT("TargetDetection.SizeCacheMisses"));
 
 	// ������������
 	EEnemySizeCategory SizeCategory = AnalyzeTargetSize(Target);
@@ -137,6 +142,7 @@ void UTargetDetectionComponent::FindLockOnCandidates()
 	// ��ȡ���巶Χ�ڵ������ص�Actor
 	TArray<AActor*> OverlappingActors;
 	LockOnDetectionSphere->GetOverlappingActors(OverlappingActors, APawn::StaticClass());
+	SOUL_COUNTER_INC(TEXT("TargetDetection.OverlapQueries"));
 
 	// ��ʱ�洢��ЧĿ��
 	TArray<AActor*> ValidTargets;
@@ -177,6 +183,8 @@ void UTargetDetectionComponent::FindLockOnCandidates()
 
 bool UTargetDetectionComponent::IsValidLockOnTarget(AActor* Target)
 {
+	SOUL_COUNTER_INC(TEXT("TargetDetection.CandidatesValidated"));
+
 	if (!ValidateBasicTargetConditions(Target))
 	{
 		return false;
@@ -745,6 +753,7 @@ bool UTargetDetectionComponent::PerformLineOfSightCheck(AActor* Target) const
 	QueryParams.AddIgnoredActor(OwnerCharacter);
 	QueryParams.bTraceComplex = false;
 	
+	SOUL_COUNTER_INC(TEXT("TargetDetection.Traces"));
 	bool bHit = GetWorld()->LineTraceSingleByChannel(
 		HitResult,
 		StartLocation,
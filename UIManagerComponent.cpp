@@ -8,6 +8,15 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "SceneView.h"
+#include "TimerManager.h"
+#include "PerformanceProfiler.h"
+#include "LockOnWidgetBase.h"
+#include "TargetDetectionComponent.h"
+#include "LockOnConfigComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
 
 // Sets default values for this component's properties
 UUIManagerComponent::UUIManagerComponent()
@@ -36,14 +45,31 @@ void UUIManagerComponent::BeginPlay()
 	
 	InitializeUIManager();
 	
+	// 延迟一帧预热，角色在自身BeginPlay中才设置LockOnWidgetClass
+	if (bEnableWidgetPool && WidgetPoolPrewarmCount > 0)
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UUIManagerComponent::PrewarmWidgetPool));
+	}
+	
 	UE_LOG(LogTemp, Warning, TEXT("UIManagerComponent: BeginPlay called"));
 }
 
+void UUIManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CleanupUIResources();
+	DrainWidgetPool();
+	HideCandidateIndicators(true);
+	
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void UUIManagerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	
+	SOUL_PERFORMANCE_SCOPE(TEXT("UIManager.Tick"));
+	
 	// ==================== 关键修复：添加有效性检查，防止无效目标重新显示UI ====================
 	// Update projection widget if active
 	if (CurrentLockOnTarget && IsValid(CurrentLockOnTarget) && LockOnWidgetInstance)
@@ -58,11 +84,12 @@ void UUIManagerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 			UE_LOG(LogTemp, Warning, TEXT("UIManagerComponent::Tick - No valid target, removing orphaned widget"));
 		}
 		
-		LockOnWidgetInstance->SetVisibility(ESlateVisibility::Hidden);
-		LockOnWidgetInstance->RemoveFromViewport();
-		LockOnWidgetInstance = nullptr;
+		ReleaseLockOnWidget();
 		CurrentLockOnTarget = nullptr;
 	}
+	
+	// 候选目标标记层（一次批量投影驱动全部标记）
+	UpdateCandidateIndicators();
 }
 
 // ==================== Core Public Interface ====================
@@ -93,6 +120,7 @@ void UUIManagerComponent::ShowLockOnWidget(AActor* Target)
 			
 		case EUIDisplayMode::Traditional3D:
 		default:
+			SOUL_COUNTER_INC(TEXT("UIManager.ComponentLookups"));
 			UActorComponent* WidgetComp = Target->GetComponentByClass(UWidgetComponent::StaticClass());
 			if (WidgetComp)
 			{
@@ -118,24 +146,15 @@ void UUIManagerComponent::HideLockOnWidget()
 	// 隐藏所有传统3D Widget
 	HideAllLockOnWidgets();
 	
-	// 确保ScreenSpace Widget被完全移除
+	// 确保ScreenSpace Widget被隐藏并回收到池中
 	if (LockOnWidgetInstance)
 	{
-		if (LockOnWidgetInstance->IsInViewport())
+		ReleaseLockOnWidget();
+		
+		if (bEnableUIDebugLogs)
 		{
-			// 先设置为隐藏（立即生效）
-			LockOnWidgetInstance->SetVisibility(ESlateVisibility::Hidden);
-			// 然后从视口移除（彻底清理）
-			LockOnWidgetInstance->RemoveFromViewport();
-			
-			if (bEnableUIDebugLogs)
-			{
-				UE_LOG(LogTemp, Log, TEXT("UIManagerComponent::HideLockOnWidget - Widget removed from viewport"));
-			}
+			UE_LOG(LogTemp, Log, TEXT("UIManagerComponent::HideLockOnWidget - Widget released"));
 		}
-		
-		// 清空引用，确保下次重新创建
-		LockOnWidgetInstance = nullptr;
 	}
 	
 	// 广播隐藏事件
@@ -157,6 +176,7 @@ void UUIManagerComponent::HideAllLockOnWidgets()
 	{
 		if (IsValid(Target))
 		{
+			SOUL_COUNTER_INC(TEXT("UIManager.ComponentLookups"));
 			UActorComponent* WidgetComp = Target->GetComponentByClass(UWidgetComponent::StaticClass());
 			if (WidgetComp)
 			{
@@ -171,23 +191,15 @@ void UUIManagerComponent::HideAllLockOnWidgets()
 	
 	TargetsWithActiveWidgets.Empty();
 	
-	// 确保ScreenSpace Widget也被移除
+	// 确保ScreenSpace Widget也被隐藏并回收
 	if (LockOnWidgetInstance)
 	{
-		if (LockOnWidgetInstance->IsInViewport())
+		ReleaseLockOnWidget();
+		
+		if (bEnableUIDebugLogs)
 		{
-			// 先隐藏再移除
-			LockOnWidgetInstance->SetVisibility(ESlateVisibility::Hidden);
-			LockOnWidgetInstance->RemoveFromViewport();
-			
-			if (bEnableUIDebugLogs)
-			{
-				UE_LOG(LogTemp, Log, TEXT("UIManagerComponent::HideAllLockOnWidgets - ScreenSpace widget removed and CurrentLockOnTarget cleared"));
-			}
+			UE_LOG(LogTemp, Log, TEXT("UIManagerComponent::HideAllLockOnWidgets - ScreenSpace widget released and CurrentLockOnTarget cleared"));
 		}
-		
-		// 清空引用
-		LockOnWidgetInstance = nullptr;
 	}
 }
 
@@ -204,6 +216,7 @@ void UUIManagerComponent::UpdateLockOnWidget(AActor* CurrentTarget, AActor* Prev
 	
 	if (IsValid(PreviousTarget) && PreviousTarget != CurrentTarget)
 	{
+		SOUL_COUNTER_INC(TEXT("UIManager.ComponentLookups"));
 		UActorComponent* PrevWidgetComp = PreviousTarget->GetComponentByClass(UWidgetComponent::StaticClass());
 		if (PrevWidgetComp)
 		{
@@ -253,6 +266,14 @@ FVector UUIManagerComponent::GetTargetProjectionLocation(AActor* Target) const
 		case EProjectionMode::Hybrid:
 		default:
 		{
+			// 选定了部位（或目标自带多部位表）时与相机共用同一份已解析的部位变换
+			FTransform PartTransform;
+			if (GetActiveTargetPartTransform(Target, PartTransform))
+			{
+				return PartTransform.GetLocation();
+			}
+			
+			SOUL_COUNTER_INC(TEXT("UIManager.ComponentLookups"));
 			USkeletalMeshComponent* SkeletalMesh = Target->FindComponentByClass<USkeletalMeshComponent>();
 			if (SkeletalMesh)
 			{
@@ -278,6 +299,7 @@ bool UUIManagerComponent::HasValidSocket(AActor* Target) const
 		return false;
 	}
 	
+	SOUL_COUNTER_INC(TEXT("UIManager.ComponentLookups"));
 	USkeletalMeshComponent* SkeletalMesh = Target->FindComponentByClass<USkeletalMeshComponent>();
 	if (SkeletalMesh)
 	{
@@ -290,6 +312,15 @@ bool UUIManagerComponent::HasValidSocket(AActor* Target) const
 
 FVector2D UUIManagerComponent::ProjectSocketToScreen(const FVector& SocketWorldLocation) const
 {
+	// 优先使用本帧缓存的视图投影矩阵，避免每次投影都重建视图数据
+	if (UpdateProjectionCache())
+	{
+		FVector2D CachedScreenLocation;
+		bool bOnScreen = false;
+		ProjectBatchWithCache(&SocketWorldLocation, 1, &CachedScreenLocation, &bOnScreen);
+		return CachedScreenLocation;
+	}
+	
 	APlayerController* PC = GetPlayerController();
 	if (!PC)
 	{
@@ -307,6 +338,140 @@ FVector2D UUIManagerComponent::ProjectToScreen(const FVector& WorldLocation) con
 	return ProjectSocketToScreen(WorldLocation);
 }
 
+int32 UUIManagerComponent::ProjectWorldLocationsToScreen(const TArray<FVector>& WorldLocations, TArray<FVector2D>& OutScreenPositions, TArray<bool>& OutOnScreen) const
+{
+	const int32 Num = WorldLocations.Num();
+	OutScreenPositions.SetNumUninitialized(Num);
+	OutOnScreen.SetNumUninitialized(Num);
+	
+	if (Num == 0)
+	{
+		return 0;
+	}
+	
+	if (!UpdateProjectionCache())
+	{
+		// 没有本地玩家视口（如专用服务器）时全部视为屏幕外
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			OutScreenPositions[Index] = FVector2D::ZeroVector;
+			OutOnScreen[Index] = false;
+		}
+		return 0;
+	}
+	
+	SOUL_COUNTER_ADD(TEXT("UIManager.ProjectedPoints"), Num);
+	return ProjectBatchWithCache(WorldLocations.GetData(), Num, OutScreenPositions.GetData(), OutOnScreen.GetData());
+}
+
+int32 UUIManagerComponent::ProjectTargetsToScreen(const TArray<AActor*>& Targets, TArray<FVector2D>& OutScreenPositions, TArray<bool>& OutOnScreen) const
+{
+	ProjectionScratchLocations.Reset(Targets.Num());
+	for (AActor* Target : Targets)
+	{
+		ProjectionScratchLocations.Add(IsValid(Target) ? GetTargetProjectionLocation(Target) : FVector::ZeroVector);
+	}
+	
+	int32 NumOnScreen = ProjectWorldLocationsToScreen(ProjectionScratchLocations, OutScreenPositions, OutOnScreen);
+	
+	for (int32 Index = 0; Index < Targets.Num(); ++Index)
+	{
+		if (!IsValid(Targets[Index]) && OutOnScreen[Index])
+		{
+			OutScreenPositions[Index] = FVector2D::ZeroVector;
+			OutOnScreen[Index] = false;
+			--NumOnScreen;
+		}
+	}
+	
+	return NumOnScreen;
+}
+
+bool UUIManagerComponent::UpdateProjectionCache() const
+{
+	APlayerController* PC = GetPlayerController();
+	if (ProjectionCache.FrameNumber == GFrameCounter && ProjectionCache.Controller.Get() == PC)
+	{
+		return ProjectionCache.bValid;
+	}
+	
+	ProjectionCache.FrameNumber = GFrameCounter;
+	ProjectionCache.Controller = PC;
+	ProjectionCache.bValid = false;
+	
+	ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+	if (!LocalPlayer || !LocalPlayer->ViewportClient)
+	{
+		return false;
+	}
+	
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		return false;
+	}
+	
+	// 与 FSceneView::ProjectWorldToScreen 相同的矩阵，只是把平移拆出来在双精度下先减掉
+	ProjectionCache.ViewOrigin = ProjectionData.ViewOrigin;
+	ProjectionCache.TranslatedViewProjection = FMatrix44f(ProjectionData.ViewRotationMatrix * ProjectionData.ProjectionMatrix);
+	ProjectionCache.ViewRect = ProjectionData.GetConstrainedViewRect();
+	ProjectionCache.bValid = ProjectionCache.ViewRect.Area() > 0;
+	
+	SOUL_COUNTER_INC(TEXT("UIManager.ViewProjectionBuilds"));
+	return ProjectionCache.bValid;
+}
+
+int32 UUIManagerComponent::ProjectBatchWithCache(const FVector* WorldLocations, int32 Num, FVector2D* OutScreenPositions, bool* OutOnScreen) const
+{
+	const FMatrix44f& Matrix = ProjectionCache.TranslatedViewProjection;
+	const VectorRegister4Float Row0 = VectorLoad(Matrix.M[0]);
+	const VectorRegister4Float Row1 = VectorLoad(Matrix.M[1]);
+	const VectorRegister4Float Row2 = VectorLoad(Matrix.M[2]);
+	const VectorRegister4Float Row3 = VectorLoad(Matrix.M[3]);
+	
+	const FIntRect& ViewRect = ProjectionCache.ViewRect;
+	const float ViewMinX = static_cast<float>(ViewRect.Min.X);
+	const float ViewMinY = static_cast<float>(ViewRect.Min.Y);
+	const float ViewWidth = static_cast<float>(ViewRect.Width());
+	const float ViewHeight = static_cast<float>(ViewRect.Height());
+	
+	int32 NumOnScreen = 0;
+	alignas(16) float Clip[4];
+	
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const FVector Relative = WorldLocations[Index] - ProjectionCache.ViewOrigin;
+		
+		// Clip = X * Row0 + Y * Row1 + Z * Row2 + Row3
+		VectorRegister4Float Result = VectorMultiplyAdd(VectorSetFloat1(static_cast<float>(Relative.X)), Row0, Row3);
+		Result = VectorMultiplyAdd(VectorSetFloat1(static_cast<float>(Relative.Y)), Row1, Result);
+		Result = VectorMultiplyAdd(VectorSetFloat1(static_cast<float>(Relative.Z)), Row2, Result);
+		VectorStoreAligned(Result, Clip);
+		
+		if (Clip[3] <= 0.0f)
+		{
+			// 在相机后方，与 ProjectWorldLocationToScreen 失败时的返回值保持一致
+			OutScreenPositions[Index] = FVector2D::ZeroVector;
+			OutOnScreen[Index] = false;
+			continue;
+		}
+		
+		const float InvW = 1.0f / Clip[3];
+		const float NdcX = Clip[0] * InvW;
+		const float NdcY = Clip[1] * InvW;
+		
+		OutScreenPositions[Index] = FVector2D(
+			ViewMinX + (NdcX * 0.5f + 0.5f) * ViewWidth,
+			ViewMinY + (0.5f - NdcY * 0.5f) * ViewHeight);
+		
+		const bool bOnScreen = NdcX >= -1.0f && NdcX <= 1.0f && NdcY >= -1.0f && NdcY <= 1.0f;
+		OutOnScreen[Index] = bOnScreen;
+		NumOnScreen += bOnScreen ? 1 : 0;
+	}
+	
+	return NumOnScreen;
+}
+
 void UUIManagerComponent::ShowSocketProjectionWidget(AActor* Target)
 {
 	if (!Target || !LockOnWidgetClass)
@@ -320,15 +485,12 @@ void UUIManagerComponent::ShowSocketProjectionWidget(AActor* Target)
 		return;
 	}
 	
-	if (LockOnWidgetInstance && LockOnWidgetInstance->IsInViewport())
-	{
-		LockOnWidgetInstance->RemoveFromViewport();
-	}
+	ReleaseLockOnWidget();
 	
-	LockOnWidgetInstance = CreateWidget<UUserWidget>(PC, LockOnWidgetClass);
+	LockOnWidgetInstance = AcquireLockOnWidget(PC);
 	if (LockOnWidgetInstance)
 	{
-		LockOnWidgetInstance->AddToViewport();
+		BindLockOnWidget(LockOnWidgetInstance);
 		CurrentLockOnTarget = Target;
 		UpdateProjectionWidget(Target);
 	}
@@ -346,21 +508,16 @@ void UUIManagerComponent::UpdateProjectionWidget(AActor* Target)
 	
 	if (ScreenPosition != FVector2D::ZeroVector)
 	{
-		UFunction* UpdateFunction = LockOnWidgetInstance->GetClass()->FindFunctionByName(FName(TEXT("UpdateLockOnPostition")));
-		
-		if (UpdateFunction)
+		// 亚像素抖动不值得一次Widget更新和事件广播
+		if (bHasLastWidgetScreenPosition &&
+			FVector2D::DistSquared(ScreenPosition, LastWidgetScreenPosition) < FMath::Square(WidgetPositionUpdateThreshold) &&
+			LockOnWidgetInstance->IsVisible())
 		{
-			struct FUpdateParams
-			{
-				FVector2D ScreenPos;
-			};
-			
-			FUpdateParams Params;
-			Params.ScreenPos = ScreenPosition;
-			
-			LockOnWidgetInstance->ProcessEvent(UpdateFunction, &Params);
+			return;
 		}
 		
+		ApplyWidgetScreenPosition(ScreenPosition);
+		
 		if (!LockOnWidgetInstance->IsVisible())
 		{
 			LockOnWidgetInstance->SetVisibility(ESlateVisibility::Visible);
@@ -370,6 +527,8 @@ void UUIManagerComponent::UpdateProjectionWidget(AActor* Target)
 	}
 	else
 	{
+		bHasLastWidgetScreenPosition = false;
+		
 		if (LockOnWidgetInstance->IsVisible())
 		{
 			LockOnWidgetInstance->SetVisibility(ESlateVisibility::Hidden);
@@ -384,11 +543,7 @@ void UUIManagerComponent::UpdateSocketProjectionWidget(AActor* Target)
 
 void UUIManagerComponent::HideSocketProjectionWidget()
 {
-	if (LockOnWidgetInstance && LockOnWidgetInstance->IsInViewport())
-	{
-		LockOnWidgetInstance->RemoveFromViewport();
-		LockOnWidgetInstance = nullptr;
-	}
+	ReleaseLockOnWidget();
 }
 
 // ==================== Size Adaptive UI Interface ====================
@@ -408,19 +563,7 @@ void UUIManagerComponent::ShowSizeAdaptiveWidget(AActor* Target, EEnemySizeCateg
 	
 	if (LockOnWidgetInstance)
 	{
-		UFunction* SetScaleFunc = LockOnWidgetInstance->GetClass()->FindFunctionByName(FName(TEXT("SetUIScale")));
-		if (SetScaleFunc)
-		{
-			float Scale = CurrentUIScale;
-			LockOnWidgetInstance->ProcessEvent(SetScaleFunc, &Scale);
-		}
-		
-		UFunction* SetColorFunc = LockOnWidgetInstance->GetClass()->FindFunctionByName(FName(TEXT("SetUIColor")));
-		if (SetColorFunc)
-		{
-			FLinearColor Color = CurrentUIColor;
-			LockOnWidgetInstance->ProcessEvent(SetColorFunc, &Color);
-		}
+		ApplyWidgetAppearance(CurrentUIScale, CurrentUIColor);
 	}
 }
 
@@ -476,6 +619,11 @@ void UUIManagerComponent::DebugWidgetSetup()
 	UE_LOG(LogTemp, Warning, TEXT("Display Mode: %d"), static_cast<int32>(CurrentUIDisplayMode));
 	UE_LOG(LogTemp, Warning, TEXT("Current Target: %s"), CurrentLockOnTarget ? *CurrentLockOnTarget->GetName() : TEXT("None"));
 	UE_LOG(LogTemp, Warning, TEXT("Widget Instance: %s"), LockOnWidgetInstance ? TEXT("EXISTS") : TEXT("NULL"));
+	
+	const FLockOnWidgetPoolStats PoolStats = GetWidgetPoolStats();
+	UE_LOG(LogTemp, Warning, TEXT("Widget Pool: %s, Hits: %d, Misses: %d (%.0f%%), Created: %d, Available: %d"),
+		bEnableWidgetPool ? TEXT("ON") : TEXT("OFF"),
+		PoolStats.Hits, PoolStats.Misses, PoolStats.HitRate * 100.0f, PoolStats.Created, PoolStats.Available);
 	UE_LOG(LogTemp, Warning, TEXT("======================"));
 }
 
@@ -496,6 +644,361 @@ bool UUIManagerComponent::ValidateWidgetClass() const
 	return LockOnWidgetClass != nullptr;
 }
 
+// ==================== Widget Pool Interface ====================
+
+void UUIManagerComponent::PrewarmWidgetPool()
+{
+	if (!bEnableWidgetPool || !LockOnWidgetClass)
+	{
+		return;
+	}
+	
+	APlayerController* PC = GetPlayerController();
+	if (!PC || !PC->IsLocalController())
+	{
+		return;
+	}
+	
+	const int32 TargetCount = FMath::Min(WidgetPoolPrewarmCount, MaxPooledWidgets);
+	while (PooledLockOnWidgets.Num() < TargetCount)
+	{
+		UUserWidget* Widget = CreateWidget<UUserWidget>(PC, LockOnWidgetClass);
+		if (!Widget)
+		{
+			break;
+		}
+		
+		++WidgetPoolCreated;
+		BindLockOnWidget(Widget);
+		Widget->AddToViewport();
+		Widget->SetVisibility(ESlateVisibility::Collapsed);
+		PooledLockOnWidgets.Add(Widget);
+	}
+	
+	if (bEnableUIDebugLogs)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UIManagerComponent::PrewarmWidgetPool - %d idle widgets ready"), PooledLockOnWidgets.Num());
+	}
+}
+
+FLockOnWidgetPoolStats UUIManagerComponent::GetWidgetPoolStats() const
+{
+	FLockOnWidgetPoolStats Stats;
+	Stats.Hits = WidgetPoolHits;
+	Stats.Misses = WidgetPoolMisses;
+	Stats.Created = WidgetPoolCreated;
+	Stats.Available = PooledLockOnWidgets.Num();
+	
+	const int32 Requests = WidgetPoolHits + WidgetPoolMisses;
+	Stats.HitRate = Requests > 0 ? static_cast<float>(WidgetPoolHits) / static_cast<float>(Requests) : 0.0f;
+	return Stats;
+}
+
+void UUIManagerComponent::ResetWidgetPoolStats()
+{
+	WidgetPoolHits = 0;
+	WidgetPoolMisses = 0;
+	WidgetPoolCreated = 0;
+}
+
+// ==================== Candidate Indicator Interface ====================
+
+void UUIManagerComponent::SetCandidateIndicatorsEnabled(bool bEnabled)
+{
+	bShowCandidateIndicators = bEnabled;
+	
+	if (!bEnabled)
+	{
+		HideCandidateIndicators();
+	}
+}
+
+int32 UUIManagerComponent::GetLiveCandidateIndicatorCount() const
+{
+	int32 Count = 0;
+	for (const FCandidateIndicatorSlot& Slot : CandidateIndicators)
+	{
+		Count += Slot.bActive ? 1 : 0;
+	}
+	return Count;
+}
+
+void UUIManagerComponent::UpdateCandidateIndicators()
+{
+	if (!bShowCandidateIndicators)
+	{
+		if (GetLiveCandidateIndicatorCount() > 0)
+		{
+			HideCandidateIndicators();
+		}
+		return;
+	}
+	
+	AActor* Owner = GetOwner();
+	if (!Owner)
+	{
+		return;
+	}
+	
+	if (!TargetDetectionComponent)
+	{
+		SOUL_COUNTER_INC(TEXT("UIManager.ComponentLookups"));
+		TargetDetectionComponent = Owner->FindComponentByClass<UTargetDetectionComponent>();
+		if (!TargetDetectionComponent)
+		{
+			return;
+		}
+	}
+	
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	const uint64 FrameNumber = GFrameCounter;
+	const FVector ViewerLocation = Owner->GetActorLocation();
+	const float NearDistanceSquared = FMath::Square(CandidateNearDistance);
+	
+	// ==================== 1. 收集候选，远处/屏幕外的投影点降频刷新 ====================
+	CandidateScratchTargets.Reset();
+	CandidateScratchLocations.Reset();
+	CandidateScratchDistances.Reset();
+	
+	for (AActor* Candidate : TargetDetectionComponent->GetLockOnCandidates())
+	{
+		// 锁定目标由主Widget显示
+		if (!IsValid(Candidate) || Candidate == CurrentLockOnTarget)
+		{
+			continue;
+		}
+		
+		const bool bNewlyRegistered = !CandidateProjectionStates.Contains(Candidate);
+		FCandidateProjectionState& State = CandidateProjectionStates.FindOrAdd(Candidate);
+		State.LastSeenFrame = FrameNumber;
+		
+		if (CurrentTime >= State.NextRefreshTime)
+		{
+			State.WorldLocation = GetTargetProjectionLocation(Candidate);
+			State.DistanceSquared = static_cast<float>(FVector::DistSquared(ViewerLocation, State.WorldLocation));
+			
+			// 新登记的候选还没有可见性，先单独投影一次；投影缓存不可用时按屏幕内处理，避免首轮就被降频
+			if (bNewlyRegistered)
+			{
+				State.bOnScreen = true;
+				if (UpdateProjectionCache())
+				{
+					FVector2D ScreenLocation;
+					ProjectBatchWithCache(&State.WorldLocation, 1, &ScreenLocation, &State.bOnScreen);
+				}
+			}
+			
+			const bool bReducedRate = !State.bOnScreen || State.DistanceSquared > NearDistanceSquared;
+			State.NextRefreshTime = bReducedRate ? CurrentTime + CandidateFarUpdateInterval : CurrentTime;
+		}
+		
+		CandidateScratchTargets.Add(Candidate);
+		CandidateScratchLocations.Add(State.WorldLocation);
+		CandidateScratchDistances.Add(State.DistanceSquared);
+	}
+	
+	for (auto It = CandidateProjectionStates.CreateIterator(); It; ++It)
+	{
+		if (It->Value.LastSeenFrame != FrameNumber || !It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	
+	// ==================== 2. 一次批量投影 ====================
+	const int32 NumCandidates = CandidateScratchTargets.Num();
+	ProjectWorldLocationsToScreen(CandidateScratchLocations, CandidateScratchScreen, CandidateScratchOnScreen);
+	
+	CandidateScratchOrder.Reset();
+	for (int32 Index = 0; Index < NumCandidates; ++Index)
+	{
+		if (FCandidateProjectionState* State = CandidateProjectionStates.Find(CandidateScratchTargets[Index]))
+		{
+			State->bOnScreen = CandidateScratchOnScreen[Index];
+		}
+		
+		if (CandidateScratchOnScreen[Index])
+		{
+			CandidateScratchOrder.Add(Index);
+		}
+	}
+	
+	// ==================== 3. 由近到远选取，屏幕上重叠的标记合并到更近的候选 ====================
+	CandidateScratchOrder.Sort([this](int32 A, int32 B)
+	{
+		return CandidateScratchDistances[A] < CandidateScratchDistances[B];
+	});
+	
+	const float MergeRadiusSquared = FMath::Square(CandidateMergeRadius);
+	const bool bHasLockedMarker = LockOnWidgetInstance && bHasLastWidgetScreenPosition;
+	int32 NumMerged = 0;
+	
+	CandidateScratchAccepted.Reset();
+	for (int32 Index : CandidateScratchOrder)
+	{
+		if (CandidateScratchAccepted.Num() >= MaxLiveCandidateIndicators)
+		{
+			break;
+		}
+		
+		const FVector2D& ScreenPosition = CandidateScratchScreen[Index];
+		bool bMerged = bHasLockedMarker && FVector2D::DistSquared(ScreenPosition, LastWidgetScreenPosition) < MergeRadiusSquared;
+		
+		for (int32 AcceptedIndex = 0; !bMerged && AcceptedIndex < CandidateScratchAccepted.Num(); ++AcceptedIndex)
+		{
+			bMerged = FVector2D::DistSquared(ScreenPosition, CandidateScratchScreen[CandidateScratchAccepted[AcceptedIndex]]) < MergeRadiusSquared;
+		}
+		
+		if (bMerged)
+		{
+			++NumMerged;
+		}
+		else
+		{
+			CandidateScratchAccepted.Add(Index);
+		}
+	}
+	
+	// ==================== 4. 回收不再显示的标记 ====================
+	// 控件已失效（被GC或从视口移除）的槽位直接删除，否则会一直占用 MaxLiveCandidateIndicators 的名额
+	CandidateIndicators.RemoveAll([](const FCandidateIndicatorSlot& Slot)
+	{
+		return !IsValid(Slot.Widget);
+	});
+	
+	for (FCandidateIndicatorSlot& Slot : CandidateIndicators)
+	{
+		if (!Slot.bActive)
+		{
+			continue;
+		}
+		
+		bool bStillShown = false;
+		for (int32 AcceptedIndex : CandidateScratchAccepted)
+		{
+			if (Slot.Target.Get() == CandidateScratchTargets[AcceptedIndex])
+			{
+				bStillShown = true;
+				break;
+			}
+		}
+		
+		if (!bStillShown)
+		{
+			if (IsValid(Slot.Widget))
+			{
+				Slot.Widget->SetVisibility(ESlateVisibility::Collapsed);
+			}
+			Slot.bActive = false;
+			Slot.Target.Reset();
+		}
+	}
+	
+	// ==================== 5. 分配槽位并按LOD更新位置 ====================
+	TSubclassOf<UUserWidget> MarkerClass = CandidateIndicatorClass ? CandidateIndicatorClass : LockOnWidgetClass;
+	APlayerController* PC = GetPlayerController();
+	const float ThresholdSquared = FMath::Square(WidgetPositionUpdateThreshold);
+	
+	for (int32 AcceptedIndex : CandidateScratchAccepted)
+	{
+		AActor* Candidate = CandidateScratchTargets[AcceptedIndex];
+		const FVector2D& ScreenPosition = CandidateScratchScreen[AcceptedIndex];
+		
+		FCandidateIndicatorSlot* Slot = CandidateIndicators.FindByPredicate([Candidate](const FCandidateIndicatorSlot& Existing)
+		{
+			return Existing.bActive && Existing.Target.Get() == Candidate;
+		});
+		
+		bool bNewlyAssigned = false;
+		if (!Slot)
+		{
+			Slot = CandidateIndicators.FindByPredicate([](const FCandidateIndicatorSlot& Existing)
+			{
+				return !Existing.bActive && IsValid(Existing.Widget);
+			});
+			
+			if (!Slot)
+			{
+				if (!MarkerClass || !PC || !PC->IsLocalController() || CandidateIndicators.Num() >= MaxLiveCandidateIndicators)
+				{
+					break;
+				}
+				
+				UUserWidget* Widget = CreateWidget<UUserWidget>(PC, MarkerClass);
+				if (!Widget)
+				{
+					break;
+				}
+				
+				if (!Widget->IsA<ULockOnWidgetBase>())
+				{
+					Widget->SetAlignmentInViewport(FVector2D(0.5f, 0.5f));
+				}
+				Widget->AddToViewport();
+				
+				Slot = &CandidateIndicators.AddDefaulted_GetRef();
+				Slot->Widget = Widget;
+			}
+			
+			Slot->Target = Candidate;
+			Slot->bActive = true;
+			Slot->Widget->SetVisibility(ESlateVisibility::HitTestInvisible);
+			bNewlyAssigned = true;
+		}
+		
+		if (!bNewlyAssigned &&
+			(CurrentTime < Slot->NextWidgetUpdateTime ||
+			 FVector2D::DistSquared(ScreenPosition, Slot->LastScreenPosition) < ThresholdSquared))
+		{
+			continue;
+		}
+		
+		if (ULockOnWidgetBase* NativeWidget = Cast<ULockOnWidgetBase>(Slot->Widget))
+		{
+			NativeWidget->SetLockOnScreenPosition(ScreenPosition);
+		}
+		else
+		{
+			Slot->Widget->SetPositionInViewport(ScreenPosition, true);
+		}
+		SOUL_COUNTER_INC(TEXT("UIManager.WidgetUpdates"));
+		
+		const bool bFar = CandidateScratchDistances[AcceptedIndex] > NearDistanceSquared;
+		Slot->LastScreenPosition = ScreenPosition;
+		Slot->NextWidgetUpdateTime = bFar ? CurrentTime + CandidateFarUpdateInterval : CurrentTime;
+	}
+	
+	SOUL_COUNTER_ADD(TEXT("UIManager.CandidateMarkers"), CandidateScratchAccepted.Num());
+	SOUL_COUNTER_ADD(TEXT("UIManager.CandidatesMerged"), NumMerged);
+}
+
+void UUIManagerComponent::HideCandidateIndicators(bool bRemoveFromViewport)
+{
+	for (FCandidateIndicatorSlot& Slot : CandidateIndicators)
+	{
+		if (IsValid(Slot.Widget))
+		{
+			if (bRemoveFromViewport)
+			{
+				Slot.Widget->RemoveFromViewport();
+			}
+			else if (Slot.bActive)
+			{
+				Slot.Widget->SetVisibility(ESlateVisibility::Collapsed);
+			}
+		}
+		
+		Slot.bActive = false;
+		Slot.Target.Reset();
+	}
+	
+	if (bRemoveFromViewport)
+	{
+		CandidateIndicators.Empty();
+		CandidateProjectionStates.Empty();
+	}
+}
+
 // ==================== Configuration Accessors ====================
 
 void UUIManagerComponent::SetUIDisplayMode(EUIDisplayMode NewMode)
@@ -543,6 +1046,218 @@ ETargetBodyPart UUIManagerComponent::GetBestTargetPart(AActor* Target) const
 	}
 }
 
+int32 UUIManagerComponent::StepTargetPart(AActor* Target, int32 Direction)
+{
+	FResolvedTargetParts* Entry = FindOrResolveTargetParts(Target);
+	if (!Entry || Entry->Points.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+	
+	const int32 NumPoints = Entry->Points.Num();
+	
+	// Auto 状态下从智能选择的部位开始步进
+	if (!Entry->bCustomPoints && MultiPartConfig.TargetPart == ETargetBodyPart::Auto)
+	{
+		const ETargetBodyPart BestPart = GetBestTargetPart(Target);
+		const int32 BestIndex = Entry->Points.IndexOfByPredicate([BestPart](const FResolvedPartPoint& Point) { return Point.Part == BestPart; });
+		Entry->CurrentIndex = BestIndex != INDEX_NONE ? BestIndex : 0;
+	}
+	
+	Entry->CurrentIndex = ((Entry->CurrentIndex + Direction) % NumPoints + NumPoints) % NumPoints;
+	
+	if (!Entry->bCustomPoints)
+	{
+		SwitchTargetPart(Entry->Points[Entry->CurrentIndex].Part);
+	}
+	
+	return Entry->CurrentIndex;
+}
+
+int32 UUIManagerComponent::GetTargetPartCount(AActor* Target) const
+{
+	const FResolvedTargetParts* Entry = FindOrResolveTargetParts(Target);
+	return Entry ? Entry->Points.Num() : 0;
+}
+
+bool UUIManagerComponent::GetActiveTargetPartTransform(AActor* Target, FTransform& OutTransform) const
+{
+	const bool bExplicitPart = MultiPartConfig.TargetPart != ETargetBodyPart::Auto;
+	
+	// Auto 时只有自带多部位表的目标走部位变换，其余沿用原有逻辑
+	FResolvedTargetParts* Entry = FindOrResolveTargetParts(Target);
+	if (!Entry || Entry->Points.Num() == 0 || (!bExplicitPart && !Entry->bCustomPoints))
+	{
+		return false;
+	}
+	
+	// 全局部位选择变化后，标准部位表在这里同步索引（每个目标只在切换后查一次）
+	if (!Entry->bCustomPoints && Entry->Points[Entry->CurrentIndex].Part != MultiPartConfig.TargetPart)
+	{
+		const ETargetBodyPart WantedPart = MultiPartConfig.TargetPart;
+		const int32 WantedIndex = Entry->Points.IndexOfByPredicate([WantedPart](const FResolvedPartPoint& Point) { return Point.Part == WantedPart; });
+		if (WantedIndex == INDEX_NONE)
+		{
+			return false;
+		}
+		Entry->CurrentIndex = WantedIndex;
+	}
+	
+	// 相机和UI在同一帧读取时只计算一次
+	if (Entry->EvaluatedFrame == GFrameCounter && Entry->EvaluatedIndex == Entry->CurrentIndex)
+	{
+		OutTransform = Entry->EvaluatedTransform;
+		return true;
+	}
+	
+	USkeletalMeshComponent* Mesh = Entry->Mesh.Get();
+	const FResolvedPartPoint& Point = Entry->Points[Entry->CurrentIndex];
+	if (!Mesh || Point.BoneIndex == INDEX_NONE || Point.BoneIndex >= Mesh->GetNumBones())
+	{
+		return false;
+	}
+	
+	FTransform PartTransform = Point.SocketLocalTransform * Mesh->GetBoneTransform(Point.BoneIndex);
+	PartTransform.AddToTranslation(Point.WorldOffset);
+	
+	Entry->EvaluatedFrame = GFrameCounter;
+	Entry->EvaluatedIndex = Entry->CurrentIndex;
+	Entry->EvaluatedTransform = PartTransform;
+	
+	OutTransform = PartTransform;
+	return true;
+}
+
+void UUIManagerComponent::InvalidateTargetParts(AActor* Target)
+{
+	ResolvedTargetParts.Remove(Target);
+}
+
+UUIManagerComponent::FResolvedTargetParts* UUIManagerComponent::FindOrResolveTargetParts(AActor* Target) const
+{
+	if (!IsValid(Target))
+	{
+		return nullptr;
+	}
+	
+	if (FResolvedTargetParts* Existing = ResolvedTargetParts.Find(Target))
+	{
+		// 没有骨骼网格的目标不必反复解析；网格被替换或骨骼数变化时重新解析
+		const USkeletalMeshComponent* ExistingMesh = Existing->Mesh.Get();
+		if (Existing->Mesh.IsExplicitlyNull() || (ExistingMesh && ExistingMesh->GetNumBones() == Existing->NumBones))
+		{
+			return Existing;
+		}
+	}
+	
+	// 顺便清理已销毁目标的条目
+	for (auto It = ResolvedTargetParts.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	
+	SOUL_COUNTER_INC(TEXT("UIManager.PartResolves"));
+	
+	FResolvedTargetParts& Entry = ResolvedTargetParts.FindOrAdd(Target);
+	Entry = FResolvedTargetParts();
+	
+	SOUL_COUNTER_INC(TEXT("UIManager.ComponentLookups"));
+	USkeletalMeshComponent* Mesh = Target->FindComponentByClass<USkeletalMeshComponent>();
+	if (!Mesh)
+	{
+		return &Entry;
+	}
+	
+	Entry.Mesh = Mesh;
+	Entry.NumBones = Mesh->GetNumBones();
+	
+	// 名称 -> 骨骼索引（Socket 额外记录相对骨骼的局部变换）
+	auto ResolvePoint = [Mesh](FName PointName, FResolvedPartPoint& OutPoint) -> bool
+	{
+		if (PointName.IsNone())
+		{
+			return false;
+		}
+		
+		if (const USkeletalMeshSocket* Socket = Mesh->GetSocketByName(PointName))
+		{
+			OutPoint.BoneIndex = Mesh->GetBoneIndex(Socket->BoneName);
+			OutPoint.SocketLocalTransform = Socket->GetSocketLocalTransform();
+		}
+		else
+		{
+			OutPoint.BoneIndex = Mesh->GetBoneIndex(PointName);
+			OutPoint.SocketLocalTransform = FTransform::Identity;
+		}
+		
+		return OutPoint.BoneIndex != INDEX_NONE;
+	};
+	
+	SOUL_COUNTER_INC(TEXT("UIManager.ComponentLookups"));
+	const ULockOnConfigComponent* Config = Target->FindComponentByClass<ULockOnConfigComponent>();
+	if (Config && Config->LockOnPartNames.Num() > 0)
+	{
+		Entry.bCustomPoints = true;
+		for (const FName& PointName : Config->LockOnPartNames)
+		{
+			FResolvedPartPoint Point;
+			if (ResolvePoint(PointName, Point))
+			{
+				Entry.Points.Add(Point);
+			}
+		}
+	}
+	else
+	{
+		// 从上到下排列，步进切换时顺序自然
+		static const ETargetBodyPart PartOrder[] = { ETargetBodyPart::Head, ETargetBodyPart::Chest, ETargetBodyPart::Center, ETargetBodyPart::Feet };
+		
+		for (ETargetBodyPart Part : PartOrder)
+		{
+			FResolvedPartPoint Point;
+			Point.Part = Part;
+			
+			const FName* PointName = MultiPartConfig.PartPointNames.Find(Part);
+			if (!PointName || !ResolvePoint(*PointName, Point))
+			{
+				// 与原有锁定点一致的回退：Spine2Socket（或 LockOnSocket）+ 部位偏移
+				if (!ResolvePoint(TEXT("Spine2Socket"), Point) && !ResolvePoint(TEXT("LockOnSocket"), Point))
+				{
+					continue;
+				}
+				
+				if (const FVector* PartOffset = MultiPartConfig.PartOffsets.Find(Part))
+				{
+					Point.WorldOffset = *PartOffset;
+				}
+			}
+			
+			Entry.Points.Add(Point);
+		}
+		
+		const ETargetBodyPart WantedPart = MultiPartConfig.TargetPart;
+		const int32 WantedIndex = Entry.Points.IndexOfByPredicate([WantedPart](const FResolvedPartPoint& Point) { return Point.Part == WantedPart; });
+		Entry.CurrentIndex = FMath::Max(WantedIndex, 0);
+	}
+	
+	// 每个目标只解析一次，这里的警告也只出现一次
+	if (Entry.Points.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UIManagerComponent: No lock-on part points resolved for %s (mesh %s); multi-part lock falls back to the default lock-on position"),
+			*Target->GetName(), *Mesh->GetName());
+	}
+	else if (bEnableUIDebugLogs)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UIManagerComponent: Resolved %d part points for %s (%s)"),
+			Entry.Points.Num(), *Target->GetName(), Entry.bCustomPoints ? TEXT("custom") : TEXT("default"));
+	}
+	
+	return &Entry;
+}
+
 // ==================== Internal Helper Functions ====================
 
 void UUIManagerComponent::InitializeUIManager()
@@ -587,6 +1302,187 @@ void UUIManagerComponent::ClearWidgetComponentCache()
 	WidgetComponentCache.Empty();
 }
 
+void UUIManagerComponent::BindLockOnWidget(UUserWidget* Widget)
+{
+	bHasLastWidgetScreenPosition = false;
+	
+	if (!Widget)
+	{
+		return;
+	}
+	
+	UClass* WidgetClass = Widget->GetClass();
+	if (Widget->IsA<ULockOnWidgetBase>() || WidgetClass == CachedWidgetFunctionClass)
+	{
+		return;
+	}
+	
+	// 旧版蓝图Widget：每个类只按名字查找一次
+	CachedWidgetFunctionClass = WidgetClass;
+	CachedUpdatePositionFunction = WidgetClass->FindFunctionByName(FName(TEXT("UpdateLockOnPostition")));
+	CachedSetScaleFunction = WidgetClass->FindFunctionByName(FName(TEXT("SetUIScale")));
+	CachedSetColorFunction = WidgetClass->FindFunctionByName(FName(TEXT("SetUIColor")));
+	
+	if (bEnableUIDebugLogs)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UIManagerComponent::BindLockOnWidget - %s is not a LockOnWidgetBase, cached functions: Update=%s Scale=%s Color=%s"),
+			*WidgetClass->GetName(),
+			CachedUpdatePositionFunction ? TEXT("Yes") : TEXT("No"),
+			CachedSetScaleFunction ? TEXT("Yes") : TEXT("No"),
+			CachedSetColorFunction ? TEXT("Yes") : TEXT("No"));
+	}
+}
+
+void UUIManagerComponent::ApplyWidgetScreenPosition(const FVector2D& ScreenPosition)
+{
+	LastWidgetScreenPosition = ScreenPosition;
+	bHasLastWidgetScreenPosition = true;
+	
+	if (ULockOnWidgetBase* NativeWidget = Cast<ULockOnWidgetBase>(LockOnWidgetInstance))
+	{
+		NativeWidget->SetLockOnScreenPosition(ScreenPosition);
+		SOUL_COUNTER_INC(TEXT("UIManager.WidgetUpdates"));
+	}
+	else if (CachedUpdatePositionFunction && LockOnWidgetInstance->GetClass() == CachedWidgetFunctionClass)
+	{
+		struct FUpdateParams
+		{
+			FVector2D ScreenPos;
+		};
+		
+		FUpdateParams Params;
+		Params.ScreenPos = ScreenPosition;
+		
+		LockOnWidgetInstance->ProcessEvent(CachedUpdatePositionFunction, &Params);
+		SOUL_COUNTER_INC(TEXT("UIManager.WidgetUpdates"));
+	}
+}
+
+void UUIManagerComponent::ApplyWidgetAppearance(float Scale, const FLinearColor& Color)
+{
+	bLockOnWidgetAppearanceApplied = !FMath::IsNearlyEqual(Scale, 1.0f) || !Color.Equals(FLinearColor::White);
+	
+	if (ULockOnWidgetBase* NativeWidget = Cast<ULockOnWidgetBase>(LockOnWidgetInstance))
+	{
+		NativeWidget->SetLockOnScale(Scale);
+		NativeWidget->SetLockOnColor(Color);
+		SOUL_COUNTER_ADD(TEXT("UIManager.WidgetUpdates"), 2);
+		return;
+	}
+	
+	if (LockOnWidgetInstance->GetClass() != CachedWidgetFunctionClass)
+	{
+		return;
+	}
+	
+	if (CachedSetScaleFunction)
+	{
+		float ScaleParam = Scale;
+		LockOnWidgetInstance->ProcessEvent(CachedSetScaleFunction, &ScaleParam);
+		SOUL_COUNTER_INC(TEXT("UIManager.WidgetUpdates"));
+	}
+	
+	if (CachedSetColorFunction)
+	{
+		FLinearColor ColorParam = Color;
+		LockOnWidgetInstance->ProcessEvent(CachedSetColorFunction, &ColorParam);
+		SOUL_COUNTER_INC(TEXT("UIManager.WidgetUpdates"));
+	}
+}
+
+UUserWidget* UUIManagerComponent::AcquireLockOnWidget(APlayerController* PC)
+{
+	if (bEnableWidgetPool)
+	{
+		// 从尾部取同类空闲Widget，顺便清掉已失效的条目
+		for (int32 Index = PooledLockOnWidgets.Num() - 1; Index >= 0; --Index)
+		{
+			UUserWidget* Pooled = PooledLockOnWidgets[Index];
+			if (!IsValid(Pooled))
+			{
+				PooledLockOnWidgets.RemoveAtSwap(Index);
+				continue;
+			}
+			
+			if (Pooled->GetClass() == LockOnWidgetClass && Pooled->GetOwningPlayer() == PC)
+			{
+				PooledLockOnWidgets.RemoveAtSwap(Index);
+				
+				if (!Pooled->IsInViewport())
+				{
+					Pooled->AddToViewport();
+				}
+				Pooled->SetVisibility(ESlateVisibility::Visible);
+				
+				++WidgetPoolHits;
+				SOUL_COUNTER_INC(TEXT("UIManager.WidgetPoolHits"));
+				return Pooled;
+			}
+		}
+		
+		++WidgetPoolMisses;
+		SOUL_COUNTER_INC(TEXT("UIManager.WidgetPoolMisses"));
+	}
+	
+	UUserWidget* Widget = CreateWidget<UUserWidget>(PC, LockOnWidgetClass);
+	if (Widget)
+	{
+		++WidgetPoolCreated;
+		Widget->AddToViewport();
+	}
+	
+	return Widget;
+}
+
+void UUIManagerComponent::ReleaseLockOnWidget()
+{
+	if (!LockOnWidgetInstance)
+	{
+		return;
+	}
+	
+	// 尺寸自适应的缩放/颜色不能带到下一个目标
+	if (bLockOnWidgetAppearanceApplied && IsValid(LockOnWidgetInstance))
+	{
+		ApplyWidgetAppearance(1.0f, FLinearColor::White);
+	}
+	bLockOnWidgetAppearanceApplied = false;
+	bHasLastWidgetScreenPosition = false;
+	
+	UUserWidget* Widget = LockOnWidgetInstance;
+	LockOnWidgetInstance = nullptr;
+	
+	if (!IsValid(Widget))
+	{
+		return;
+	}
+	
+	if (bEnableWidgetPool && PooledLockOnWidgets.Num() < MaxPooledWidgets && Widget->IsInViewport())
+	{
+		// 留在视口中折叠，复用时只切换可见性
+		Widget->SetVisibility(ESlateVisibility::Collapsed);
+		PooledLockOnWidgets.Add(Widget);
+	}
+	else
+	{
+		Widget->SetVisibility(ESlateVisibility::Hidden);
+		Widget->RemoveFromViewport();
+	}
+}
+
+void UUIManagerComponent::DrainWidgetPool()
+{
+	for (UUserWidget* Pooled : PooledLockOnWidgets)
+	{
+		if (IsValid(Pooled) && Pooled->IsInViewport())
+		{
+			Pooled->RemoveFromViewport();
+		}
+	}
+	
+	PooledLockOnWidgets.Empty();
+}
+
 void UUIManagerComponent::UpdateOwnerReferences()
 {
 	OwnerCharacter = Cast<ACharacter>(GetOwner());
@@ -625,8 +1521,10 @@ EEnemySizeCategory UUIManagerComponent::AnalyzeTargetSize(AActor* Target) const
 	
 	if (EnemySizeCache.Contains(Target))
 	{
+		SOUL_COUNTER_INC(TEXT("UIManager.SizeCacheHits"));
 		return EnemySizeCache[Target];
 	}
+	SOUL_COUNTER_INC(TEXT("UIManager.SizeCacheMisses"));
 	
 	float BoundingBoxSize = CalculateTargetBoundingBoxSize(Target);
 	
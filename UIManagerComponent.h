@@ -17,6 +17,7 @@ class UUserWidget;
 class UWidgetComponent;
 class ACharacter;
 class APlayerController;
+class UTargetDetectionComponent;
 
 /** Target body part enumeration */
 UENUM(BlueprintType)
@@ -44,6 +45,10 @@ struct FMultiPartConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Multi-Part")
 	bool bEnableSmartSelection;
 	
+	/** Optional bone or socket name per part, resolved to a bone index once per target; parts without a name (the default) use the lock-on socket (Spine2Socket, then LockOnSocket) + PartOffsets */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Multi-Part")
+	TMap<ETargetBodyPart, FName> PartPointNames;
+	
 	FMultiPartConfig()
 	{
 		TargetPart = ETargetBodyPart::Auto;
@@ -111,6 +116,61 @@ enum class EUIDisplayMode : uint8
 	SizeAdaptive		UMETA(DisplayName = "Size Adaptive Mode")
 };
 
+/**
+ * Lock-on widget pool statistics
+ */
+USTRUCT(BlueprintType)
+struct FLockOnWidgetPoolStats
+{
+	GENERATED_BODY()
+
+	/** Widgets served from the pool */
+	UPROPERTY(BlueprintReadOnly, Category = "Widget Pool")
+	int32 Hits = 0;
+
+	/** Widgets that had to be created because the pool was empty */
+	UPROPERTY(BlueprintReadOnly, Category = "Widget Pool")
+	int32 Misses = 0;
+
+	/** Total widgets created, including pre-warmed ones */
+	UPROPERTY(BlueprintReadOnly, Category = "Widget Pool")
+	int32 Created = 0;
+
+	/** Idle widgets currently waiting in the pool */
+	UPROPERTY(BlueprintReadOnly, Category = "Widget Pool")
+	int32 Available = 0;
+
+	/** Hits / (Hits + Misses) */
+	UPROPERTY(BlueprintReadOnly, Category = "Widget Pool")
+	float HitRate = 0.0f;
+};
+
+/**
+ * One live candidate indicator marker
+ */
+USTRUCT()
+struct FCandidateIndicatorSlot
+{
+	GENERATED_BODY()
+
+	/** Marker widget, created once and recycled between candidates */
+	UPROPERTY()
+	UUserWidget* Widget = nullptr;
+
+	/** Candidate currently shown by this marker */
+	UPROPERTY()
+	TWeakObjectPtr<AActor> Target;
+
+	/** Last screen position pushed to the widget */
+	FVector2D LastScreenPosition = FVector2D::ZeroVector;
+
+	/** World time after which the widget may be updated again */
+	float NextWidgetUpdateTime = 0.0f;
+
+	/** Whether the marker is visible and bound to a target */
+	bool bActive = false;
+};
+
 /**
  * Event delegates for UI state changes
  */
@@ -142,6 +202,11 @@ protected:
 	 */
 	virtual void BeginPlay() override;
 
+	/**
+	 * Called when the game ends, releases pooled widgets
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 	/**
 	 * Called every frame
@@ -211,6 +276,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Socket Projection")
 	FVector2D ProjectToScreen(const FVector& WorldLocation) const;
 
+	/**
+	 * Project many world locations in one pass with the view-projection matrix cached for this frame
+	 * @param WorldLocations - World locations to project
+	 * @param OutScreenPositions - Screen coordinates, zero vector for points behind the camera
+	 * @param OutOnScreen - True when the point is in front of the camera and inside the view rect
+	 * @return Number of on-screen points
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Socket Projection")
+	int32 ProjectWorldLocationsToScreen(const TArray<FVector>& WorldLocations, TArray<FVector2D>& OutScreenPositions, TArray<bool>& OutOnScreen) const;
+
+	/**
+	 * Batched projection of each target's projection location (see GetTargetProjectionLocation)
+	 * @param Targets - Target actors, invalid entries are reported off-screen
+	 * @param OutScreenPositions - Screen coordinates per target
+	 * @param OutOnScreen - On-screen flag per target
+	 * @return Number of on-screen targets
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Socket Projection")
+	int32 ProjectTargetsToScreen(const TArray<AActor*>& Targets, TArray<FVector2D>& OutScreenPositions, TArray<bool>& OutOnScreen) const;
+
 	/**
 	 * Show socket projection widget for current target
 	 */
@@ -291,6 +376,41 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Debug")
 	bool ValidateWidgetClass() const;
 
+	// ==================== Widget Pool Interface ====================
+
+	/**
+	 * Create idle lock-on widgets up to WidgetPoolPrewarmCount so the first locks do not allocate
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Widget Pool")
+	void PrewarmWidgetPool();
+
+	/**
+	 * Get widget pool hit/miss statistics
+	 */
+	UFUNCTION(BlueprintPure, Category = "Widget Pool")
+	FLockOnWidgetPoolStats GetWidgetPoolStats() const;
+
+	/**
+	 * Reset widget pool hit/miss counters
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Widget Pool")
+	void ResetWidgetPoolStats();
+
+	// ==================== Candidate Indicator Interface ====================
+
+	/**
+	 * Enable or disable markers on every lock-on candidate
+	 * @param bEnabled - Whether candidate markers should be shown
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Candidate Indicators")
+	void SetCandidateIndicatorsEnabled(bool bEnabled);
+
+	/**
+	 * Get number of candidate markers currently visible
+	 */
+	UFUNCTION(BlueprintPure, Category = "Candidate Indicators")
+	int32 GetLiveCandidateIndicatorCount() const;
+
 	// ==================== Configuration Accessors ====================
 
 	/**
@@ -347,6 +467,37 @@ public:
 	UFUNCTION(BlueprintPure, Category = "UI Manager")
 	ETargetBodyPart GetBestTargetPart(AActor* Target) const;
 
+	/**
+	 * Step the target's current lock point through its resolved part list
+	 * @param Target - The target actor
+	 * @param Direction - +1 for next part, -1 for previous
+	 * @return New part index, or INDEX_NONE if the target has no resolved parts
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Multi-Part")
+	int32 StepTargetPart(AActor* Target, int32 Direction);
+
+	/**
+	 * Get number of resolved part points for a target
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Multi-Part")
+	int32 GetTargetPartCount(AActor* Target) const;
+
+	/**
+	 * Get world transform of the target's current part when multi-part lock is active for it
+	 * Shared by camera and UI; evaluated at most once per frame per target
+	 * @param Target - The target actor
+	 * @param OutTransform - World transform of the current part point
+	 * @return False when an explicit part is not selected (Auto) and the target defines no custom part list
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Multi-Part")
+	bool GetActiveTargetPartTransform(AActor* Target, FTransform& OutTransform) const;
+
+	/**
+	 * Drop resolved part points for a target (call after swapping its mesh)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Multi-Part")
+	void InvalidateTargetParts(AActor* Target);
+
 	// ==================== Event Delegates ====================
 
 	/** Event fired when lock-on widget is shown */
@@ -383,6 +534,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI Configuration")
 	FMultiPartConfig MultiPartConfig;
 
+	/** Skip widget position updates when the projected position moved less than this many pixels */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI Configuration", meta = (ClampMin = "0.0", ClampMax = "10.0"))
+	float WidgetPositionUpdateThreshold = 0.5f;
+
 	// ==================== Size Adaptive Configuration ====================
 
 	/** UI scale factors for different enemy sizes */
@@ -409,6 +564,46 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Size Adaptive UI")
 	bool bEnableSizeAdaptiveUI = true;
 
+	// ==================== Candidate Indicator Configuration ====================
+
+	/** Show markers on every lock-on candidate, not just the locked target */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Candidate Indicators")
+	bool bShowCandidateIndicators = false;
+
+	/** Marker widget class (falls back to LockOnWidgetClass) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Candidate Indicators")
+	TSubclassOf<UUserWidget> CandidateIndicatorClass;
+
+	/** Maximum markers visible at once; nearest candidates win */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Candidate Indicators", meta = (ClampMin = "1", ClampMax = "16"))
+	int32 MaxLiveCandidateIndicators = 6;
+
+	/** Candidates farther than this are refreshed at CandidateFarUpdateInterval */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Candidate Indicators", meta = (ClampMin = "0.0"))
+	float CandidateNearDistance = 1200.0f;
+
+	/** Refresh interval for far and off-screen candidates (seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Candidate Indicators", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float CandidateFarUpdateInterval = 0.1f;
+
+	/** Markers closer than this on screen (pixels) are merged into the nearer candidate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Candidate Indicators", meta = (ClampMin = "0.0"))
+	float CandidateMergeRadius = 32.0f;
+
+	// ==================== Widget Pool Configuration ====================
+
+	/** Recycle lock-on widgets with visibility toggles instead of creating and destroying them */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widget Pool")
+	bool bEnableWidgetPool = true;
+
+	/** Idle widgets created one frame after BeginPlay */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widget Pool", meta = (ClampMin = "0", ClampMax = "8"))
+	int32 WidgetPoolPrewarmCount = 2;
+
+	/** Maximum idle widgets kept in the pool; extra widgets are removed from viewport */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widget Pool", meta = (ClampMin = "0", ClampMax = "16"))
+	int32 MaxPooledWidgets = 4;
+
 	/** Enable debug logging for UI operations */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	bool bEnableUIDebugLogs;
@@ -429,6 +624,114 @@ protected:
 	UPROPERTY()
 	UUserWidget* LockOnWidgetInstance;
 
+	/** Widget class the Blueprint functions below were resolved from (unused for ULockOnWidgetBase) */
+	UPROPERTY()
+	UClass* CachedWidgetFunctionClass = nullptr;
+
+	/** Legacy Blueprint functions, resolved once per widget class instead of every tick */
+	UPROPERTY()
+	UFunction* CachedUpdatePositionFunction = nullptr;
+
+	UPROPERTY()
+	UFunction* CachedSetScaleFunction = nullptr;
+
+	UPROPERTY()
+	UFunction* CachedSetColorFunction = nullptr;
+
+	/** Last screen position pushed to the widget */
+	FVector2D LastWidgetScreenPosition = FVector2D::ZeroVector;
+
+	/** Whether LastWidgetScreenPosition holds a position for the current widget */
+	bool bHasLastWidgetScreenPosition = false;
+
+	/**
+	 * View-projection data shared by every projection in a frame
+	 * The matrix is built in camera-relative (translated) space so it stays precise as float
+	 */
+	struct FProjectionCache
+	{
+		FMatrix44f TranslatedViewProjection = FMatrix44f::Identity;
+		FVector ViewOrigin = FVector::ZeroVector;
+		FIntRect ViewRect;
+		uint64 FrameNumber = MAX_uint64;
+		TWeakObjectPtr<APlayerController> Controller;
+		bool bValid = false;
+	};
+
+	mutable FProjectionCache ProjectionCache;
+
+	/** Scratch locations for ProjectTargetsToScreen */
+	mutable TArray<FVector> ProjectionScratchLocations;
+
+	// ==================== Multi-Part State ====================
+
+	/** One lock point resolved against a target's skeleton */
+	struct FResolvedPartPoint
+	{
+		int32 BoneIndex = INDEX_NONE;
+		FTransform SocketLocalTransform = FTransform::Identity;
+		FVector WorldOffset = FVector::ZeroVector;
+		ETargetBodyPart Part = ETargetBodyPart::Auto;
+	};
+
+	/** Compact per-target part table; switching parts only moves CurrentIndex */
+	struct FResolvedTargetParts
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+		int32 NumBones = 0;
+		TArray<FResolvedPartPoint, TInlineAllocator<4>> Points;
+		int32 CurrentIndex = 0;
+		bool bCustomPoints = false;
+		uint64 EvaluatedFrame = MAX_uint64;
+		int32 EvaluatedIndex = INDEX_NONE;
+		FTransform EvaluatedTransform = FTransform::Identity;
+	};
+
+	mutable TMap<TWeakObjectPtr<AActor>, FResolvedTargetParts> ResolvedTargetParts;
+
+	// ==================== Candidate Indicator State ====================
+
+	/** Cached target detection component providing lock-on candidates */
+	UPROPERTY()
+	UTargetDetectionComponent* TargetDetectionComponent = nullptr;
+
+	/** Marker slots, at most MaxLiveCandidateIndicators */
+	UPROPERTY()
+	TArray<FCandidateIndicatorSlot> CandidateIndicators;
+
+	/** Per-candidate projection point, refreshed at a reduced rate when far or off-screen */
+	struct FCandidateProjectionState
+	{
+		FVector WorldLocation = FVector::ZeroVector;
+		float NextRefreshTime = 0.0f;
+		uint64 LastSeenFrame = 0;
+		float DistanceSquared = 0.0f;
+		bool bOnScreen = false;
+	};
+
+	TMap<TWeakObjectPtr<AActor>, FCandidateProjectionState> CandidateProjectionStates;
+
+	/** Scratch buffers for the per-frame candidate pass */
+	TArray<AActor*> CandidateScratchTargets;
+	TArray<FVector> CandidateScratchLocations;
+	TArray<float> CandidateScratchDistances;
+	TArray<FVector2D> CandidateScratchScreen;
+	TArray<bool> CandidateScratchOnScreen;
+	TArray<int32> CandidateScratchOrder;
+	TArray<int32> CandidateScratchAccepted;
+
+	/** Whether size-adaptive scale/color was pushed to the current widget (reset before pooling) */
+	bool bLockOnWidgetAppearanceApplied = false;
+
+	/** Idle lock-on widgets, kept in viewport but collapsed */
+	UPROPERTY()
+	TArray<UUserWidget*> PooledLockOnWidgets;
+
+	/** Widget pool statistics */
+	int32 WidgetPoolHits = 0;
+	int32 WidgetPoolMisses = 0;
+	int32 WidgetPoolCreated = 0;
+
 	/** Previous target for state cleanup */
 	UPROPERTY()
 	AActor* PreviousLockOnTarget;
@@ -492,6 +795,64 @@ protected:
 	 */
 	void ClearWidgetComponentCache();
 
+	/**
+	 * Rebuild the cached view-projection matrix once per frame
+	 * @return True if the cache holds a usable projection for this frame
+	 */
+	bool UpdateProjectionCache() const;
+
+	/**
+	 * Project Num points with the cached matrix (SIMD, one point per vector register)
+	 * @return Number of on-screen points
+	 */
+	int32 ProjectBatchWithCache(const FVector* WorldLocations, int32 Num, FVector2D* OutScreenPositions, bool* OutOnScreen) const;
+
+	/**
+	 * Get the target's part table, resolving names to bone indices on first use or after a mesh change
+	 */
+	FResolvedTargetParts* FindOrResolveTargetParts(AActor* Target) const;
+
+	/**
+	 * Project all lock-on candidates in one batch, then cap, merge and update candidate markers
+	 */
+	void UpdateCandidateIndicators();
+
+	/**
+	 * Hide every candidate marker
+	 * @param bRemoveFromViewport - Also remove marker widgets from viewport (EndPlay)
+	 */
+	void HideCandidateIndicators(bool bRemoveFromViewport = false);
+
+	/**
+	 * Bind a newly created lock-on widget: cache its Blueprint functions unless it derives from ULockOnWidgetBase
+	 */
+	void BindLockOnWidget(UUserWidget* Widget);
+
+	/**
+	 * Push screen position to the lock-on widget
+	 */
+	void ApplyWidgetScreenPosition(const FVector2D& ScreenPosition);
+
+	/**
+	 * Push size-adaptive scale and color to the lock-on widget
+	 */
+	void ApplyWidgetAppearance(float Scale, const FLinearColor& Color);
+
+	/**
+	 * Take an idle widget of LockOnWidgetClass from the pool, or create one on a miss
+	 */
+	UUserWidget* AcquireLockOnWidget(APlayerController* PC);
+
+	/**
+	 * Return the current lock-on widget to the pool (or remove it when pooling is off / pool is full)
+	 */
+	void ReleaseLockOnWidget();
+
+	/**
+	 * Remove all pooled widgets from viewport
+	 */
+	void DrainWidgetPool();
+
 	/**
 	 * Update owner references (Character and Controller)
 	 */